@@ -0,0 +1,181 @@
+#include "BootProfiler.h"
+#include "Logger.h"
+#include "config.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+
+#define TRACE(...) LOG_DEBUG(LOG_PREFS, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_PREFS, __VA_ARGS__)
+
+static const char *boot_namespace = "HC5Boot";
+static const char *boot_history_key = "History";
+
+static const char *const boot_phase_names[BOOT_PHASE_COUNT] = {
+    "prefs",      "motor", "clock", "web_server", "time_valid",
+    "hands",      "wifi",  "mdns",  "ringtone",   "ntp"};
+
+static const char *const reset_reason_names[] = {
+    "unknown",  "poweron",  "ext",      "sw",        "panic", "int_wdt",
+    "task_wdt", "wdt",      "deepsleep", "brownout", "sdio"};
+
+BootProfiler &BootProfiler::getInstance() {
+  static BootProfiler instance;
+  return instance;
+}
+
+BootProfiler::BootProfiler() : stored(false) {
+  memset(&current, 0, sizeof(current));
+  current.reset_reason = esp_reset_reason();
+
+  preferences.begin(boot_namespace, false);
+  // A different size means the phases changed, the old profiles are dropped
+  if (preferences.getBytes(boot_history_key, &history, sizeof(history)) !=
+          sizeof(history) ||
+      history.count > BOOT_PROFILES_MAX || history.next >= BOOT_PROFILES_MAX) {
+    memset(&history, 0, sizeof(history));
+  }
+}
+
+void BootProfiler::mark(boot_phase_t phase) {
+  uint32_t now = esp_timer_get_time();
+  std::lock_guard<std::mutex> lock(profileMutex);
+  if (!stored && current.phases[phase] == 0) {
+    current.phases[phase] = now;
+    TRACE("Boot %s: %lu us\n", boot_phase_names[phase], (unsigned long)now);
+  }
+}
+
+bool BootProfiler::isComplete(void) {
+  for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+    if (current.phases[i] == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BootProfiler::process(void) {
+  std::lock_guard<std::mutex> lock(profileMutex);
+  if (!stored && (isComplete() || millis() >= BOOT_PROFILE_TIMEOUT)) {
+    store();
+    stored = true;
+  }
+}
+
+// Called with profileMutex held, one flash write per boot
+void BootProfiler::store(void) {
+  history.profiles[history.next] = current;
+  history.next = (history.next + 1) % BOOT_PROFILES_MAX;
+  if (history.count < BOOT_PROFILES_MAX) {
+    history.count++;
+  }
+  if (preferences.putBytes(boot_history_key, &history, sizeof(history)) !=
+      sizeof(history)) {
+    ERROR("Storing boot profile failed\n");
+  }
+}
+
+// Soft resets keep the time in RTC memory, see HollowClock::restoreTime()
+bool BootProfiler::isWarm(const boot_profile_t &profile) {
+  return profile.reset_reason != ESP_RST_POWERON &&
+         profile.reset_reason != ESP_RST_BROWNOUT;
+}
+
+void BootProfiler::writeProfile(JsonWriter &json, const char *key,
+                                const boot_profile_t &profile) {
+  const size_t reasons =
+      sizeof(reset_reason_names) / sizeof(reset_reason_names[0]);
+
+  json.beginObject(key);
+  json.add("reset", profile.reset_reason < reasons
+                        ? reset_reason_names[profile.reset_reason]
+                        : "other");
+  json.add("warm", isWarm(profile));
+  json.beginArray("us");
+  for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+    if (profile.phases[i] != 0) {
+      json.add((long long)profile.phases[i]);
+    } else {
+      json.addNull(nullptr);
+    }
+  }
+  json.endArray();
+  json.endObject();
+}
+
+// Null for the phases no boot reached
+static void writeValues(JsonWriter &json, const char *key,
+                        const uint32_t *values, const uint8_t *reached) {
+  json.beginArray(key);
+  for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+    if (reached[i] == 0) {
+      json.addNull(nullptr);
+    } else {
+      json.add((long long)values[i]);
+    }
+  }
+  json.endArray();
+}
+
+// Phases a boot did not reach are left out of the statistics
+void BootProfiler::writeSummary(JsonWriter &json, const char *key,
+                                bool warm) {
+  uint32_t min_us[BOOT_PHASE_COUNT], max_us[BOOT_PHASE_COUNT];
+  uint32_t avg_us[BOOT_PHASE_COUNT];
+  uint64_t sum_us[BOOT_PHASE_COUNT] = {};
+  uint8_t reached[BOOT_PHASE_COUNT] = {};
+  int count = 0;
+
+  for (int n = 0; n < history.count; n++) {
+    const boot_profile_t &profile = history.profiles[n];
+    if (isWarm(profile) != warm) {
+      continue;
+    }
+    count++;
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+      uint32_t us = profile.phases[i];
+      if (us == 0) {
+        continue;
+      }
+      min_us[i] = (reached[i] == 0 || us < min_us[i]) ? us : min_us[i];
+      max_us[i] = (reached[i] == 0 || us > max_us[i]) ? us : max_us[i];
+      sum_us[i] += us;
+      reached[i]++;
+    }
+  }
+
+  for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+    avg_us[i] = reached[i] ? sum_us[i] / reached[i] : 0;
+  }
+
+  json.beginObject(key);
+  json.add("count", count);
+  writeValues(json, "min_us", min_us, reached);
+  writeValues(json, "avg_us", avg_us, reached);
+  writeValues(json, "max_us", max_us, reached);
+  json.endObject();
+}
+
+void BootProfiler::writeJson(JsonWriter &json) {
+  std::lock_guard<std::mutex> lock(profileMutex);
+
+  json.beginArray("phases");
+  for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+    json.add(boot_phase_names[i]);
+  }
+  json.endArray();
+
+  writeProfile(json, "current", current);
+
+  // Oldest first
+  json.beginArray("history");
+  for (int n = 0; n < history.count; n++) {
+    int index = (history.next + BOOT_PROFILES_MAX - history.count + n) %
+                BOOT_PROFILES_MAX;
+    writeProfile(json, nullptr, history.profiles[index]);
+  }
+  json.endArray();
+
+  writeSummary(json, "cold", false);
+  writeSummary(json, "warm", true);
+}
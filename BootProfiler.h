@@ -0,0 +1,71 @@
+#ifndef _BOOT_PROFILER_H_
+#define _BOOT_PROFILER_H_
+
+#include "JsonWriter.h"
+#include <Arduino.h>
+#include <Preferences.h>
+#include <mutex>
+
+#define BOOT_PROFILES_MAX 8
+#define BOOT_PROFILE_TIMEOUT 300000 // ms, phases not reached by then stay 0
+
+typedef enum {
+  BOOT_PHASE_PREFS = 0,   // settings loaded
+  BOOT_PHASE_MOTOR,       // motor ports initialized
+  BOOT_PHASE_CLOCK,       // clock thread started
+  BOOT_PHASE_WEB_SERVER,  // web server listening
+  BOOT_PHASE_TIME_VALID,  // clock thread got a valid time
+  BOOT_PHASE_HANDS,       // hands show the current time
+  BOOT_PHASE_WIFI,        // first IP address
+  BOOT_PHASE_MDNS,        // mDNS responder started
+  BOOT_PHASE_RINGTONE,    // connect ringtone finished
+  BOOT_PHASE_NTP,         // first NTP update
+  BOOT_PHASE_COUNT
+} boot_phase_t;
+
+typedef struct {
+  uint8_t reset_reason;              // esp_reset_reason_t
+  uint32_t phases[BOOT_PHASE_COUNT]; // us since boot, 0 if not reached
+} boot_profile_t;
+
+// Ring of the last profiles, kept in NVS so cold boots are covered too
+typedef struct {
+  uint8_t next;
+  uint8_t count;
+  boot_profile_t profiles[BOOT_PROFILES_MAX];
+} boot_history_t;
+
+// Timestamps the boot phases and keeps the profiles of the last boots
+class BootProfiler {
+
+public:
+  static BootProfiler &getInstance();
+  BootProfiler(const BootProfiler &) = delete;
+  BootProfiler &operator=(const BootProfiler &) = delete;
+
+  // Records the time of a phase, only the first call counts
+  void mark(boot_phase_t phase);
+  // Stores the profile once all phases are reached or it timed out
+  void process(void);
+  // Current boot, the stored ones and min/avg/max of cold and warm boots
+  void writeJson(JsonWriter &json);
+
+private:
+  BootProfiler();
+  ~BootProfiler() = default;
+
+  bool isComplete(void);
+  void store(void);
+  static bool isWarm(const boot_profile_t &profile);
+  static void writeProfile(JsonWriter &json, const char *key,
+                           const boot_profile_t &profile);
+  void writeSummary(JsonWriter &json, const char *key, bool warm);
+
+  Preferences preferences;
+  std::mutex profileMutex;
+  boot_profile_t current;
+  boot_history_t history;
+  bool stored;
+};
+
+#endif
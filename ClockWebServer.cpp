@@ -1,24 +1,25 @@
 #include "ClockWebServer.h"
+#include "BootProfiler.h"
+#include "FirmwareUpdate.h"
 #include "HollowClock.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "Logger.h"
+#include "MotorControl.h"
+#include "NetworkManager.h"
 #include "PreferencesManager.h"
+#include "SntpClient.h"
 #include "SoundPlayer.h"
+#include "SystemMonitor.h"
+#include "WifiScanner.h"
 #include "Zones.h"
 #include "config.h"
 #include <Arduino.h>
 
 #include <WiFi.h>
-#include <algorithm>
-#include <set>
-#include <utility>
-#include <vector>
-
-#if DEBUG_CLOCK_WEB_SERVER
-#define TRACE(...) Serial.printf(__VA_ARGS__)
-#define ERROR(...) Serial.printf(__VA_ARGS__)
-#else
-#define TRACE(...)
-#define ERROR(...)
-#endif
+
+#define TRACE(...) LOG_DEBUG(LOG_WEB, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_WEB, __VA_ARGS__)
 
 static const String credits = R"(
     <div class="row"></div>
@@ -40,56 +41,185 @@ ClockWebServer &ClockWebServer::getInstance() {
 
 void ClockWebServer::start() {
   if (webServer == nullptr) {
+    static const char *headerKeys[] = {"If-None-Match", "Accept-Encoding"};
     webServer = new WebServer(WEBSERVER_PORT);
+    webServer->collectHeaders(headerKeys,
+                              sizeof(headerKeys) / sizeof(headerKeys[0]));
     setServerRouting();
     webServer->begin();
   }
 }
 
 void ClockWebServer::handleClient() {
+  // Called once per loop(), the time between calls is the loop time
+  unsigned long now = micros();
+  if (loopLast != 0) {
+    uint32_t elapsed = now - loopLast;
+    uint32_t outside = now - handleClientEnd;
+    loopTime = elapsed;
+    if (elapsed > loopTimeMax) {
+      loopTimeMax = elapsed;
+    }
+    loopOutsideTime = outside;
+    if (outside > loopOutsideMax) {
+      loopOutsideMax = outside;
+    }
+  }
+  loopLast = now;
+
   if (webServer != nullptr) {
     webServer->handleClient();
+    pushEvents();
+  }
+  handleClientEnd = micros();
+}
+
+void ClockWebServer::countRequest(HTTPMethod method) {
+  switch (method) {
+  case HTTP_GET:
+    httpRequests[HTTP_COUNTER_GET]++;
+    break;
+  case HTTP_POST:
+    httpRequests[HTTP_COUNTER_POST]++;
+    break;
+  default:
+    httpRequests[HTTP_COUNTER_OTHER]++;
+    break;
+  }
+}
+
+static const char *methodName(HTTPMethod method) {
+  switch (method) {
+  case HTTP_GET:
+    return "GET";
+  case HTTP_POST:
+    return "POST";
+  case HTTP_PUT:
+    return "PUT";
+  case HTTP_PATCH:
+    return "PATCH";
+  case HTTP_DELETE:
+    return "DELETE";
+  default:
+    return "ANY";
+  }
+}
+
+uint8_t ClockWebServer::addRoute(const String &uri, HTTPMethod method) {
+  if (routesCount >= ROUTES_MAX) {
+    ERROR("Too many routes, %s is not timed\n", uri.c_str());
+    return ROUTE_INVALID;
+  }
+  route_stats_t &route = routeStats[routesCount];
+  route.uri = uri;
+  route.method = method;
+  route.count = 0;
+  route.total_us = 0;
+  route.max_us = 0;
+  memset(route.histogram, 0, sizeof(route.histogram));
+  return routesCount++;
+}
+
+// Runs a handler and records how long it took
+void ClockWebServer::runRoute(uint8_t index, route_handler_t handler) {
+  uint32_t heap = ESP.getFreeHeap();
+  unsigned long start = micros();
+
+  countRequest(webServer->method());
+  (this->*handler)();
+
+  uint32_t duration = micros() - start;
+  if (index == ROUTE_INVALID) {
+    return;
+  }
+  route_stats_t &route = routeStats[index];
+  uint32_t ms = duration / 1000;
+  // Bucket 0 is below 1 ms, bucket n below 2^n ms, the last one the rest
+  int bucket = (ms == 0) ? 0 : 32 - __builtin_clz(ms);
+  if (bucket >= ROUTE_HISTOGRAM_BUCKETS) {
+    bucket = ROUTE_HISTOGRAM_BUCKETS - 1;
+  }
+  route.histogram[bucket]++;
+  route.count++;
+  route.total_us += duration;
+  if (duration > route.max_us) {
+    route.max_us = duration;
+  }
+
+  if (duration >= SLOW_REQUEST_THRESHOLD) {
+    slow_request_t &slow = slowRequests[slowNext];
+    slow.route = index;
+    slow.duration_us = duration;
+    slow.heap_delta = (int32_t)(ESP.getFreeHeap() - heap);
+    slow.time = millis();
+    slowNext = (slowNext + 1) % SLOW_REQUESTS_MAX;
+    if (slowCount < SLOW_REQUESTS_MAX) {
+      slowCount++;
+    }
   }
 }
 
+// Registers a handler with request counting and timing
+void ClockWebServer::on(const String &uri, HTTPMethod method,
+                        route_handler_t handler) {
+  uint8_t index = addRoute(uri, method);
+  webServer->on(uri, method,
+                [this, index, handler]() { runRoute(index, handler); });
+}
+
+// Same with a handler for the uploaded data, called for each chunk
+void ClockWebServer::on(const String &uri, HTTPMethod method,
+                        route_handler_t handler, route_handler_t upload) {
+  uint8_t index = addRoute(uri, method);
+  webServer->on(
+      uri, method, [this, index, handler]() { runRoute(index, handler); },
+      [this, upload]() { (this->*upload)(); });
+}
+
 void ClockWebServer::setServerRouting() {
-  webServer->on(F("/"), HTTP_GET, std::bind(&ClockWebServer::handleRoot, this));
-  webServer->on(F("/time.html"), HTTP_GET,
-                std::bind(&ClockWebServer::handleTime, this));
-  webServer->on(F("/wifi.html"), HTTP_GET,
-                std::bind(&ClockWebServer::handleWifi, this));
-  webServer->on(F("/advanced.html"), HTTP_GET,
-                std::bind(&ClockWebServer::handleAdvanced, this));
-  webServer->on(F("/position.html"), HTTP_GET,
-                std::bind(&ClockWebServer::handlePosition, this));
-  webServer->on(F("/error.html"), HTTP_GET,
-                std::bind(&ClockWebServer::handleError, this));
-  webServer->on(F("/styles.css"), HTTP_GET,
-                std::bind(&ClockWebServer::handleStyles, this));
+  on(F("/"), HTTP_GET, &ClockWebServer::handleRoot);
+  on(F("/time.html"), HTTP_GET, &ClockWebServer::handleTime);
+  on(F("/wifi.html"), HTTP_GET, &ClockWebServer::handleWifi);
+  on(F("/advanced.html"), HTTP_GET, &ClockWebServer::handleAdvanced);
+  on(F("/position.html"), HTTP_GET, &ClockWebServer::handlePosition);
+  on(F("/error.html"), HTTP_GET, &ClockWebServer::handleError);
+  on(F("/styles.css"), HTTP_GET, &ClockWebServer::handleStyles);
   /* API calls*/
-  webServer->on(F("/zones"), HTTP_GET, zones_ListJson);
-  webServer->on(F("/wifi"), HTTP_GET,
-                std::bind(&ClockWebServer::handleWifiGet, this));
-  webServer->on(F("/wifi"), HTTP_POST,
-                std::bind(&ClockWebServer::handleWifiPost, this));
-  webServer->on(F("/ssidlist"), HTTP_GET,
-                std::bind(&ClockWebServer::handleSsidListGet, this));
-  webServer->on(F("/time"), HTTP_GET,
-                std::bind(&ClockWebServer::handleTimeGet, this));
-  webServer->on(F("/time"), HTTP_POST,
-                std::bind(&ClockWebServer::handleTimePost, this));
-  webServer->on(F("/advanced"), HTTP_GET,
-                std::bind(&ClockWebServer::handleAdvancedGet, this));
-  webServer->on(F("/advanced"), HTTP_POST,
-                std::bind(&ClockWebServer::handleAdvancedPost, this));
-  webServer->on(F("/calibration"), HTTP_POST,
-                std::bind(&ClockWebServer::handleCalibrationPost, this));
-  webServer->on(F("/position"), HTTP_GET,
-                std::bind(&ClockWebServer::handlePositionGet, this));
-  webServer->on(F("/apply"), HTTP_POST,
-                std::bind(&ClockWebServer::handleApplyPost, this));
-  webServer->on(F("/reset"), HTTP_POST,
-                std::bind(&ClockWebServer::handleResetPost, this));
+  on(F("/zones"), HTTP_GET, &ClockWebServer::handleZonesGet);
+  on(F("/wifi"), HTTP_GET, &ClockWebServer::handleWifiGet);
+  on(F("/wifi"), HTTP_POST, &ClockWebServer::handleWifiPost);
+  on(F("/ssidlist"), HTTP_GET, &ClockWebServer::handleSsidListGet);
+  on(F("/time"), HTTP_GET, &ClockWebServer::handleTimeGet);
+  on(F("/time"), HTTP_POST, &ClockWebServer::handleTimePost);
+  on(F("/advanced"), HTTP_GET, &ClockWebServer::handleAdvancedGet);
+  on(F("/advanced"), HTTP_POST, &ClockWebServer::handleAdvancedPost);
+  on(F("/calibration"), HTTP_POST, &ClockWebServer::handleCalibrationPost);
+  on(F("/position"), HTTP_GET, &ClockWebServer::handlePositionGet);
+  on(F("/events"), HTTP_GET, &ClockWebServer::handleEventsGet);
+  on(F("/apply"), HTTP_POST, &ClockWebServer::handleApplyPost);
+  on(F("/reset"), HTTP_POST, &ClockWebServer::handleResetPost);
+  on(F("/api/config"), HTTP_GET, &ClockWebServer::handleConfigGet);
+  on(F("/api/config"), HTTP_PUT, &ClockWebServer::handleConfigPut);
+  on(F("/api/config"), HTTP_PATCH, &ClockWebServer::handleConfigPatch);
+  on(F("/metrics"), HTTP_GET, &ClockWebServer::handleMetricsGet);
+  on(F("/update"), HTTP_POST, &ClockWebServer::handleUpdatePost,
+     &ClockWebServer::handleUpdateUpload);
+  on(F("/api/diagnostics"), HTTP_GET, &ClockWebServer::handleDiagnosticsGet);
+  on(F("/api/boot"), HTTP_GET, &ClockWebServer::handleBootGet);
+  on(F("/api/log"), HTTP_GET, &ClockWebServer::handleLogGet);
+  on(F("/api/log"), HTTP_POST, &ClockWebServer::handleLogPost);
+  // Connectivity checks of Android, Apple, Windows and Firefox
+  static const char *const captive_probes[] = {
+      "/generate_204",   "/gen_204",          "/hotspot-detect.html",
+      "/ncsi.txt",       "/connecttest.txt",  "/redirect",
+      "/canonical.html", "/success.txt",      "/library/test/success.html"};
+  for (const char *probe : captive_probes) {
+    on(probe, HTTP_GET, &ClockWebServer::handleCaptiveProbe);
+  }
+  uint8_t index = addRoute(F("*"), HTTP_ANY);
+  webServer->onNotFound([this, index]() {
+    runRoute(index, &ClockWebServer::handleNotFound);
+  });
 }
 
 void ClockWebServer::handleRoot() {
@@ -329,25 +459,13 @@ void ClockWebServer::handleWifi() {
             scanButton.textContent = 'Scanning' + '.'.repeat(dots);
         }, 500);
         
-        fetch('/ssidlist')
+        fetch('/ssidlist?refresh=1')
             .then(response => response.json())
             .then(data => {
                 clearInterval(scanInterval);
                 scanButton.textContent = 'Scan';
                 scanButton.disabled = false;
-
-                var wifiList = document.getElementById('wifiList');
-                wifiList.innerHTML = '';
-                data.wifilist.forEach((network, index) => {
-                    var option = document.createElement('option');
-                    option.value = network.ssid;
-                    option.textContent = `${network.ssid} (${network.signal_strength} dBm)`;
-                    wifiList.appendChild(option);
-                });
-                if (data.wifilist.length > 0) {
-                    wifiList.prepend(new Option('Select WiFi', '', true, true));
-                    wifiList.options[0].disabled = true;
-                }
+                showWifiList(data);
             })
             .catch(error => {
                 clearInterval(scanInterval);
@@ -357,6 +475,22 @@ void ClockWebServer::handleWifi() {
             });
     }
 
+    function showWifiList(data) {
+        var wifiList = document.getElementById('wifiList');
+        if (data.wifilist.length == 0) {
+            return;
+        }
+        wifiList.innerHTML = '';
+        data.wifilist.forEach((network, index) => {
+            var option = document.createElement('option');
+            option.value = network.ssid;
+            option.textContent = `${network.ssid} (${network.signal_strength} dBm)`;
+            wifiList.appendChild(option);
+        });
+        wifiList.prepend(new Option('Select WiFi', '', true, true));
+        wifiList.options[0].disabled = true;
+    }
+
     function updateSSID() {
         var wifiList = document.getElementById('wifiList');
         var ssidInput = document.getElementById('ssid');
@@ -372,6 +506,11 @@ void ClockWebServer::handleWifi() {
                 document.getElementById('password').value = data.password || '';
             })
             .catch(error => console.error('Error fetching WiFi settings:', error));
+        // Cached results, starts a background scan when they are stale
+        fetch('/ssidlist')
+            .then(response => response.json())
+            .then(showWifiList)
+            .catch(error => console.error('Error fetching WiFi list:', error));
     });
 </script>
 <html lang="en">
@@ -518,10 +657,10 @@ void ClockWebServer::handleTime() {
 
             <div class="table-row" id="timezone_manual">
                 <div class="table-cell aright">
-                    <label for="tz_manual">Time offset in minutes</label>
+                    <label for="tz_manual">Time offset in minutes west of UTC</label>
                 </div>
                 <div class="table-cell aleft">
-                    <input class="input" type="text" id="tz_manual" name="tz_manual" value="">
+                    <input class="input" type="number" id="tz_manual" name="tz_manual" value="" min="-840" max="720" step="1">
                 </div>
             </div>
 
@@ -552,7 +691,7 @@ void ClockWebServer::handleTime() {
                     <label for="ntp_server">NTP Timeout</label>
                 </div>
                 <div class="table-cell aleft">
-                    <input class="input" type="number" id="ntp_timeout" name="ntp_timeout" value="3600" min="15" step="1">
+                    <input class="input" type="number" id="ntp_timeout" name="ntp_timeout" value="3600" min="15" max="129600" step="1">
                 </div>
             </div>
         </div>
@@ -585,6 +724,7 @@ void ClockWebServer::handleAdvanced() {
                 document.getElementById('flip_rotation').checked = data.flip_rotation || false;
                 document.getElementById('allow_backward').checked = data.allow_backward || false;
                 document.getElementById('chime').checked = data.chime || false;
+                document.getElementById('jump_policy').value = data.jump_policy ?? 2;
                 document.getElementById('steps_per_minute').value = data.steps_per_minute || 256;
                 document.getElementById('delay_time').value = data.delay_time || 2;
             })
@@ -652,6 +792,19 @@ void ClockWebServer::handleAdvanced() {
                     <input class="checkbox" type="checkbox" id="chime" name="chime" value="on">
                 </div>
             </div>
+            <div class="table-row">
+                <div class="table-cell aright tooltip">
+                    <span class="tooltiptext">What the hands do when the time jumps by more than a few minutes. Wait keeps them still while the time catches up with hands that are a little ahead</span>
+                    <label for="jump_policy">Time jumps</label>
+                </div>
+                <div class="table-cell aleft">
+                    <select class="select" id="jump_policy" name="jump_policy">
+                        <option value="0">Move at once</option>
+                        <option value="1">Move or wait</option>
+                        <option value="2">Confirm, then move or wait</option>
+                    </select>
+                </div>
+            </div>
             <div class="table-row">
                 <div class="table-cell aright tooltip">
                     <span class="tooltiptext">Adjust value if the clock is too fast or too slow. Default 256</span>
@@ -676,6 +829,31 @@ void ClockWebServer::handleAdvanced() {
             <button class="button" type="submit" value="Save">Save</button>
         </div>
     </form>
+    <form action="/update" method="post" enctype="multipart/form-data" onsubmit='return confirm("The clock will restart with the new firmware. Continue?")'>
+        <div class="table-container">
+            <div class="table-row">
+                <div class="table-cell aright tooltip">
+                    <span class="tooltiptext">SHA-256 of the image in hex, printed by make_build.sh</span>
+                    <label for="sha256">SHA-256</label>
+                </div>
+                <div class="table-cell aleft">
+                    <input class="input" type="text" id="sha256" name="sha256" pattern="[0-9a-fA-F]{64}" required>
+                </div>
+            </div>
+            <div class="table-row">
+                <div class="table-cell aright tooltip">
+                    <span class="tooltiptext">Firmware image (.bin) built by make_build.sh</span>
+                    <label for="firmware">Firmware</label>
+                </div>
+                <div class="table-cell aleft">
+                    <input class="input" type="file" id="firmware" name="firmware" accept=".bin">
+                </div>
+            </div>
+        </div>
+        <div class="row">
+            <button class="button" type="submit" value="Update">Update</button>
+        </div>
+    </form>
     <div class="row">
         <div class="cell">
             <button class="button" type="submit" onclick='location.href="/"'>Back</button>
@@ -692,18 +870,36 @@ void ClockWebServer::handlePosition() {
 <!DOCTYPE html>
 <script>
     document.addEventListener("DOMContentLoaded", function() {
+        function showPositionData(data) {
+            document.getElementById('local_time_value').textContent = data.local_time;
+            document.getElementById('hands_position_value').textContent =
+                data.hands_position + (data.positioning ? ' (positioning)' : '');
+        }
+
         function fetchPositionData() {
             fetch('/position')
                 .then(response => response.json())
-                .then(data => {
-                    document.getElementById('local_time_value').textContent = data.local_time;
-                    document.getElementById('hands_position_value').textContent = data.hands_position;
-                })
+                .then(showPositionData)
                 .catch(error => console.error('Error fetching position data:', error));
         }
 
-        fetchPositionData();
-        setInterval(fetchPositionData, 2000);
+        function pollPositionData() {
+            fetchPositionData();
+            setInterval(fetchPositionData, 2000);
+        }
+
+        // The clock pushes its state on change, polling is only a fallback
+        if (window.EventSource) {
+            const events = new EventSource('/events');
+            events.onmessage = (event) => showPositionData(JSON.parse(event.data));
+            events.onerror = () => {
+                if (events.readyState === EventSource.CLOSED) {
+                    pollPositionData();
+                }
+            };
+        } else {
+            pollPositionData();
+        }
     });
 </script>
 
@@ -792,6 +988,23 @@ void ClockWebServer::sendError(const String &message) {
   webServer->send(302, "text/plain", "");
 }
 
+// The whole argument has to be a number in [min, max], String::toInt()
+// would make 0 of garbage and wrap large values
+bool ClockWebServer::getNumberArg(const char *name, int32_t min, int32_t max,
+                                  int32_t &value) {
+  return parseNumber(webServer->arg(name), min, max, value);
+}
+
+bool ClockWebServer::parseNumber(const String &text, int32_t min, int32_t max,
+                                 int32_t &value) {
+  // strtoll() also takes an empty string and leading spaces
+  if (text.isEmpty() || isspace((unsigned char)text[0]) ||
+      !JsonReader::toInt(JSON_NUMBER, text, value)) {
+    return false;
+  }
+  return value >= min && value <= max;
+}
+
 void ClockWebServer::handleError() {
   static const String data = R"(
 <!DOCTYPE html>
@@ -825,230 +1038,200 @@ void ClockWebServer::handleError() {
 
 void ClockWebServer::handleWifiGet() {
   PreferencesManager &pm = PreferencesManager::getInstance();
-
-  String ssid = pm.getSSID();
-  String passwd = pm.getPassword();
-  String data = R"(
-    {
-    "ssid": ")" +
-                ssid + R"(",
-    "password": ")" +
-                passwd + R"("
-    }
-    )";
-  webServer->send(200, "application/json", data);
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+
+  json.beginObject();
+  json.add("ssid", pm.getSSID());
+  json.add("password", pm.getPassword());
+  json.endObject();
+  sendJson(json);
 }
 
 void ClockWebServer::handleWifiPost() {
   PreferencesManager &pm = PreferencesManager::getInstance();
-  String ssid = webServer->arg("ssid");
-  String passwd = webServer->arg("password");
-  if (pm.setSSID(ssid) != PREF_OK) {
-    sendError("Failed to set SSID");
-    return;
-  }
-  if (pm.setPassword(passwd) != PREF_OK) {
-    sendError("Failed to set Password");
+  pref_settings_t settings;
+  const char *error;
+
+  pm.getSettings(settings);
+  settings.ssid = webServer->arg("ssid");
+  settings.password = webServer->arg("password");
+  if (pm.applySettings(settings, error) != PREF_OK) {
+    sendError(error);
     return;
   }
   webServer->sendHeader("Location", String("/"), true);
   webServer->send(302, "text/plain", "");
   SoundPlayer::getInstance().playBeep();
-  TRACE("SSID: %s, Password: %s\n", ssid.c_str(), passwd.c_str());
+  TRACE("SSID: %s, Password: %s\n", settings.ssid.c_str(),
+        settings.password.c_str());
 }
 
 void ClockWebServer::handleSsidListGet() {
-  int n = WiFi.scanNetworks();
-
-  std::vector<std::pair<String, int>> wifiList;
-  for (int i = 0; i < n; ++i) {
-    wifiList.push_back({WiFi.SSID(i), WiFi.RSSI(i)});
-  }
-
-  // Sort by signal strength (RSSI) in descending order
-  std::sort(wifiList.begin(), wifiList.end(),
-            [](const auto &a, const auto &b) { return a.second > b.second; });
-
-  // Remove duplicates
-  std::set<String> seenSSIDs;
-  wifiList.erase(std::remove_if(wifiList.begin(), wifiList.end(),
-                                [&seenSSIDs](const auto &item) {
-                                  if (seenSSIDs.find(item.first) !=
-                                      seenSSIDs.end()) {
-                                    return true;
-                                  } else {
-                                    seenSSIDs.insert(item.first);
-                                    return false;
-                                  }
-                                }),
-                 wifiList.end());
-
-  String data = R"({"wifilist":[)";
-  for (size_t i = 0; i < wifiList.size(); ++i) {
-    if (i > 0)
-      data += ",";
-    data += R"({"ssid":")" + wifiList[i].first + R"(","signal_strength":)" +
-            String(wifiList[i].second) + R"(})";
-  }
-  data += R"(]})";
-  webServer->send(200, "application/json", data);
+  WifiScanner &scanner = WifiScanner::getInstance();
+  wifi_network_t networks[WIFI_SCAN_MAX_NETWORKS];
+
+  if (webServer->hasArg("refresh")) {
+    // Explicit refresh, wait for the new results
+    unsigned long started = millis();
+    if (scanner.startScan()) {
+      while (scanner.isScanning() && millis() - started < WIFI_SCAN_TIMEOUT) {
+        delay(100);
+        scanner.process();
+      }
+    }
+  } else if (scanner.getAge() > WIFI_SCAN_TTL) {
+    // Answer from the cache and refresh it in the background
+    scanner.startScan();
+  }
+
+  size_t count = scanner.getNetworks(networks, WIFI_SCAN_MAX_NETWORKS);
+  uint32_t age = scanner.getAge();
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+  json.beginObject();
+  json.beginArray("wifilist");
+  for (size_t i = 0; i < count; i++) {
+    json.beginObject();
+    json.add("ssid", networks[i].ssid);
+    json.add("signal_strength", (int)networks[i].rssi);
+    json.endObject();
+  }
+  json.endArray();
+  json.add("scanning", scanner.isScanning());
+  if (age != UINT32_MAX) {
+    json.add("age", age / 1000);
+  }
+  json.endObject();
+  sendJson(json);
 }
 
 void ClockWebServer::handleTimeGet() {
   PreferencesManager &pm = PreferencesManager::getInstance();
-  String ntp_server = pm.getNTPServer();
-  uint32_t ntp_timeout = pm.getNTPUpdate();
-  String timezone = pm.getTimeZone();
-  String timezone_location = pm.getTimeZoneLocation();
-  bool manual = pm.getManualTimezone();
-  int32_t manualValue = pm.getManualTimezoneValue();
-  String data = R"(
-    {
-    "ntp_server": ")" +
-                ntp_server + R"(",
-    "timezone_location": ")" +
-                timezone_location + R"(",
-    "timezone_value": ")" +
-                timezone + R"(",
-    "tz_manual_en": )" +
-                (manual ? "true" : "false") + R"(,
-    "tz_manual": ")" +
-                String(manualValue) + R"(",
-    "ntp_timeout": ")" +
-                ntp_timeout + R"("
-    }
-    )";
-  webServer->send(200, "application/json", data);
+  char buffer[SEND_CHUNK_SIZE];
+  char number[12];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+
+  json.beginObject();
+  json.add("ntp_server", pm.getNTPServer());
+  json.add("timezone_location", pm.getTimeZoneLocation());
+  json.add("timezone_value", pm.getTimeZone());
+  json.add("tz_manual_en", pm.getManualTimezone());
+  // tz_manual and ntp_timeout are kept as strings for compatibility
+  snprintf(number, sizeof(number), "%d", pm.getManualTimezoneValue());
+  json.add("tz_manual", number);
+  snprintf(number, sizeof(number), "%u", (unsigned int)pm.getNTPUpdate());
+  json.add("ntp_timeout", number);
+  json.endObject();
+  sendJson(json);
 }
 
 void ClockWebServer::handleTimePost() {
   PreferencesManager &pm = PreferencesManager::getInstance();
-  String ntp_server = webServer->arg("ntp_server");
-  String timezone = webServer->hasArg("timezone_value")
-                        ? webServer->arg("timezone_value")
-                        : "";
-  String timezone_location = webServer->hasArg("timezone_location")
-                                 ? webServer->arg("timezone_location")
-                                 : "";
-  bool manual = webServer->hasArg("tz_manual_en") &&
-                webServer->arg("tz_manual_en") == "on";
-  int32_t manual_value =
-      webServer->hasArg("tz_manual") ? webServer->arg("tz_manual").toInt() : 0;
-  uint32_t ntp_timeout = webServer->arg("ntp_timeout")
-                             ? webServer->arg("ntp_timeout").toInt()
-                             : 3600;
-
-  if (pm.setNTPServer(ntp_server) != PREF_OK) {
-    sendError("Invalid NTP Server");
-    return;
-  }
-
-  if (pm.setNTPUpdate(ntp_timeout) != PREF_OK) {
-    sendError("Invalid NTP Timeout");
-    return;
-  }
-
-  if (pm.setManualTimezone(manual) != PREF_OK) {
-    sendError("Failed to set Manual Timezone");
-    return;
-  }
-
-  if (manual) {
-    if (pm.setManualTimezoneValue(manual_value) != PREF_OK) {
-      sendError("Failed to set Manual Timezone Value");
+  pref_settings_t settings;
+  const char *error;
+
+  pm.getSettings(settings);
+  int32_t value;
+  settings.ntpserver = webServer->arg("ntp_server");
+  settings.ntp_update = 3600;
+  if (webServer->hasArg("ntp_timeout")) {
+    if (!getNumberArg("ntp_timeout", 0, INT32_MAX, value)) {
+      sendError("Invalid NTP Timeout");
       return;
     }
-  } else {
-    if (pm.setTimeZone(timezone) != PREF_OK) {
-      sendError("Failed to set TimeZone");
-      return;
+    settings.ntp_update = value;
+  }
+  settings.timezone_manual = webServer->hasArg("tz_manual_en") &&
+                             webServer->arg("tz_manual_en") == "on";
+  if (settings.timezone_manual) {
+    settings.timezone_manual_value = 0;
+    if (webServer->hasArg("tz_manual")) {
+      if (!getNumberArg("tz_manual", MIN_TIMEZONE_OFFSET,
+                        MAX_TIMEZONE_OFFSET, value)) {
+        sendError("Invalid Manual Timezone Value");
+        return;
+      }
+      settings.timezone_manual_value = value;
     }
-    if (pm.setTimeZoneLocation(timezone_location) != PREF_OK) {
-      sendError("Failed to set TimeZone Location");
+  } else {
+    // The POSIX rule is resolved on the device, timezone_value is ignored
+    zone_entry_t zone;
+    String timezone_location = webServer->arg("timezone_location");
+    if (!zones_FindByName(timezone_location.c_str(), zone)) {
+      sendError("Unknown TimeZone Location");
       return;
     }
+    settings.timezone_id = zone.id;
+  }
+
+  if (pm.applySettings(settings, error) != PREF_OK) {
+    sendError(error);
+    return;
   }
 
   webServer->sendHeader("Location", String("/"), true);
   webServer->send(302, "text/plain", "");
   SoundPlayer::getInstance().playBeep();
 
-  TRACE("NTPServer: %s, Timeout:%d, TimeZone: %s, TimezoneLocation:%s Manual: "
-        "%d, "
+  TRACE("NTPServer: %s, Timeout:%d, TimezoneId:%08X Manual: %d, "
         "ManualValue: %d\n",
-        ntp_server.c_str(), ntp_timeout, timezone.c_str(),
-        timezone_location.c_str(), manual, manual_value);
+        settings.ntpserver.c_str(), settings.ntp_update, settings.timezone_id,
+        settings.timezone_manual, settings.timezone_manual_value);
 }
 
 void ClockWebServer::handleAdvancedGet() {
   PreferencesManager &pm = PreferencesManager::getInstance();
-  String hostName = pm.getHostName();
-  String hostIP = pm.getServerIP();
-  bool flipRotation = pm.getFlipRotation();
-  bool allowBackward = pm.getAllowBackward();
-  bool chime = pm.getChime();
-  uint32_t stepsPerMinute = pm.getStepsPerMinute();
-  uint8_t delayTime = pm.getDelayTime();
-  String data = R"(
-    {
-    "host_name": ")" +
-                hostName + R"(",
-    "host_ip": ")" +
-                hostIP + R"(",
-    "flip_rotation": )" +
-                (flipRotation ? "true" : "false") + R"(,
-    "allow_backward": )" +
-                (allowBackward ? "true" : "false") + R"(,
-    "chime": )" +
-                (chime ? "true" : "false") + R"(,
-    "steps_per_minute": )" +
-                String(stepsPerMinute) + R"(,
-    "delay_time": )" +
-                String(delayTime) + R"(
-    }
-    )";
-  webServer->send(200, "application/json", data);
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+
+  json.beginObject();
+  json.add("host_name", pm.getHostName());
+  json.add("host_ip", pm.getServerIP());
+  json.add("flip_rotation", pm.getFlipRotation());
+  json.add("allow_backward", pm.getAllowBackward());
+  json.add("chime", pm.getChime());
+  json.add("jump_policy", (unsigned int)pm.getJumpPolicy());
+  json.add("steps_per_minute", pm.getStepsPerMinute());
+  json.add("delay_time", (unsigned int)pm.getDelayTime());
+  json.endObject();
+  sendJson(json);
 }
 
 void ClockWebServer::handleAdvancedPost() {
   PreferencesManager &pm = PreferencesManager::getInstance();
-  String hostName =
-      webServer->hasArg("host_name") ? webServer->arg("host_name") : "";
-  String hostIP = webServer->hasArg("host_ip") ? webServer->arg("host_ip") : "";
-  bool flipRotation = webServer->hasArg("flip_rotation") &&
-                      webServer->arg("flip_rotation") == "on";
-  bool allowBackward = webServer->hasArg("allow_backward") &&
-                       webServer->arg("allow_backward") == "on";
-  bool chime = webServer->hasArg("chime") && webServer->arg("chime") == "on";
-  uint32_t stepsPerMinute = webServer->arg("steps_per_minute").toInt();
-  uint8_t delayTime = webServer->arg("delay_time").toInt();
-  if (pm.setHostName(hostName) != PREF_OK) {
-    sendError("Failed to set Host Name");
-    return;
-  }
-  if (pm.setServerIP(hostIP) != PREF_OK) {
-    sendError("Failed to set Host IP");
-    return;
-  }
-  if (pm.setFlipRotation(flipRotation) != PREF_OK) {
-    sendError("Failed to set Flip Rotation");
-    return;
-  }
-  if (pm.setAllowBackward(allowBackward) != PREF_OK) {
-    sendError("Failed to set Allow Backward");
-    return;
+  pref_settings_t settings;
+  const char *error;
+
+  pm.getSettings(settings);
+  settings.hostname = webServer->arg("host_name");
+  settings.server_ip = webServer->arg("host_ip");
+  settings.flip_rotation = webServer->hasArg("flip_rotation") &&
+                           webServer->arg("flip_rotation") == "on";
+  settings.allow_backward = webServer->hasArg("allow_backward") &&
+                            webServer->arg("allow_backward") == "on";
+  settings.chime = webServer->hasArg("chime") && webServer->arg("chime") == "on";
+  int32_t value;
+  if (webServer->hasArg("jump_policy")) {
+    if (!getNumberArg("jump_policy", 0, UINT8_MAX, value)) {
+      sendError("Invalid Jump Policy");
+      return;
+    }
+    settings.jump_policy = value;
   }
-
-  if (pm.setChime(chime) != PREF_OK) {
-    sendError("Failed to set Chime");
+  if (!getNumberArg("steps_per_minute", 0, INT32_MAX, value)) {
+    sendError("Invalid Steps Per Minute");
     return;
   }
-  if (pm.setStepsPerMinute(stepsPerMinute) != PREF_OK) {
-    sendError("Failed to set Steps Per Minute");
+  settings.steps_per_minute = value;
+  // Checked before the cast, 258 would become a valid 2
+  if (!getNumberArg("delay_time", 0, UINT8_MAX, value)) {
+    sendError("Invalid Delay Time");
     return;
   }
-  if (pm.setDelayTime(delayTime) != PREF_OK) {
-    sendError("Failed to set Delay Time");
+  settings.delay_time = value;
+  if (pm.applySettings(settings, error) != PREF_OK) {
+    sendError(error);
     return;
   }
   webServer->sendHeader("Location", String("/"), true);
@@ -1057,12 +1240,106 @@ void ClockWebServer::handleAdvancedPost() {
 
   TRACE("Set: HostName: %s, HostIP: %s, FlipRotation: %d, StepsPerMinute: %d, "
         "DelayTime: %d\n",
-        hostName.c_str(), hostIP.c_str(), flipRotation, stepsPerMinute,
-        delayTime);
+        settings.hostname.c_str(), settings.server_ip.c_str(),
+        settings.flip_rotation, settings.steps_per_minute, settings.delay_time);
 }
 
-void ClockWebServer::handleCalibrationPost() {
+void ClockWebServer::writeConfig(JsonWriter &json,
+                                 const pref_settings_t &settings) {
+  zone_entry_t zone;
+
+  json.beginObject();
+  PreferencesManager::writeJson(json, settings);
+  // Read only, resolved from the location
+  if (zones_FindById(settings.timezone_id, zone)) {
+    json.add("timezone_value", zone.rule);
+  } else {
+    json.addNull("timezone_value");
+  }
+  json.endObject();
+}
+
+void ClockWebServer::sendJsonError(int code, const char *message,
+                                   const char *field) {
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+
+  json.beginObject();
+  json.add("error", message);
+  if (field != nullptr) {
+    json.add("field", field);
+  }
+  json.endObject();
+  sendJson(json, code);
+}
+
+void ClockWebServer::handleConfigGet() {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+  pref_settings_t settings;
+
+  pm.getSettings(settings);
+  writeConfig(json, settings);
+  sendJson(json);
+}
+
+void ClockWebServer::handleConfigPut() { updateConfig(true); }
+
+void ClockWebServer::handleConfigPatch() { updateConfig(false); }
+
+// PUT replaces the whole configuration and needs every field, PATCH changes
+// only the fields present. Either way all fields are checked before anything
+// is stored.
+void ClockWebServer::updateConfig(bool replace) {
   PreferencesManager &pm = PreferencesManager::getInstance();
+  const String &body = webServer->arg("plain");
+  JsonReader reader(body.c_str(), body.length());
+  pref_settings_t settings;
+  uint32_t present = 0;
+  String key, value;
+  json_type_t type;
+  const char *error;
+
+  pm.getSettings(settings);
+  while (reader.next(key, type, value)) {
+    if (key == "timezone_value") {
+      continue; // read only
+    }
+    int field = PreferencesManager::findField(key);
+    if (field < 0) {
+      sendJsonError(400, "Unknown field", key.c_str());
+      return;
+    }
+    if (!PreferencesManager::parseField(field, type, value, settings)) {
+      sendJsonError(400, "Invalid value", key.c_str());
+      return;
+    }
+    present |= 1UL << field;
+  }
+  if (reader.failed()) {
+    sendJsonError(400, reader.getError());
+    return;
+  }
+  if (replace) {
+    for (int field = 0; field < PREF_FIELDS_COUNT; field++) {
+      if (!(present & (1UL << field))) {
+        sendJsonError(400, "Missing field",
+                      PreferencesManager::getFieldName(field));
+        return;
+      }
+    }
+  }
+
+  if (pm.applySettings(settings, error) != PREF_OK) {
+    sendJsonError(400, error);
+    return;
+  }
+  TRACE("Config updated, fields:%08X\n", present);
+  handleConfigGet();
+}
+
+void ClockWebServer::handleCalibrationPost() {
   HollowClock &hclock = HollowClock::getInstance();
 
   bool clock_start =
@@ -1094,8 +1371,9 @@ void ClockWebServer::handleCalibrationPost() {
       sendError("Failed to send command - queue full");
     }
   } else if (clock_move) {
-    int steps = webServer->arg("steps").toInt();
-    if (steps < -184320 || steps > 184320) {
+    int32_t steps;
+    int dial = hclock.getDialSteps();
+    if (!getNumberArg("steps", -dial, dial, steps)) {
       sendError("Invalid number of steps");
     } else {
       if (hclock.moveSteps(steps) == HCLOCK_OK) {
@@ -1108,11 +1386,12 @@ void ClockWebServer::handleCalibrationPost() {
       }
     }
   } else if (clock_set) {
-    int hourHand = webServer->arg("hour_hand").toInt();
-    int minuteHand = webServer->arg("minute_hand").toInt(); /* code */
-    if (hourHand < 1 || hourHand > 12 || minuteHand < 0 || minuteHand > 59) {
-      String errorMsg = "Invalid position: HourHand: " + String(hourHand) +
-                        ", MinuteHand: " + String(minuteHand);
+    int32_t hourHand, minuteHand;
+    if (!getNumberArg("hour_hand", 1, 12, hourHand) ||
+        !getNumberArg("minute_hand", 0, 59, minuteHand)) {
+      String errorMsg = "Invalid position: HourHand: " +
+                        webServer->arg("hour_hand") +
+                        ", MinuteHand: " + webServer->arg("minute_hand");
       TRACE("%s\n", errorMsg.c_str());
       sendError(errorMsg);
     } else {
@@ -1125,22 +1404,291 @@ void ClockWebServer::handleCalibrationPost() {
         sendError("Failed to send command - queue full");
       }
     }
+  } else {
+    sendError("Unknown calibration command");
   }
 }
 
+void ClockWebServer::getClockState(clock_state_t &state) {
+  HollowClock &hclock = HollowClock::getInstance();
+  char local_time[24];
+  char synced_time[8];
+
+  memset(&state, 0, sizeof(state));
+  state.synced = hclock.getLocalTime(local_time, sizeof(local_time));
+  hclock.getLastSyncedTime(synced_time, sizeof(synced_time));
+  snprintf(state.local_time, sizeof(state.local_time),
+           "%s (Last updated at: %s )", local_time, synced_time);
+  state.calibrated =
+      hclock.getHandsPosition(state.hands_position, sizeof(state.hands_position));
+  state.positioning = hclock.isPositioning();
+}
+
+void ClockWebServer::writeClockState(JsonWriter &json,
+                                     const clock_state_t &state) {
+  json.beginObject();
+  json.add("local_time", state.local_time);
+  json.add("hands_position", state.hands_position);
+  json.add("positioning", state.positioning);
+  json.add("calibrated", state.calibrated);
+  json.add("synced", state.synced);
+  json.endObject();
+}
+
 void ClockWebServer::handlePositionGet() {
-  String data = R"(
-    {
-    "local_time": ")" +
-                HollowClock::getInstance().getLocalTime() +
-                R"( (Last updated at: )" +
-                HollowClock::getInstance().getLastSyncedTime() + R"( ))" + R"(",
-    "hands_position": ")" +
-                HollowClock::getInstance().getHandsPosition() + R"("
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+  clock_state_t state;
+
+  getClockState(state);
+  writeClockState(json, state);
+  sendJson(json);
+}
+
+size_t ClockWebServer::formatEvent(char *buffer, size_t size) {
+  static const char prefix[] = "data: ";
+  // Leave room for the prefix and the terminating empty line
+  JsonWriter json(buffer + sizeof(prefix) - 1, size - sizeof(prefix) - 1);
+
+  writeClockState(json, eventState);
+  if (json.overflow()) {
+    return 0;
+  }
+  memcpy(buffer, prefix, sizeof(prefix) - 1);
+  size_t len = sizeof(prefix) - 1 + json.length();
+  buffer[len++] = '\n';
+  buffer[len++] = '\n';
+  return len;
+}
+
+void ClockWebServer::handleEventsGet() {
+  int slot = -1;
+  for (int i = 0; i < EVENT_CLIENTS_MAX; i++) {
+    if (!eventClients[i].connected()) {
+      eventClients[i].stop();
+      slot = i;
+      break;
     }
-  )";
-  webServer->send(200, "application/json", data);
+  }
+  if (slot < 0) {
+    webServer->send(503, "text/plain", "Too many listeners");
+    return;
+  }
+
+  // The connection is taken over from the web server and kept open
+  WiFiClient &client = eventClients[slot];
+  client = webServer->client();
+  client.setNoDelay(true);
+  client.print("HTTP/1.1 200 OK\r\n"
+               "Content-Type: text/event-stream\r\n"
+               "Cache-Control: no-cache\r\n"
+               "Connection: keep-alive\r\n"
+               "\r\n"
+               "retry: 5000\n\n");
+
+  // New listener gets the current state right away, the others only if it
+  // has changed since the last update
+  char buffer[EVENT_BUFFER_SIZE];
+  clock_state_t state;
+  getClockState(state);
+  if (memcmp(&state, &eventState, sizeof(state)) != 0) {
+    eventState = state;
+    broadcastEvent(buffer, formatEvent(buffer, sizeof(buffer)));
+  } else {
+    size_t len = formatEvent(buffer, sizeof(buffer));
+    client.write((const uint8_t *)buffer, len);
+  }
+  TRACE("Event listener %d connected\n", slot);
+}
+
+void ClockWebServer::broadcastEvent(const char *data, size_t len) {
+  for (int i = 0; i < EVENT_CLIENTS_MAX; i++) {
+    if (!eventClients[i].connected()) {
+      continue;
+    }
+    if (eventClients[i].write((const uint8_t *)data, len) != len) {
+      TRACE("Event listener %d dropped\n", i);
+      eventClients[i].stop();
+    }
+  }
+  eventSent = millis();
+}
+
+void ClockWebServer::pushEvents() {
+  unsigned long now = millis();
+  if (now - eventPolled < EVENT_POLL_INTERVAL) {
+    return;
+  }
+  eventPolled = now;
+
+  bool listening = false;
+  for (int i = 0; i < EVENT_CLIENTS_MAX; i++) {
+    listening = listening || eventClients[i].connected();
+  }
+  if (!listening) {
+    return;
+  }
+
+  clock_state_t state;
+  getClockState(state);
+  if (memcmp(&state, &eventState, sizeof(state)) != 0) {
+    // Serialized once and shared by all listeners
+    char buffer[EVENT_BUFFER_SIZE];
+    eventState = state;
+    size_t len = formatEvent(buffer, sizeof(buffer));
+    broadcastEvent(buffer, len);
+  } else if (now - eventSent >= EVENT_KEEPALIVE_INTERVAL) {
+    static const char keepalive[] = ":\n\n";
+    broadcastEvent(keepalive, sizeof(keepalive) - 1);
+  }
+}
+bool ClockWebServer::checkETag(const String &etag) {
+  webServer->sendHeader("ETag", etag);
+  webServer->sendHeader("Cache-Control", "no-cache");
+  if (webServer->header("If-None-Match") == etag) {
+    webServer->send(304, "application/json", "");
+    return true;
+  }
+  return false;
+}
+
+void ClockWebServer::jsonFlush(void *context, const char *data, size_t len) {
+  ClockWebServer *server = static_cast<ClockWebServer *>(context);
+  // The document does not fit the buffer - switch to chunked transfer
+  if (!server->jsonChunked) {
+    server->jsonChunked = true;
+    server->webServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server->webServer->send(200, "application/json", "");
+  }
+  server->webServer->sendContent(data, len);
+}
+
+void ClockWebServer::sendJson(JsonWriter &json, int code) {
+  if (jsonChunked) {
+    json.flush();
+    webServer->sendContent("");
+    jsonChunked = false;
+  } else {
+    webServer->send_P(code, "application/json", json.data(), json.length());
+  }
+}
+
+void ClockWebServer::sendChunked(const char *data, size_t len) {
+  while (len > 0) {
+    size_t chunk = (len > SEND_CHUNK_SIZE) ? SEND_CHUNK_SIZE : len;
+    webServer->sendContent(data, chunk);
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+void ClockWebServer::handleZonesGet() {
+  if (webServer->hasArg("prefix")) {
+    sendZones(webServer->arg("prefix"));
+    return;
+  }
+  // Clients not accepting gzip get the list built from the zone tables
+  if (webServer->header("Accept-Encoding").indexOf("gzip") < 0) {
+    sendZones("");
+    return;
+  }
+
+  String etag = String("\"") + zones_ETag() + "-gz\"";
+  webServer->sendHeader("Vary", "Accept-Encoding");
+  if (checkETag(etag)) {
+    return;
+  }
+
+  size_t len;
+  const char *data = (const char *)zones_JsonGz(len);
+  webServer->sendHeader("Content-Encoding", "gzip");
+  webServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  webServer->send(200, "application/json", "");
+  sendChunked(data, len);
+  webServer->sendContent("");
+}
+
+void ClockWebServer::sendZones(const String &prefix) {
+  // Caches must not hand this list to a client accepting gzip or back
+  String etag = String("\"") + zones_ETag() + "\"";
+  webServer->sendHeader("Vary", "Accept-Encoding");
+  if (checkETag(etag)) {
+    return;
+  }
+
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+  json.beginObject();
+  zones_ForEach(prefix.c_str(), [&json](const zone_entry_t &zone) {
+    json.add(zone.name, zone.rule);
+    return true;
+  });
+  json.endObject();
+  sendJson(json);
+}
+
+void ClockWebServer::sendZone(const String &name) {
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+  zone_entry_t zone;
+
+  json.beginObject();
+  if (!zones_FindByName(name.c_str(), zone)) {
+    json.add("error", "Unknown zone");
+    json.endObject();
+    sendJson(json, 404);
+    return;
+  }
+  String etag = String("\"") + zones_ETag() + "\"";
+  if (checkETag(etag)) {
+    return;
+  }
+  json.add("name", zone.name);
+  json.add("rule", zone.rule);
+  json.endObject();
+  sendJson(json);
+}
+
+// In AP mode any request for another host that came in on the access
+// point is sent to the setup page, which makes the phones show the captive
+// portal right away. Requests on the station side are answered as usual.
+bool ClockWebServer::captivePortalRedirect() {
+  if (!(WiFi.getMode() & WIFI_AP)) {
+    return false;
+  }
+  IPAddress ap_ip = WiFi.softAPIP();
+  bool on_ap = webServer->client().localIP() == ap_ip;
+  String ip = ap_ip.toString();
+  if (!on_ap || webServer->hostHeader() == ip) {
+    return false;
+  }
+  webServer->sendHeader("Location", String("http://") + ip + "/", true);
+  webServer->sendHeader("Cache-Control", "no-cache");
+  webServer->send(302, "text/plain", "");
+  return true;
 }
+
+void ClockWebServer::handleCaptiveProbe() {
+  if (!captivePortalRedirect()) {
+    webServer->send(404, "text/plain", "Not found");
+  }
+}
+
+void ClockWebServer::handleNotFound() {
+  static const char zones_path[] = "/zones/";
+  String uri = webServer->uri();
+
+  if (captivePortalRedirect()) {
+    return;
+  }
+
+  if (webServer->method() == HTTP_GET && uri.startsWith(zones_path)) {
+    sendZone(uri.substring(sizeof(zones_path) - 1));
+    return;
+  }
+  webServer->send(404, "text/plain", "Not found");
+}
+
 void ClockWebServer::handleApplyPost() {
   HollowClock &hclock = HollowClock::getInstance();
 
@@ -1150,6 +1698,7 @@ void ClockWebServer::handleApplyPost() {
   if (hclock.isCalibrated()) {
     hclock.saveClockPosition();
   }
+  PreferencesManager::getInstance().commit();
   SoundPlayer::getInstance().playBeep();
   delay(1000);
   SoundPlayer::getInstance().playBeep();
@@ -1161,6 +1710,50 @@ void ClockWebServer::handleApplyPost() {
 #endif
 }
 
+// Firmware image is streamed to the flash chunk by chunk, nothing is buffered
+void ClockWebServer::handleUpdateUpload() {
+  FirmwareUpdate &update = FirmwareUpdate::getInstance();
+  HTTPUpload &upload = webServer->upload();
+
+  switch (upload.status) {
+  case UPLOAD_FILE_START:
+    TRACE("Firmware upload: %s\n", upload.filename.c_str());
+    update.begin(webServer->arg("sha256").c_str());
+    break;
+  case UPLOAD_FILE_WRITE:
+    update.write(upload.buf, upload.currentSize);
+    break;
+  case UPLOAD_FILE_END:
+    update.end();
+    break;
+  case UPLOAD_FILE_ABORTED:
+    update.abort();
+    break;
+  }
+}
+
+void ClockWebServer::handleUpdatePost() {
+  FirmwareUpdate &update = FirmwareUpdate::getInstance();
+  HollowClock &hclock = HollowClock::getInstance();
+
+  if (update.getState() != OTA_DONE) {
+    sendError(update.getError() != nullptr ? update.getError()
+                                           : "No firmware uploaded");
+    return;
+  }
+  webServer->sendHeader("Location", String("/"), true);
+  webServer->send(302, "text/plain", "");
+
+  if (hclock.isCalibrated()) {
+    hclock.saveClockPosition();
+  }
+  PreferencesManager::getInstance().commit();
+  SoundPlayer::getInstance().playBeep();
+  ERROR("Rebooting to the new firmware....\n");
+  delay(1000);
+  ESP.restart();
+}
+
 void ClockWebServer::handleResetPost() {
   PreferencesManager &pm = PreferencesManager::getInstance();
   webServer->sendHeader("Location", String("/"), true);
@@ -1180,4 +1773,427 @@ void ClockWebServer::handleResetPost() {
 void ClockWebServer::send(int code, const char *content_type,
                           const String &data) {
   webServer->send(code, content_type, data);
-}
\ No newline at end of file
+}
+
+void ClockWebServer::metricsPrintf(metrics_buffer_t &buffer, const char *format,
+                                   ...) {
+  va_list args;
+  size_t free = sizeof(buffer.data) - buffer.len;
+
+  va_start(args, format);
+  int len = vsnprintf(buffer.data + buffer.len, free, format, args);
+  va_end(args);
+  if (len < 0) {
+    return;
+  }
+  if ((size_t)len >= free && buffer.len > 0) {
+    // Does not fit, send what we have and format again
+    webServer->sendContent(buffer.data, buffer.len);
+    buffer.len = 0;
+    free = sizeof(buffer.data);
+    va_start(args, format);
+    len = vsnprintf(buffer.data, free, format, args);
+    va_end(args);
+  }
+  buffer.len += ((size_t)len < free) ? len : free - 1;
+}
+
+void ClockWebServer::addMetric(metrics_buffer_t &buffer, const char *name,
+                               const char *type, const char *help,
+                               long long value) {
+  metricsPrintf(buffer, "# HELP %s %s\n# TYPE %s %s\n%s %lld\n", name, help,
+                name, type, name, value);
+}
+
+void ClockWebServer::addSystemMetrics(metrics_buffer_t &buffer) {
+  SystemMonitor &monitor = SystemMonitor::getInstance();
+  monitor_task_t tasks[MONITOR_TASKS_MAX];
+  monitor_stats_t stats;
+  size_t count = monitor.getTasks(tasks, MONITOR_TASKS_MAX);
+  monitor.getStats(stats);
+
+  metricsPrintf(buffer, "# HELP hollowclock_task_stack_free_bytes Stack a "
+                        "task never used.\n"
+                        "# TYPE hollowclock_task_stack_free_bytes gauge\n");
+  for (size_t i = 0; i < count; i++) {
+    metricsPrintf(buffer, "hollowclock_task_stack_free_bytes{task=\"%s\"} %u\n",
+                  tasks[i].name, (unsigned int)tasks[i].stack_free);
+  }
+  addMetric(buffer, "hollowclock_heap_fragmentation_percent", "gauge",
+            "Free heap outside the largest block.", stats.fragmentation);
+  addMetric(buffer, "hollowclock_heap_trend_bytes_per_hour", "gauge",
+            "Change of the free heap over the last two days.",
+            stats.heap_trend);
+  addMetric(buffer, "hollowclock_monitor_alerts_total", "counter",
+            "Stack and heap alerts raised.", stats.alert_count);
+  metricsPrintf(buffer, "# HELP hollowclock_monitor_alert Stack or heap "
+                        "alert active.\n"
+                        "# TYPE hollowclock_monitor_alert gauge\n");
+  for (int i = 0; i < MONITOR_ALERT_COUNT; i++) {
+    metricsPrintf(buffer, "hollowclock_monitor_alert{alert=\"%s\"} %d\n",
+                  SystemMonitor::getAlertName((monitor_alert_t)i),
+                  (stats.alerts >> i) & 1 ? 1 : 0);
+  }
+}
+
+// Prometheus text exposition format
+void ClockWebServer::addNtpMetrics(metrics_buffer_t &buffer) {
+  SntpClient &sntp = SntpClient::getInstance();
+  sntp_server_t servers[SNTP_SERVERS_MAX];
+  sntp_stats_t stats;
+  static const struct {
+    const char *name;
+    const char *help;
+    int64_t sntp_server_t::*field;
+  } server_metrics[] = {
+      {"offset", "Offset of the server against the clock.",
+       &sntp_server_t::offset},
+      {"delay", "Round trip to the server.", &sntp_server_t::delay},
+      {"jitter", "Spread of the samples of the last burst.",
+       &sntp_server_t::jitter},
+  };
+
+  sntp.getStats(stats);
+  size_t count = sntp.getServers(servers, SNTP_SERVERS_MAX);
+
+  addMetric(buffer, "hollowclock_ntp_synced", "gauge",
+            "1 once the time came from NTP.", stats.synced);
+  metricsPrintf(buffer,
+                "# HELP hollowclock_ntp_offset_seconds Combined offset of "
+                "the selected servers.\n"
+                "# TYPE hollowclock_ntp_offset_seconds gauge\n"
+                "hollowclock_ntp_offset_seconds %.6f\n"
+                "# HELP hollowclock_ntp_delay_seconds Round trip to the "
+                "best selected server.\n"
+                "# TYPE hollowclock_ntp_delay_seconds gauge\n"
+                "hollowclock_ntp_delay_seconds %.6f\n"
+                "# HELP hollowclock_ntp_jitter_seconds Spread of the "
+                "selected servers.\n"
+                "# TYPE hollowclock_ntp_jitter_seconds gauge\n"
+                "hollowclock_ntp_jitter_seconds %.6f\n",
+                stats.offset / 1e6, stats.delay / 1e6, stats.jitter / 1e6);
+  addMetric(buffer, "hollowclock_ntp_steps_total", "counter",
+            "Updates that stepped the clock.", stats.steps);
+  addMetric(buffer, "hollowclock_ntp_slews_total", "counter",
+            "Updates that slewed the clock.", stats.slews);
+  addMetric(buffer, "hollowclock_ntp_disagreements_total", "counter",
+            "Polls whose servers had no majority, the time was kept.",
+            stats.disagreements);
+
+  for (const auto &metric : server_metrics) {
+    metricsPrintf(buffer,
+                  "# HELP hollowclock_ntp_server_%s_seconds %s\n"
+                  "# TYPE hollowclock_ntp_server_%s_seconds gauge\n",
+                  metric.name, metric.help, metric.name);
+    for (size_t i = 0; i < count; i++) {
+      if (servers[i].valid) {
+        metricsPrintf(buffer,
+                      "hollowclock_ntp_server_%s_seconds{server=\"%s\"} "
+                      "%.6f\n",
+                      metric.name, servers[i].name,
+                      servers[i].*metric.field / 1e6);
+      }
+    }
+  }
+  metricsPrintf(buffer, "# HELP hollowclock_ntp_server_selected 1 if the "
+                        "server was used for the last update.\n"
+                        "# TYPE hollowclock_ntp_server_selected gauge\n");
+  for (size_t i = 0; i < count; i++) {
+    metricsPrintf(buffer,
+                  "hollowclock_ntp_server_selected{server=\"%s\"} %d\n",
+                  servers[i].name, servers[i].selected);
+  }
+  metricsPrintf(buffer, "# HELP hollowclock_ntp_server_reach Answers to the "
+                        "last 8 polls, one bit each.\n"
+                        "# TYPE hollowclock_ntp_server_reach gauge\n");
+  for (size_t i = 0; i < count; i++) {
+    metricsPrintf(buffer,
+                  "hollowclock_ntp_server_reach{server=\"%s\"} %u\n",
+                  servers[i].name, servers[i].reach);
+  }
+}
+
+void ClockWebServer::handleMetricsGet() {
+  metrics_buffer_t buffer;
+  hclock_stats_t stats;
+  net_stats_t net;
+  log_stats_t log_stats;
+  static const char *const methods[HTTP_COUNTER_COUNT] = {"GET", "POST",
+                                                          "other"};
+
+  HollowClock::getInstance().getStats(stats);
+  NetworkManager::getInstance().getStats(net);
+  Logger::getInstance().getStats(log_stats);
+  buffer.len = 0;
+  webServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  webServer->send(200, "text/plain; version=0.0.4", "");
+
+  addMetric(buffer, "hollowclock_uptime_seconds", "counter",
+            "Time since boot.", esp_timer_get_time() / 1000000);
+  addMetric(buffer, "hollowclock_heap_free_bytes", "gauge", "Free heap.",
+            ESP.getFreeHeap());
+  addMetric(buffer, "hollowclock_heap_min_free_bytes", "gauge",
+            "Lowest free heap since boot.", ESP.getMinFreeHeap());
+  addMetric(buffer, "hollowclock_heap_largest_block_bytes", "gauge",
+            "Largest block that can be allocated.", ESP.getMaxAllocHeap());
+  addMetric(buffer, "hollowclock_clock_stack_free_bytes", "gauge",
+            "Clock thread stack high-water mark.", stats.stack_free);
+  addSystemMetrics(buffer);
+  addMetric(buffer, "hollowclock_loop_time_us", "gauge",
+            "Duration of the last loop iteration.", loopTime);
+  addMetric(buffer, "hollowclock_loop_time_max_us", "gauge",
+            "Longest loop iteration since the previous scrape.", loopTimeMax);
+  loopTimeMax = 0;
+
+  addMetric(buffer, "hollowclock_motor_steps_total", "counter",
+            "Motor steps moved.", MotorControl::getInstance().getStepsMoved());
+  addMetric(buffer, "hollowclock_positioning_events_total", "counter",
+            "Fast moves of the hands to the current time.",
+            stats.positioning_events);
+  addMetric(buffer, "hollowclock_queue_drops_total", "counter",
+            "Commands rejected by the full clock queue.", stats.queue_drops);
+  addMetric(buffer, "hollowclock_ntp_syncs_total", "counter",
+            "Time updates received from NTP.", stats.ntp_syncs);
+  metricsPrintf(buffer,
+                "# HELP hollowclock_ntp_last_offset_seconds Correction "
+                "applied by the last NTP update.\n"
+                "# TYPE hollowclock_ntp_last_offset_seconds gauge\n"
+                "hollowclock_ntp_last_offset_seconds %.3f\n",
+                stats.ntp_offset / 1000.0);
+  addNtpMetrics(buffer);
+  addMetric(buffer, "hollowclock_ticks_total", "counter",
+            "Minute ticks of the hands.", stats.ticks.ticks);
+  if (stats.ticks.ticks > 0) {
+    metricsPrintf(buffer,
+                  "# HELP hollowclock_tick_lateness_seconds How long after "
+                  "the minute the ticks ended, negative if before.\n"
+                  "# TYPE hollowclock_tick_lateness_seconds gauge\n"
+                  "hollowclock_tick_lateness_seconds{stat=\"last\"} %.3f\n"
+                  "hollowclock_tick_lateness_seconds{stat=\"min\"} %.3f\n"
+                  "hollowclock_tick_lateness_seconds{stat=\"max\"} %.3f\n"
+                  "hollowclock_tick_lateness_seconds{stat=\"avg\"} %.3f\n",
+                  stats.ticks.last / 1000.0, stats.ticks.min / 1000.0,
+                  stats.ticks.max / 1000.0,
+                  stats.ticks.sum / 1000.0 / stats.ticks.ticks);
+  }
+
+  metricsPrintf(buffer, "# HELP hollowclock_time_jumps_total Time jumps the "
+                        "hands had to follow, by outcome.\n"
+                        "# TYPE hollowclock_time_jumps_total counter\n");
+  for (int i = 0; i < JUMP_OUTCOME_COUNT; i++) {
+    metricsPrintf(buffer, "hollowclock_time_jumps_total{outcome=\"%s\"} %u\n",
+                  HollowClock::getJumpOutcomeName((hclock_jump_outcome_t)i),
+                  stats.jumps[i]);
+  }
+  addMetric(buffer, "hollowclock_hand_holds_total", "counter",
+            "Times the hands waited for the time instead of going round.",
+            stats.holds);
+
+  if (WiFi.status() == WL_CONNECTED) {
+    addMetric(buffer, "hollowclock_wifi_rssi_dbm", "gauge",
+              "Signal strength of the access point.", WiFi.RSSI());
+  }
+  metricsPrintf(buffer, "# HELP hollowclock_wifi_state Network connection "
+                        "state.\n"
+                        "# TYPE hollowclock_wifi_state gauge\n");
+  for (int state = NET_IDLE; state <= NET_AP; state++) {
+    metricsPrintf(buffer, "hollowclock_wifi_state{state=\"%s\"} %d\n",
+                  NetworkManager::getStateName((net_state_t)state),
+                  net.state == state);
+  }
+  addMetric(buffer, "hollowclock_wifi_ap_active", "gauge",
+            "1 while the setup access point is up.", net.ap_active);
+  addMetric(buffer, "hollowclock_wifi_state_seconds", "gauge",
+            "Time spent in the current network state.",
+            net.state_time / 1000);
+  addMetric(buffer, "hollowclock_wifi_connect_attempts_total", "counter",
+            "Attempts to join the access point.", net.attempts);
+  addMetric(buffer, "hollowclock_wifi_connect_failures", "gauge",
+            "Failed attempts in a row.", net.failures);
+  addMetric(buffer, "hollowclock_wifi_connect_milliseconds", "gauge",
+            "Time the boot spent connecting to the access point.",
+            net.connect_time);
+  addMetric(buffer, "hollowclock_wifi_fast_connect", "gauge",
+            "1 if the boot reused the cached access point.",
+            net.fast_connect);
+  addMetric(buffer, "hollowclock_wifi_reconnects_total", "counter",
+            "Reconnects after losing the access point.", net.disconnects);
+  addMetric(buffer, "hollowclock_nvs_writes_total", "counter",
+            "Values written to the settings flash.",
+            PreferencesManager::getInstance().getNvsWrites());
+  addMetric(buffer, "hollowclock_nvs_commits_total", "counter",
+            "Commits of the settings flash.",
+            PreferencesManager::getInstance().getNvsCommits());
+  addMetric(buffer, "hollowclock_log_records_total", "counter",
+            "Log records written.", log_stats.records);
+  addMetric(buffer, "hollowclock_log_lost_total", "counter",
+            "Log records overwritten before the serial port got them.",
+            log_stats.lost);
+
+  metricsPrintf(buffer, "# HELP hollowclock_http_requests_total HTTP requests "
+                        "handled.\n"
+                        "# TYPE hollowclock_http_requests_total counter\n");
+  for (int i = 0; i < HTTP_COUNTER_COUNT; i++) {
+    metricsPrintf(buffer,
+                  "hollowclock_http_requests_total{method=\"%s\"} %u\n",
+                  methods[i], (unsigned int)httpRequests[i]);
+  }
+
+  if (buffer.len > 0) {
+    webServer->sendContent(buffer.data, buffer.len);
+  }
+  webServer->sendContent("");
+}
+
+void ClockWebServer::handleBootGet() {
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+
+  json.beginObject();
+  BootProfiler::getInstance().writeJson(json);
+  json.endObject();
+  sendJson(json);
+}
+
+// The records in the ring, oldest first
+void ClockWebServer::handleLogGet() {
+  Logger &logger = Logger::getInstance();
+  metrics_buffer_t buffer;
+  log_record_t record;
+  char line[LOG_LINE_MAX];
+  uint32_t cursor = logger.getOldest();
+  uint32_t lost = 0;
+
+  buffer.len = 0;
+  webServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  webServer->send(200, "text/plain", "");
+  // Bounded, new records keep coming in while this is sent
+  for (int i = 0; i < LOG_RECORDS && logger.read(cursor, record, lost); i++) {
+    Logger::format(record, line, sizeof(line));
+    metricsPrintf(buffer, "%s\n", line);
+  }
+  if (buffer.len > 0) {
+    webServer->sendContent(buffer.data, buffer.len);
+  }
+  webServer->sendContent("");
+}
+
+// Sets the level of a module, or of all without one, and the serial output.
+// Answers with the current settings.
+void ClockWebServer::handleLogPost() {
+  Logger &logger = Logger::getInstance();
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+  log_stats_t stats;
+
+  int module = LOG_MODULE_COUNT;
+  if (webServer->hasArg("module") &&
+      (module = Logger::findModule(webServer->arg("module"))) < 0) {
+    sendJsonError(400, "Unknown module", "module");
+    return;
+  }
+  if (webServer->hasArg("level")) {
+    int level = Logger::findLevel(webServer->arg("level"));
+    if (level < 0) {
+      sendJsonError(400, "Unknown level", "level");
+      return;
+    }
+    for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+      if (module == LOG_MODULE_COUNT || module == i) {
+        logger.setLevel((log_module_t)i, (log_level_t)level);
+      }
+    }
+  }
+  if (webServer->hasArg("serial")) {
+    logger.setSerial(webServer->arg("serial") == "on");
+  }
+
+  logger.getStats(stats);
+  json.beginObject();
+  json.add("serial", logger.getSerial());
+  json.add("records", stats.records);
+  json.add("lost", stats.lost);
+  json.beginObject("levels");
+  for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+    json.add(Logger::getModuleName((log_module_t)i),
+             Logger::getLevelName(logger.getLevel((log_module_t)i)));
+  }
+  json.endObject();
+  json.endObject();
+  sendJson(json);
+}
+
+void ClockWebServer::handleDiagnosticsGet() {
+  char buffer[SEND_CHUNK_SIZE];
+  JsonWriter json(buffer, sizeof(buffer), jsonFlush, this);
+  unsigned long now = millis();
+
+  json.beginObject();
+  json.beginObject("loop");
+  json.add("time_us", loopTime);
+  json.add("max_us", loopTimeMax);
+  json.add("outside_us", loopOutsideTime);
+  json.add("outside_max_us", loopOutsideMax);
+  json.endObject();
+
+  // Upper bounds of the histogram buckets, the last one is open
+  json.beginArray("buckets_ms");
+  for (int i = 0; i < ROUTE_HISTOGRAM_BUCKETS - 1; i++) {
+    json.add(1LL << i);
+  }
+  json.endArray();
+
+  json.beginArray("routes");
+  for (int i = 0; i < routesCount; i++) {
+    const route_stats_t &route = routeStats[i];
+    json.beginObject();
+    json.add("uri", route.uri);
+    json.add("method", methodName(route.method));
+    json.add("count", route.count);
+    json.add("total_us", (unsigned long long)route.total_us);
+    json.add("max_us", route.max_us);
+    json.beginArray("histogram");
+    for (int j = 0; j < ROUTE_HISTOGRAM_BUCKETS; j++) {
+      json.add((long long)route.histogram[j]);
+    }
+    json.endArray();
+    json.endObject();
+  }
+  json.endArray();
+
+  // Newest first
+  json.beginArray("slow");
+  for (int i = 1; i <= slowCount; i++) {
+    const slow_request_t &slow =
+        slowRequests[(slowNext + SLOW_REQUESTS_MAX - i) % SLOW_REQUESTS_MAX];
+    const route_stats_t &route = routeStats[slow.route];
+    json.beginObject();
+    json.add("uri", route.uri);
+    json.add("method", methodName(route.method));
+    json.add("duration_us", slow.duration_us);
+    json.add("heap_delta", (long)slow.heap_delta);
+    json.add("age_ms", now - slow.time);
+    json.endObject();
+  }
+  json.endArray();
+
+  // Newest first
+  hclock_jump_event_t jumps[TIME_JUMP_EVENTS_MAX];
+  size_t jumps_count =
+      HollowClock::getInstance().getJumpEvents(jumps, TIME_JUMP_EVENTS_MAX);
+  json.beginArray("time_jumps");
+  for (size_t i = 0; i < jumps_count; i++) {
+    json.beginObject();
+    json.add("time", jumps[i].time);
+    json.add("step_s", (long)jumps[i].step);
+    json.add("outcome", HollowClock::getJumpOutcomeName(jumps[i].outcome));
+    json.endObject();
+  }
+  json.endArray();
+
+  json.beginObject("system");
+  SystemMonitor::getInstance().writeJson(json);
+  json.endObject();
+  json.endObject();
+  sendJson(json);
+}
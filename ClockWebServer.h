@@ -1,8 +1,57 @@
 #ifndef WEBSRVR_H
 #define WEBSRVR_H
 
-#include <Preferences.h>
+#include "JsonWriter.h"
+#include "PreferencesManager.h"
 #include <WebServer.h>
+#include <atomic>
+
+#define SEND_CHUNK_SIZE 1024
+#define EVENT_CLIENTS_MAX 4
+#define EVENT_BUFFER_SIZE 256
+#define EVENT_POLL_INTERVAL 250        // ms
+#define EVENT_KEEPALIVE_INTERVAL 15000 // ms
+#define ROUTES_MAX 40
+#define ROUTE_INVALID 0xFF
+#define ROUTE_HISTOGRAM_BUCKETS 12     // <1ms, <2ms ... <1024ms, more
+#define SLOW_REQUESTS_MAX 8
+#define SLOW_REQUEST_THRESHOLD 100000  // us
+
+enum {
+  HTTP_COUNTER_GET,
+  HTTP_COUNTER_POST,
+  HTTP_COUNTER_OTHER,
+  HTTP_COUNTER_COUNT
+};
+
+typedef struct {
+  String uri;
+  HTTPMethod method;
+  uint32_t count;
+  uint64_t total_us;
+  uint32_t max_us;
+  uint32_t histogram[ROUTE_HISTOGRAM_BUCKETS];
+} route_stats_t;
+
+typedef struct {
+  uint8_t route;
+  uint32_t duration_us;
+  int32_t heap_delta;
+  unsigned long time; // millis() when finished
+} slow_request_t;
+
+typedef struct {
+  char data[SEND_CHUNK_SIZE];
+  size_t len;
+} metrics_buffer_t;
+
+typedef struct {
+  char local_time[64];
+  char hands_position[32];
+  bool positioning;
+  bool calibrated;
+  bool synced;
+} clock_state_t;
 
 class ClockWebServer {
 public:
@@ -10,14 +59,44 @@ public:
   void start();
   void handleClient();
   void send(int code, const char *content_type, const String &data);
+  // A whole number in min..max, no spaces or other text around it
+  static bool parseNumber(const String &text, int32_t min, int32_t max,
+                          int32_t &value);
 
 private:
-  ClockWebServer() : webServer(nullptr) {};
+  ClockWebServer()
+      : webServer(nullptr), jsonChunked(false), eventPolled(0), eventSent(0),
+        loopLast(0), loopTime(0), loopTimeMax(0), handleClientEnd(0),
+        loopOutsideTime(0), loopOutsideMax(0), routesCount(0), slowNext(0),
+        slowCount(0) {};
+  typedef void (ClockWebServer::*route_handler_t)(void);
   WebServer *webServer;
-  Preferences *prefs;
+  bool jsonChunked;
+  WiFiClient eventClients[EVENT_CLIENTS_MAX];
+  clock_state_t eventState;
+  unsigned long eventPolled;
+  unsigned long eventSent;
   String lastError = "";
+  unsigned long loopLast;
+  uint32_t loopTime;
+  uint32_t loopTimeMax;
+  unsigned long handleClientEnd;
+  uint32_t loopOutsideTime;
+  uint32_t loopOutsideMax;
+  route_stats_t routeStats[ROUTES_MAX];
+  uint8_t routesCount;
+  slow_request_t slowRequests[SLOW_REQUESTS_MAX];
+  uint8_t slowNext;
+  uint8_t slowCount;
+  std::atomic<uint32_t> httpRequests[HTTP_COUNTER_COUNT] = {};
 
   void setServerRouting();
+  void on(const String &uri, HTTPMethod method, route_handler_t handler);
+  void on(const String &uri, HTTPMethod method, route_handler_t handler,
+          route_handler_t upload);
+  void countRequest(HTTPMethod method);
+  uint8_t addRoute(const String &uri, HTTPMethod method);
+  void runRoute(uint8_t index, route_handler_t handler);
   void handleRoot();
   void handleStyles();
   void handleWifi();
@@ -33,11 +112,49 @@ private:
   void handleAdvancedPost();
   void handleCalibrationPost();
   void handlePositionGet();
+  void handleEventsGet();
   void handleApplyPost();
   void handleResetPost();
+  void handleUpdatePost();
+  void handleUpdateUpload();
+  void handleZonesGet();
+  void handleConfigGet();
+  void handleConfigPut();
+  void handleConfigPatch();
+  void handleMetricsGet();
+  void addNtpMetrics(metrics_buffer_t &buffer);
+  void addSystemMetrics(metrics_buffer_t &buffer);
+  void handleDiagnosticsGet();
+  void handleBootGet();
+  void handleLogGet();
+  void handleLogPost();
+  void handleNotFound();
+  void handleCaptiveProbe();
+  bool captivePortalRedirect();
   void handleError();
 
   void sendError(const String &message);
+  bool getNumberArg(const char *name, int32_t min, int32_t max,
+                    int32_t &value);
+  void sendZones(const String &prefix);
+  void sendZone(const String &name);
+  void sendChunked(const char *data, size_t len);
+  void sendJson(JsonWriter &json, int code = 200);
+  void sendJsonError(int code, const char *message,
+                     const char *field = nullptr);
+  void writeConfig(JsonWriter &json, const pref_settings_t &settings);
+  void updateConfig(bool replace);
+  void metricsPrintf(metrics_buffer_t &buffer, const char *format, ...);
+  void addMetric(metrics_buffer_t &buffer, const char *name, const char *type,
+                 const char *help, long long value);
+  static void jsonFlush(void *context, const char *data, size_t len);
+  bool checkETag(const String &etag);
+
+  void getClockState(clock_state_t &state);
+  void writeClockState(JsonWriter &json, const clock_state_t &state);
+  size_t formatEvent(char *buffer, size_t size);
+  void broadcastEvent(const char *data, size_t len);
+  void pushEvents();
 };
 
 #endif // WEBSRVR_H
@@ -0,0 +1,168 @@
+#include "FirmwareUpdate.h"
+#include "HollowClock.h"
+#include "Logger.h"
+#include "PreferencesManager.h"
+#include "config.h"
+#include <Update.h>
+#include <esp_ota_ops.h>
+
+#define TRACE(...) LOG_DEBUG(LOG_WEB, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_WEB, __VA_ARGS__)
+
+// Keep a new image pending, FirmwareUpdate::process() decides when it is good
+extern "C" bool verifyRollbackLater() { return true; }
+
+FirmwareUpdate &FirmwareUpdate::getInstance() {
+  static FirmwareUpdate instance;
+  return instance;
+}
+
+static bool parseHash(const char *hex, uint8_t *hash) {
+  if (strlen(hex) != OTA_SHA256_SIZE * 2) {
+    return false;
+  }
+  for (int i = 0; i < OTA_SHA256_SIZE * 2; i++) {
+    char c = hex[i];
+    uint8_t nibble;
+    if (c >= '0' && c <= '9') {
+      nibble = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      nibble = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      nibble = c - 'A' + 10;
+    } else {
+      return false;
+    }
+    hash[i / 2] = (i % 2) ? (hash[i / 2] | nibble) : (nibble << 4);
+  }
+  return true;
+}
+
+void FirmwareUpdate::fail(const char *message) {
+  ERROR("Firmware update failed: %s\n", message);
+  if (state == OTA_RUNNING) {
+    Update.abort();
+    mbedtls_sha256_free(&sha);
+  }
+  error = message;
+  state = OTA_FAILED;
+}
+
+ota_result_t FirmwareUpdate::begin(const char *sha256) {
+  if (state == OTA_RUNNING) {
+    abort();
+  }
+  error = nullptr;
+  written = 0;
+  // Anyone on the network can upload, the hash at least rules out a
+  // truncated or wrong file
+  if (sha256 == nullptr || *sha256 == '\0') {
+    state = OTA_FAILED;
+    error = "SHA-256 missing";
+    return OTA_ERROR;
+  }
+  if (!parseHash(sha256, expectedHash)) {
+    state = OTA_FAILED;
+    error = "Invalid SHA-256";
+    return OTA_ERROR;
+  }
+  // The size is not known in advance, Update erases the flash as it goes
+  if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
+    state = OTA_FAILED;
+    error = Update.errorString();
+    return OTA_ERROR;
+  }
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts(&sha, 0);
+  state = OTA_RUNNING;
+  TRACE("Firmware update started\n");
+  return OTA_OK;
+}
+
+ota_result_t FirmwareUpdate::write(uint8_t *data, size_t len) {
+  if (state != OTA_RUNNING) {
+    return OTA_ERROR;
+  }
+  mbedtls_sha256_update(&sha, data, len);
+  if (Update.write(data, len) != len) {
+    fail(Update.errorString());
+    return OTA_ERROR;
+  }
+  written += len;
+  return OTA_OK;
+}
+
+ota_result_t FirmwareUpdate::end(void) {
+  uint8_t hash[OTA_SHA256_SIZE];
+
+  if (state != OTA_RUNNING) {
+    return OTA_ERROR;
+  }
+  mbedtls_sha256_finish(&sha, hash);
+  if (memcmp(hash, expectedHash, sizeof(hash)) != 0) {
+    fail("SHA-256 mismatch");
+    return OTA_ERROR;
+  }
+  mbedtls_sha256_free(&sha);
+  // Verifies the image and selects it for the next boot
+  if (!Update.end(true)) {
+    state = OTA_FAILED;
+    error = Update.errorString();
+    ERROR("Firmware update failed: %s\n", error);
+    return OTA_ERROR;
+  }
+  state = OTA_DONE;
+  TRACE("Firmware update done, %u bytes\n", (unsigned)written);
+  return OTA_OK;
+}
+
+void FirmwareUpdate::abort(void) { fail("Upload aborted"); }
+
+ota_state_t FirmwareUpdate::getState(void) { return state; }
+
+const char *FirmwareUpdate::getError(void) { return error; }
+
+size_t FirmwareUpdate::getWritten(void) { return written; }
+
+// Read on first use, only process() changes it afterwards
+bool FirmwareUpdate::isPendingVerify(void) {
+  if (!stateRead) {
+    esp_ota_img_states_t ota_state;
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    pendingVerify =
+        esp_ota_get_state_partition(running, &ota_state) == ESP_OK &&
+        ota_state == ESP_OTA_IMG_PENDING_VERIFY;
+    stateRead = true;
+  }
+  return pendingVerify;
+}
+
+void FirmwareUpdate::process(void) {
+  if (!isPendingVerify() || millis() < OTA_HEALTHY_UPTIME) {
+    return;
+  }
+  if (HollowClock::getInstance().isAlive()) {
+    if (esp_ota_mark_app_valid_cancel_rollback() == ESP_OK) {
+      TRACE("Firmware confirmed\n");
+      pendingVerify = false;
+    }
+    return;
+  }
+  // A crash boots the previous image, a hung clock thread would keep the
+  // new one pending for good
+  if (millis() >= OTA_ROLLBACK_UPTIME) {
+    ERROR("Firmware not healthy, rolling back\n");
+    HollowClock &hclock = HollowClock::getInstance();
+    if (hclock.isCalibrated()) {
+      hclock.saveClockPosition();
+    }
+    PreferencesManager::getInstance().commit();
+    // Only returns if there is no image to go back to
+    esp_ota_mark_app_invalid_rollback_and_reboot();
+    pendingVerify = false;
+  }
+}
+
+FirmwareUpdate::FirmwareUpdate()
+    : state(OTA_IDLE), error(nullptr), written(0), stateRead(false),
+      pendingVerify(false) {}
@@ -0,0 +1,65 @@
+#ifndef _FIRMWARE_UPDATE_H_
+#define _FIRMWARE_UPDATE_H_
+
+#include <Arduino.h>
+#include <mbedtls/sha256.h>
+
+#define OTA_HEALTHY_UPTIME 60000 // ms, a new image is confirmed after that
+#define OTA_ROLLBACK_UPTIME (OTA_HEALTHY_UPTIME * 5) // ms, rolled back after
+#define OTA_SHA256_SIZE 32
+
+typedef enum {
+  OTA_OK = 0,
+  OTA_ERROR = -1,
+} ota_result_t;
+
+typedef enum {
+  OTA_IDLE,
+  OTA_RUNNING,
+  OTA_DONE,
+  OTA_FAILED,
+} ota_state_t;
+
+// Streams a firmware image into the inactive app partition as it is
+// received. The new image boots pending verification and is confirmed by
+// process() once the clock runs fine. If the image crashes the bootloader
+// goes back to the previous one, if the clock does not run by
+// OTA_ROLLBACK_UPTIME process() does.
+class FirmwareUpdate {
+
+public:
+  static FirmwareUpdate &getInstance();
+  FirmwareUpdate(const FirmwareUpdate &) = delete;
+  FirmwareUpdate &operator=(const FirmwareUpdate &) = delete;
+
+  // 'sha256' is the expected image hash in hex, an update without it fails
+  ota_result_t begin(const char *sha256);
+  ota_result_t write(uint8_t *data, size_t len);
+  ota_result_t end(void);
+  void abort(void);
+
+  ota_state_t getState(void);
+  const char *getError(void);
+  size_t getWritten(void);
+
+  // Confirms a new image once healthy or rolls it back, call it
+  // periodically
+  void process(void);
+  bool isPendingVerify(void);
+
+private:
+  FirmwareUpdate();
+  ~FirmwareUpdate() = default;
+
+  void fail(const char *message);
+
+  ota_state_t state;
+  const char *error;
+  size_t written;
+  uint8_t expectedHash[OTA_SHA256_SIZE];
+  mbedtls_sha256_context sha;
+  bool stateRead;
+  bool pendingVerify;
+};
+
+#endif
@@ -1,24 +1,46 @@
 #include "HollowClock.h"
+#include "BootProfiler.h"
+#include "Logger.h"
 #include "MotorControl.h"
 #include "PreferencesManager.h"
+#include "SntpClient.h"
 #include "SoundPlayer.h"
+#include "SystemMonitor.h"
+#include "TimeZone.h"
 #include "config.h"
-#include "esp_sntp.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include <sys/time.h>
 #include <thread>
 #include <time.h>
 
-#if DEBUG_HOLLOW_CLOCK
-#define TRACE(...) Serial.printf(__VA_ARGS__)
-#define ERROR(...) Serial.printf(__VA_ARGS__)
-#else
-#define TRACE(...)
-#define ERROR(...)
-#endif
+#define TRACE(...) LOG_DEBUG(LOG_CLOCK, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_CLOCK, __VA_ARGS__)
 
 #if USE_DEEP_SLEEP_WAKEUP_FOR_CLOCK
 RTC_DATA_ATTR uint32_t unresettable_var;
 #endif
 
+#define RTC_TIME_MAGIC 0x48433554
+#define TIME_VALID_AFTER 1577836800 // 2020-01-01, earlier means never set
+
+// Wall clock kept across soft resets, so the hands move before NTP is up
+typedef struct {
+  uint32_t magic;
+  int64_t time_us;
+  uint32_t check;
+} rtc_time_t;
+
+RTC_NOINIT_ATTR static rtc_time_t rtc_time;
+
+// Not on the heap, where a long uptime fragments it
+static StackType_t clock_stack[CLOCK_TASK_STACK_SIZE];
+static StaticTask_t clock_task_buffer;
+
+static uint32_t rtcTimeCheck(const rtc_time_t &t) {
+  return t.magic ^ (uint32_t)t.time_us ^ (uint32_t)(t.time_us >> 32);
+}
+
 enum {
   CMD_START = 1,          // start movement
   CMD_STOP = 2,           // stop movement
@@ -41,40 +63,39 @@ void HollowClock::adjustClockPosition(int steps) {
   }
 }
 // 10:35 - 0:27
-int HollowClock::calculateTimeDiff(int local_clock_position, int current_time,
+int HollowClock::calculateTimeDiff(int hands_position, int current_time,
+                                   int dial_steps, bool allow_backward,
                                    bool &direction_forward) {
   int time_diff = 0;
 
   direction_forward = true;
-  if (allow_backward_movement) {
-    if (local_clock_position > current_time) {
-      current_time += max_clock_position;
+  if (allow_backward) {
+    if (hands_position > current_time) {
+      current_time += dial_steps;
     }
-    if ((current_time - local_clock_position) > max_clock_position / 2) {
+    if ((current_time - hands_position) > dial_steps / 2) {
       direction_forward = false;
-      time_diff = abs(max_clock_position - current_time + local_clock_position);
+      time_diff = abs(dial_steps - current_time + hands_position);
     } else {
-      time_diff = abs(current_time - local_clock_position);
+      time_diff = abs(current_time - hands_position);
     }
     TRACE("Time diff: %d %d (%d)-> time_diff: %s%d\n",
-          current_time - (direction_forward ? max_clock_position : 0) -
-              local_clock_position,
-          current_time - local_clock_position, max_clock_position / 2,
+          current_time - (direction_forward ? dial_steps : 0) -
+              hands_position,
+          current_time - hands_position, dial_steps / 2,
           direction_forward ? "" : "-", time_diff);
   } else {
-    time_diff = (current_time + max_clock_position - local_clock_position) %
-                max_clock_position;
-    TRACE("Time diff: %d %d\n", local_clock_position - current_time,
-          (current_time - local_clock_position + max_clock_position) %
-              max_clock_position);
+    time_diff = (current_time + dial_steps - hands_position) % dial_steps;
+    TRACE("Time diff: %d %d\n", hands_position - current_time,
+          (current_time - hands_position + dial_steps) % dial_steps);
   }
   return time_diff;
 }
 
 void HollowClock::playChime(int current_time) {
   static int last_played_chime = -1;
-  uint32_t hours = current_time / (60 * steps_per_minute);
-  uint32_t minutes = current_time / steps_per_minute;
+  int hours = current_time / (60 * steps_per_minute);
+  int minutes = current_time / steps_per_minute;
   if (play_chime) {
     // Play chime
     if (last_played_chime != hours && (minutes % 60 == 0)) {
@@ -95,11 +116,20 @@ void HollowClock::setAllowBackwardMovement(bool allow) {
   allow_backward_movement = allow;
 }
 
+void HollowClock::taskFunction(void *arg) {
+  ((HollowClock *)arg)->threadFunction();
+}
+
 void HollowClock::threadFunction(void) {
   bool clock_moving = true;
+  uint32_t wait;
+  bool positioning_run = false; // a fast move may take several rounds
   MotorControl &motor = MotorControl::getInstance();
   while (true) {
     struct tm timeinfo;
+    heartbeat = millis();
+    storeTime();
+    wait = CLOCK_ROUND_TIME;
 
     // Check for any new command
     uint32_t value;
@@ -149,11 +179,19 @@ void HollowClock::threadFunction(void) {
     }
 
     if (clock_moving) {
-      if (!::getLocalTime(&timeinfo)) {
+      int64_t now_ms = currentTimeMs();
+      if (now_ms < TIME_VALID_AFTER * 1000LL) {
         TRACE("Failed to obtain time\n");
         delay(5000);
         continue;
       }
+      BootProfiler::getInstance().mark(BOOT_PHASE_TIME_VALID);
+      detectTimeJump(now_ms);
+
+      // The hands show the minute in which a tick started now would end
+      uint32_t tick_ms = motor.getRotateTime(steps_per_minute, delay_time);
+      time_t tick_end = (now_ms + tick_ms) / 1000;
+      TimeZone::getInstance().localTime(tick_end, timeinfo);
 
       int hour = timeinfo.tm_hour % 12;
       int minute = timeinfo.tm_min;
@@ -166,44 +204,219 @@ void HollowClock::threadFunction(void) {
         delay(60000 / 16);
       } else {
         uint32_t local_clock_position = (uint32_t)clock_position;
-        if (current_time != local_clock_position) {
-          bool direction_forward = true;
-          int time_diff = calculateTimeDiff(local_clock_position, current_time,
-                                            direction_forward);
-          if (time_diff > steps_per_minute) {
-            positioning = true;
-            TRACE("Positioning: current time: %d, Clock position: %d - "
-                  "%stime_diff(sec):%d\n",
-                  current_time, local_clock_position,
-                  direction_forward ? "" : "-",
-                  time_diff * 60 / steps_per_minute);
-
-            time_diff = (time_diff > MAX_FAST_MOVMENT_STEPS)
-                            ? MAX_FAST_MOVMENT_STEPS
-                            : time_diff;
-            if (time_diff <= MAX_FAST_MOVMENT_STEPS) {
-              saveClockPosition();
-            }
-            motor.rotate(direction_forward ? time_diff : -time_diff, -1,
-                         flip_rotation); // move fast to the current position
-            adjustClockPosition(direction_forward ? time_diff : -time_diff);
-            positioning = false;
-            delay(10);
-            continue;
-          } else {
-            TRACE("Current position: %d, Clock position: %d - "
-                  "time_diff(sec):%d\n",
-                  current_time, local_clock_position,
-                  time_diff * 60 / steps_per_minute);
-            motor.rotate(time_diff, delay_time, flip_rotation);
-            playChime(current_time);
-            adjustClockPosition(time_diff);
+        bool direction_forward = true;
+        int time_diff = 0;
+        if (current_time != (int)local_clock_position) {
+          time_diff = calculateTimeDiff(local_clock_position, current_time,
+                                        max_clock_position,
+                                        allow_backward_movement,
+                                        direction_forward);
+        }
+        if (!followTime(local_clock_position, current_time)) {
+          // The hands wait for the time or for a second NTP update
+          positioning_run = false;
+        } else if (time_diff > (int)steps_per_minute) {
+          if (!positioning_run) {
+            positioning_events++;
+            positioning_run = true;
+          }
+          positioning = true;
+          TRACE("Positioning: current time: %d, Clock position: %d - "
+                "%stime_diff(sec):%d\n",
+                current_time, local_clock_position,
+                direction_forward ? "" : "-",
+                time_diff * 60 / steps_per_minute);
+
+          // Saved once the hands arrive, not after every chunk
+          bool last_chunk = time_diff <= MAX_FAST_MOVMENT_STEPS;
+          time_diff = last_chunk ? time_diff : MAX_FAST_MOVMENT_STEPS;
+          motor.rotate(direction_forward ? time_diff : -time_diff, -1,
+                       flip_rotation); // move fast to the current position
+          adjustClockPosition(direction_forward ? time_diff : -time_diff);
+          if (last_chunk) {
+            saveClockPosition();
           }
+          positioning = false;
+          delay(10);
+          continue;
+        } else if (time_diff > 0) {
+          positioning_run = false;
+          BootProfiler::getInstance().mark(BOOT_PHASE_HANDS);
+          TRACE("Current position: %d, Clock position: %d - "
+                "time_diff(sec):%d\n",
+                current_time, local_clock_position,
+                time_diff * 60 / steps_per_minute);
+          motor.rotate(time_diff, delay_time, flip_rotation);
+          recordTickLateness(currentTimeMs());
+          playChime(current_time);
+          adjustClockPosition(time_diff);
+        } else {
+          positioning_run = false;
+          BootProfiler::getInstance().mark(BOOT_PHASE_HANDS);
         }
+        // Wake up exactly when the next tick has to start
+        int64_t next_start =
+            ((currentTimeMs() + tick_ms) / 60000 + 1) * 60000 - tick_ms;
+        int64_t until = next_start - currentTimeMs();
+        wait = (until < CLOCK_ROUND_TIME) ? (until > 0 ? until : 0)
+                                          : CLOCK_ROUND_TIME;
       }
     }
-    delay(1000);
+    waitForCommand(wait);
+  }
+}
+
+int64_t HollowClock::currentTimeMs(void) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return (int64_t)now.tv_sec * 1000 + now.tv_usec / 1000;
+}
+
+// Sleeps up to timeout ms, a new command ends the wait early
+void HollowClock::waitForCommand(uint32_t timeout) {
+  std::unique_lock<std::mutex> lock(threadMutex);
+  queueCondition.wait_for(lock, std::chrono::milliseconds(timeout),
+                          [this] { return !commandQueue.empty(); });
+}
+
+// A tick should end on the minute, positive lateness means it ended after
+void HollowClock::recordTickLateness(int64_t end_ms) {
+  int32_t lateness = end_ms - (end_ms + 30000) / 60000 * 60000;
+  std::lock_guard<std::mutex> lock(syncMutex);
+  if (tick_stats.ticks == 0 || lateness < tick_stats.min) {
+    tick_stats.min = lateness;
+  }
+  if (tick_stats.ticks == 0 || lateness > tick_stats.max) {
+    tick_stats.max = lateness;
+  }
+  tick_stats.last = lateness;
+  tick_stats.sum += lateness;
+  tick_stats.ticks++;
+}
+
+// A step of the wall clock against the uptime, or the first time of a boot
+// that was not kept over the reset
+void HollowClock::detectTimeJump(int64_t now_ms) {
+  int64_t uptime_ms = esp_timer_get_time() / 1000;
+  int64_t step_ms = (now_ms - last_time_ms) - (uptime_ms - last_uptime_ms);
+  bool first = last_time_ms == 0;
+  last_time_ms = now_ms;
+  last_uptime_ms = uptime_ms;
+  if (first ? time_restored
+            : llabs(step_ms) < TIME_JUMP_MINUTES * 60000LL) {
+    return;
+  }
+  // A jump before the hands followed the last one adds to it
+  if (!jump_pending) {
+    jump_pending = true;
+    jump_recorded = false;
+    jump_step_ms = 0;
+  }
+  if (!first) {
+    jump_step_ms += step_ms;
   }
+  jump_start = millis();
+  jump_syncs = ntp_syncs;
+  TRACE("Time jump: %lld ms\n", (long long)jump_step_ms);
+}
+
+// Returns false while the hands wait for a second NTP update or for the
+// time to reach them
+bool HollowClock::followTime(uint32_t hands_position, uint32_t current_time) {
+  uint32_t ahead =
+      (hands_position + max_clock_position - current_time) % max_clock_position;
+  uint32_t behind =
+      (current_time + max_clock_position - hands_position) % max_clock_position;
+
+  uint32_t off = (ahead < behind) ? ahead : behind;
+
+  if (jump_pending) {
+    if (off <= TIME_JUMP_MINUTES * steps_per_minute) {
+      // Nothing to travel, or the time came back before the hands moved
+      if (jump_recorded) {
+        resolveJump(JUMP_CANCELLED);
+      }
+      jump_pending = false;
+    } else {
+      if (!jump_recorded) {
+        recordJump();
+        if (jump_policy == JUMP_POLICY_CONFIRM) {
+          SntpClient::getInstance().requestSync();
+        }
+      }
+      // The update that made the jump has a large offset, a second one
+      // that agrees has a small one
+      if (jump_policy != JUMP_POLICY_CONFIRM) {
+        resolveJump(JUMP_FOLLOWED);
+      } else if (ntp_syncs != jump_syncs &&
+                 ntp_offset > -TIME_JUMP_MINUTES * 60000 &&
+                 ntp_offset < TIME_JUMP_MINUTES * 60000) {
+        resolveJump(JUMP_CONFIRMED);
+      } else if (millis() - jump_start >= TIME_JUMP_CONFIRM_TIMEOUT) {
+        resolveJump(JUMP_TIMED_OUT);
+      } else {
+        return false;
+      }
+      jump_pending = false;
+    }
+  }
+
+  // Going forward round the dial takes longer than waiting for the time
+  if (jump_policy != JUMP_POLICY_IMMEDIATE && !allow_backward_movement &&
+      ahead > 0 && ahead <= TIME_JUMP_HOLD_MAX * steps_per_minute) {
+    if (!holding) {
+      std::lock_guard<std::mutex> lock(syncMutex);
+      hold_count++;
+      holding = true;
+    }
+    return false;
+  }
+  holding = false;
+  return true;
+}
+
+void HollowClock::recordJump(void) {
+  std::lock_guard<std::mutex> lock(syncMutex);
+  hclock_jump_event_t &event = jump_events[jump_next];
+  event.time = time(nullptr);
+  event.step = jump_step_ms / 1000;
+  event.outcome = JUMP_PENDING;
+  jump_next = (jump_next + 1) % TIME_JUMP_EVENTS_MAX;
+  if (jump_count < TIME_JUMP_EVENTS_MAX) {
+    jump_count++;
+  }
+  jump_counts[JUMP_PENDING]++;
+  jump_recorded = true;
+}
+
+// Only one jump is pending at a time, it is the newest event
+void HollowClock::resolveJump(hclock_jump_outcome_t outcome) {
+  std::lock_guard<std::mutex> lock(syncMutex);
+  hclock_jump_event_t &event =
+      jump_events[(jump_next + TIME_JUMP_EVENTS_MAX - 1) %
+                  TIME_JUMP_EVENTS_MAX];
+  event.step = jump_step_ms / 1000;
+  event.outcome = outcome;
+  jump_counts[JUMP_PENDING]--;
+  jump_counts[outcome]++;
+  TRACE("Time jump %s\n", getJumpOutcomeName(outcome));
+}
+
+size_t HollowClock::getJumpEvents(hclock_jump_event_t *events, size_t max) {
+  std::lock_guard<std::mutex> lock(syncMutex);
+  size_t count = 0;
+  for (; count < jump_count && count < max; count++) {
+    events[count] = jump_events[(jump_next + TIME_JUMP_EVENTS_MAX - 1 -
+                                 count) %
+                                TIME_JUMP_EVENTS_MAX];
+  }
+  return count;
+}
+
+const char *HollowClock::getJumpOutcomeName(hclock_jump_outcome_t outcome) {
+  static const char *const names[JUMP_OUTCOME_COUNT] = {
+      "pending", "followed", "confirmed", "timed_out", "cancelled"};
+  return outcome < JUMP_OUTCOME_COUNT ? names[outcome] : "unknown";
 }
 
 bool HollowClock::isCalibrated(void) {
@@ -236,52 +449,131 @@ hclock_result_t HollowClock::moveStop(void) {
 }
 
 hclock_result_t HollowClock::moveSteps(int steps) {
+  if (steps < -max_clock_position || steps > max_clock_position) {
+    ERROR("Invalid number of steps: %d\n", steps);
+    return HCLOCK_ERROR;
+  }
   int value = makeCommand(CMD_STEP, steps);
   return addToQueue(value) ? HCLOCK_OK : HCLOCK_ERROR;
 }
 
 hclock_result_t HollowClock::updateClockPosition(uint8_t hours,
                                                  uint8_t minutes) {
+  if (hours >= 12 || minutes >= 60) {
+    ERROR("Invalid position: %u:%02u\n", hours, minutes);
+    return HCLOCK_ERROR;
+  }
   int value = makeCommand(CMD_UPDATE_POSITION, hours, minutes);
   return addToQueue(value) ? HCLOCK_OK : HCLOCK_ERROR;
 }
 
-String HollowClock::getLocalTime(void) {
+bool HollowClock::getLocalTime(char *buffer, size_t size) {
   struct tm timeinfo;
-  if (!::getLocalTime(&timeinfo)) {
-    return "Failed to obtain time";
+  // Do not wait for the time to be set, this is called by the web server
+  time_t now = time(nullptr);
+  if (now < TIME_VALID_AFTER) {
+    snprintf(buffer, size, "Failed to obtain time");
+    return false;
   }
-  char time_str[6];
-  strftime(time_str, sizeof(time_str), "%I:%M", &timeinfo);
-  return String(time_str);
+  TimeZone::getInstance().localTime(now, timeinfo);
+  strftime(buffer, size, "%I:%M", &timeinfo);
+  return true;
 }
 
-void HollowClock::setLastSyncedTime(String time) { last_synced_time = time; }
+void HollowClock::setLastSyncedTime(const char *time) {
+  std::lock_guard<std::mutex> lock(syncMutex);
+  snprintf(last_synced_time, sizeof(last_synced_time), "%s", time);
+}
 
-String HollowClock::getLastSyncedTime(void) {
-  TRACE("Sync status:%d\n", sntp_get_sync_status());
-  return last_synced_time;
+void HollowClock::getLastSyncedTime(char *buffer, size_t size) {
+  std::lock_guard<std::mutex> lock(syncMutex);
+  snprintf(buffer, size, "%s", last_synced_time);
 }
 
-String HollowClock::getHandsPosition(void) {
+bool HollowClock::getHandsPosition(char *buffer, size_t size) {
   uint8_t hours, minutes;
 
   if (getClockPosition(hours, minutes) != HCLOCK_OK) {
-    return "Unknown - please set hands";
+    snprintf(buffer, size, "Unknown - please set hands");
+    return false;
   }
 
-  getClockPosition(hours, minutes);
-  char time_str[6];
   if (hours == 0) {
     hours = 12;
   }
-  snprintf(time_str, sizeof(time_str), "%2d:%02d", hours, minutes);
-  return String(time_str);
+  snprintf(buffer, size, "%2d:%02d", hours, minutes);
+  return true;
+}
+
+void HollowClock::notifyTimeSync(int32_t offset_ms) {
+  ntp_syncs++;
+  ntp_offset = offset_ms;
+}
+
+void HollowClock::getStats(hclock_stats_t &stats) {
+  {
+    std::lock_guard<std::mutex> lock(syncMutex);
+    stats.ticks = tick_stats;
+    memcpy(stats.jumps, jump_counts, sizeof(stats.jumps));
+    stats.holds = hold_count;
+  }
+  stats.positioning_events = positioning_events;
+  stats.queue_drops = queue_drops;
+  stats.ntp_syncs = ntp_syncs;
+  stats.ntp_offset = ntp_offset;
+  stats.stack_free = (clockTask != nullptr)
+                         ? uxTaskGetStackHighWaterMark(clockTask)
+                         : 0;
+}
+
+void HollowClock::storeTime(void) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  if (now.tv_sec < TIME_VALID_AFTER) {
+    return;
+  }
+  rtc_time.magic = RTC_TIME_MAGIC;
+  rtc_time.time_us = (int64_t)now.tv_sec * 1000000 + now.tv_usec;
+  rtc_time.check = rtcTimeCheck(rtc_time);
+}
+
+// Sets the system time from RTC memory after a soft reset. The time spent
+// in the reset is estimated, NTP corrects what is left.
+bool HollowClock::restoreTime(void) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  if (now.tv_sec >= TIME_VALID_AFTER) {
+    return true; // kept by the system
+  }
+  esp_reset_reason_t reason = esp_reset_reason();
+  if (reason == ESP_RST_POWERON || reason == ESP_RST_BROWNOUT ||
+      rtc_time.magic != RTC_TIME_MAGIC ||
+      rtc_time.check != rtcTimeCheck(rtc_time)) {
+    return false;
+  }
+  int64_t time_us = rtc_time.time_us + esp_timer_get_time() +
+                    RTC_RESET_TIME * 1000LL;
+  now.tv_sec = time_us / 1000000;
+  now.tv_usec = time_us % 1000000;
+  settimeofday(&now, NULL);
+  TRACE("Time restored from RTC memory\n");
+  return true;
+}
+
+bool HollowClock::isAlive(void) {
+  return started && (millis() - heartbeat < CLOCK_ALIVE_TIMEOUT);
 }
 
 void HollowClock::start(void) {
-  clockThread = std::thread(std::bind(&HollowClock::threadFunction, this));
-  clockThread.detach();
+  time_restored = restoreTime();
+  // Also catches ESP.restart(), the time saved each round may be a
+  // second old
+  esp_register_shutdown_handler(storeTime);
+  clockTask = xTaskCreateStatic(taskFunction, "clock", CLOCK_TASK_STACK_SIZE,
+                                this, CLOCK_TASK_PRIORITY, clock_stack,
+                                &clock_task_buffer);
+  SystemMonitor::getInstance().addTask("clock", clockTask,
+                                       CLOCK_TASK_STACK_SIZE);
   started = true;
 }
 
@@ -295,6 +587,8 @@ bool HollowClock::addToQueue(uint32_t value) {
     commandQueue.push(value);
     queueCondition.notify_one();
     result = true;
+  } else {
+    queue_drops++;
   }
   return result;
 }
@@ -317,7 +611,9 @@ uint32_t HollowClock::makeCommand(uint8_t cmd, uint8_t val1, uint8_t val2) {
 
 uint32_t HollowClock::makeCommand(uint8_t cmd, int val) {
   int sign = (val < 0) ? 1 : 0;
-  val = abs(val);
+  // Saturate, masking a larger value would move by something else
+  val = (val < -CMD_VALUE_MAX || val > CMD_VALUE_MAX) ? CMD_VALUE_MAX
+                                                       : abs(val);
   return (cmd << 24) | (sign << 23) | (val & 0x7FFFFF);
 }
 
@@ -329,20 +625,29 @@ void HollowClock::getParams(uint32_t value, uint8_t &par1, uint8_t &par2) {
 }
 
 void HollowClock::getParams(uint32_t value, int &par) {
-  par = (value & 0x7FFFFF) * ((value >> 23) & 0x1 ? -1 : 1);
+  par = (value & CMD_VALUE_MAX) * ((value >> 23) & 0x1 ? -1 : 1);
 }
 
-HollowClock::HollowClock() : started(false), positioning(false) {
+HollowClock::HollowClock()
+    : jump_next(0), jump_count(0), hold_count(0), started(false),
+      positioning(false), time_restored(false), last_time_ms(0),
+      last_uptime_ms(0), jump_pending(false), jump_recorded(false),
+      holding(false), jump_step_ms(0), jump_start(0), jump_syncs(0),
+      clockTask(nullptr) {
   PreferencesManager &pm = PreferencesManager::getInstance();
 
+  memset(&tick_stats, 0, sizeof(tick_stats));
+  memset(jump_events, 0, sizeof(jump_events));
+  memset(jump_counts, 0, sizeof(jump_counts));
   flip_rotation = pm.getFlipRotation();
   allow_backward_movement = pm.getAllowBackward();
+  jump_policy = pm.getJumpPolicy();
   play_chime = pm.getChime();
   steps_per_minute = pm.getStepsPerMinute();
   delay_time = pm.getDelayTime();
   clock_position = pm.getClockPosition();
   max_clock_position = 12 * 60 * steps_per_minute;
-  last_synced_time = "never!";
+  setLastSyncedTime("never!");
 
 // Test
 #if USE_DEEP_SLEEP_WAKEUP_FOR_CLOCK
@@ -6,13 +6,65 @@
 #include <condition_variable>
 #include <mutex>
 #include <queue>
-#include <thread>
+
+#define CLOCK_ALIVE_TIMEOUT 30000 // ms, longest round of the clock thread
+#define CLOCK_ROUND_TIME 1000     // ms, longest sleep of the clock thread
+#define RTC_RESET_TIME 300        // ms, reset and bootloader before app start
+#define TIME_JUMP_MINUTES 5       // larger steps of the time are jumps
+#define TIME_JUMP_HOLD_MAX 90     // minutes the hands may wait for the time
+#define TIME_JUMP_CONFIRM_TIMEOUT 600000 // ms, move without a second update
+#define TIME_JUMP_EVENTS_MAX 4
+#define STEPS_PER_MINUTE_MAX 1024 // a dial of them fits a command's 23 bits
+#define CMD_VALUE_MAX 0x7FFFFF    // largest step count a command carries
+
+// What the hands do when the time jumps or they are far off
+typedef enum {
+  JUMP_POLICY_IMMEDIATE = 0, // move right away
+  JUMP_POLICY_SHORTEST,      // hands a bit ahead wait instead of going round
+  JUMP_POLICY_CONFIRM,       // shortest, after a second NTP update agrees
+  JUMP_POLICY_COUNT
+} hclock_jump_policy_t;
+
+typedef enum {
+  JUMP_PENDING = 0, // waiting for a second NTP update
+  JUMP_FOLLOWED,    // the hands moved without waiting for one
+  JUMP_CONFIRMED,   // a second update agreed, the hands moved
+  JUMP_TIMED_OUT,   // no second update in time, the hands moved anyway
+  JUMP_CANCELLED,   // the time came back before the hands moved
+  JUMP_OUTCOME_COUNT
+} hclock_jump_outcome_t;
 
 typedef enum {
   HCLOCK_OK = 0,
   HCLOCK_ERROR = -1,
 } hclock_result_t;
 
+// Lateness of the minute ticks in ms, negative if they ended early
+typedef struct {
+  uint32_t ticks;
+  int32_t last;
+  int32_t min;
+  int32_t max;
+  int64_t sum;
+} hclock_tick_stats_t;
+
+typedef struct {
+  uint32_t time; // s since epoch when the hands first had to follow it
+  int32_t step;  // s the time jumped, 0 for the first time after boot
+  hclock_jump_outcome_t outcome;
+} hclock_jump_event_t;
+
+typedef struct {
+  hclock_tick_stats_t ticks;
+  uint32_t jumps[JUMP_OUTCOME_COUNT]; // pending ones leave it once resolved
+  uint32_t holds; // hands waited for the time instead of going round
+  uint32_t positioning_events;
+  uint32_t queue_drops;
+  uint32_t ntp_syncs;
+  int32_t ntp_offset;  // ms, last correction applied by NTP
+  uint32_t stack_free; // clock thread stack high-water mark
+} hclock_stats_t;
+
 class HollowClock {
 
 public:
@@ -26,49 +78,99 @@ public:
   bool isCalibrated(void);
   bool isPositioning(void);
   hclock_result_t getClockPosition(uint8_t &hours, uint8_t &minutes);
-  String getLocalTime(void);
-  String getLastSyncedTime(void);
-  void setLastSyncedTime(String time);
-  String getHandsPosition(void);
+  bool getLocalTime(char *buffer, size_t size);
+  void getLastSyncedTime(char *buffer, size_t size);
+  void setLastSyncedTime(const char *time);
+  bool getHandsPosition(char *buffer, size_t size);
+  void notifyTimeSync(int32_t offset_ms);
+  void getStats(hclock_stats_t &stats);
+  // Copies the last jumps, newest first, returns their number
+  size_t getJumpEvents(hclock_jump_event_t *events, size_t max);
+  static const char *getJumpOutcomeName(hclock_jump_outcome_t outcome);
+  // True while the clock thread keeps running its loop
+  bool isAlive(void);
+  // Keeps the current time in RTC memory for the next soft reset
+  static void storeTime(void);
 
   hclock_result_t moveStart(void);
   hclock_result_t moveStop(void);
+  // Rejects moves of more than a turn of the dial
   hclock_result_t moveSteps(int steps);
+  int getDialSteps(void) { return max_clock_position; }
   hclock_result_t updateClockPosition(uint8_t hours, uint8_t minutes);
 
   void start(void);
 
+  // Steps and direction from the hands to the time on a dial of that
+  // many steps, the short way round if backward is allowed
+  static int calculateTimeDiff(int hands_position, int current_time,
+                               int dial_steps, bool allow_backward,
+                               bool &direction_forward);
+  // Commands for the clock thread, the value is saturated to
+  // CMD_VALUE_MAX
+  static uint32_t makeCommand(uint8_t cmd, uint8_t val1, uint8_t val2);
+  static uint32_t makeCommand(uint8_t cmd, int val);
+  static uint8_t getCommand(uint32_t value);
+  static void getParams(uint32_t value, uint8_t &par1, uint8_t &par2);
+  static void getParams(uint32_t value, int &par);
+
 private:
   HollowClock();
   ~HollowClock() = default;
 
+  bool restoreTime(void);
+  static int64_t currentTimeMs(void);
+  void waitForCommand(uint32_t timeout);
+  void recordTickLateness(int64_t end_ms);
+  void detectTimeJump(int64_t now_ms);
+  bool followTime(uint32_t hands_position, uint32_t current_time);
+  void recordJump(void);
+  void resolveJump(hclock_jump_outcome_t outcome);
   void adjustClockPosition(int steps);
-  int calculateTimeDiff(int local_clock_position, int current_position,
-                        bool &direction_forward);
   void playChime(int current_time);
 
-  uint32_t makeCommand(uint8_t cmd, uint8_t val1, uint8_t val2);
-  uint32_t makeCommand(uint8_t cmd, int val);
   bool addToQueue(uint32_t value);
-
-  uint8_t getCommand(uint32_t value);
-  void getParams(uint32_t value, uint8_t &par1, uint8_t &par2);
-  void getParams(uint32_t value, int &par);
   bool getFromQueue(uint32_t &value);
 
-  String last_synced_time;
+  char last_synced_time[8];
+  hclock_tick_stats_t tick_stats;
+  hclock_jump_event_t jump_events[TIME_JUMP_EVENTS_MAX];
+  uint8_t jump_next;
+  uint8_t jump_count;
+  uint32_t jump_counts[JUMP_OUTCOME_COUNT];
+  uint32_t hold_count;
+  std::mutex syncMutex;
   bool flip_rotation;
   bool allow_backward_movement;
+  uint8_t jump_policy;
   bool play_chime;
   bool started;
   bool positioning;
+  bool time_restored;
+
+  // Used by the clock thread only
+  int64_t last_time_ms;   // wall clock of the last round, 0 before the first
+  int64_t last_uptime_ms;
+  bool jump_pending;      // the time jumped, the hands have not followed yet
+  bool jump_recorded;     // the pending jump has an event
+  bool holding;
+  int64_t jump_step_ms;
+  unsigned long jump_start;
+  uint32_t jump_syncs;    // NTP updates when the jump was seen
   uint32_t steps_per_minute;
   uint8_t delay_time;
   std::atomic<uint32_t> clock_position;
   int max_clock_position;
 
+  std::atomic<uint32_t> positioning_events{0};
+  std::atomic<uint32_t> queue_drops{0};
+  std::atomic<uint32_t> ntp_syncs{0};
+  std::atomic<int32_t> ntp_offset{0};
+  TaskHandle_t clockTask;
+  std::atomic<unsigned long> heartbeat{0};
+
+  static void taskFunction(void *arg);
   void threadFunction(void);
-  std::thread clockThread;
 
   static const int QUEUE_SIZE = 3;
   std::queue<uint32_t> commandQueue;
@@ -0,0 +1,258 @@
+#include "JsonReader.h"
+#include <errno.h>
+
+JsonReader::JsonReader(const char *json, size_t len)
+    : json(json), len(len), pos(0), error(nullptr), started(false),
+      finished(false) {}
+
+bool JsonReader::fail(const char *message) {
+  if (error == nullptr) {
+    error = message;
+  }
+  finished = true;
+  return false;
+}
+
+void JsonReader::skipSpaces(void) {
+  while (pos < len && (json[pos] == ' ' || json[pos] == '\t' ||
+                       json[pos] == '\n' || json[pos] == '\r')) {
+    pos++;
+  }
+}
+
+bool JsonReader::expect(char c) {
+  skipSpaces();
+  if (pos < len && json[pos] == c) {
+    pos++;
+    return true;
+  }
+  return false;
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+bool JsonReader::parseString(String &str) {
+  str = "";
+  if (!expect('"')) {
+    return fail("String expected");
+  }
+  while (pos < len) {
+    char c = json[pos++];
+    if (c == '"') {
+      return true;
+    }
+    if ((uint8_t)c < 0x20) {
+      return fail("Control character in string");
+    }
+    if (c != '\\') {
+      str += c;
+      continue;
+    }
+    if (pos >= len) {
+      break;
+    }
+    c = json[pos++];
+    switch (c) {
+    case '"':
+    case '\\':
+    case '/':
+      str += c;
+      break;
+    case 'n':
+      str += '\n';
+      break;
+    case 'r':
+      str += '\r';
+      break;
+    case 't':
+      str += '\t';
+      break;
+    case 'b':
+      str += '\b';
+      break;
+    case 'f':
+      str += '\f';
+      break;
+    case 'u': {
+      uint32_t code = 0;
+      for (int i = 0; i < 4; i++) {
+        int digit = (pos < len) ? hexValue(json[pos++]) : -1;
+        if (digit < 0) {
+          return fail("Invalid unicode escape");
+        }
+        code = (code << 4) | digit;
+      }
+      // Encode as UTF-8, surrogate pairs are not supported
+      if (code >= 0xD800 && code <= 0xDFFF) {
+        return fail("Unsupported unicode escape");
+      }
+      if (code < 0x80) {
+        str += (char)code;
+      } else if (code < 0x800) {
+        str += (char)(0xC0 | (code >> 6));
+        str += (char)(0x80 | (code & 0x3F));
+      } else {
+        str += (char)(0xE0 | (code >> 12));
+        str += (char)(0x80 | ((code >> 6) & 0x3F));
+        str += (char)(0x80 | (code & 0x3F));
+      }
+      break;
+    }
+    default:
+      return fail("Invalid escape");
+    }
+  }
+  return fail("Unterminated string");
+}
+
+bool JsonReader::parseLiteral(json_type_t &type, String &value) {
+  size_t start = pos;
+  while (pos < len && json[pos] != ',' && json[pos] != '}' &&
+         json[pos] != ' ' && json[pos] != '\t' && json[pos] != '\n' &&
+         json[pos] != '\r') {
+    pos++;
+  }
+  value = "";
+  value.concat(&json[start], pos - start);
+
+  if (value == "true" || value == "false") {
+    type = JSON_BOOL;
+    return true;
+  }
+  if (value == "null") {
+    type = JSON_NULL;
+    return true;
+  }
+  // -?digits[.digits][e[+-]digits]
+  const char *p = value.c_str();
+  if (*p == '-') {
+    p++;
+  }
+  if (!isdigit((unsigned char)*p)) {
+    return fail("Invalid value");
+  }
+  while (isdigit((unsigned char)*p)) {
+    p++;
+  }
+  if (*p == '.') {
+    p++;
+    if (!isdigit((unsigned char)*p)) {
+      return fail("Invalid number");
+    }
+    while (isdigit((unsigned char)*p)) {
+      p++;
+    }
+  }
+  if (*p == 'e' || *p == 'E') {
+    p++;
+    if (*p == '+' || *p == '-') {
+      p++;
+    }
+    if (!isdigit((unsigned char)*p)) {
+      return fail("Invalid number");
+    }
+    while (isdigit((unsigned char)*p)) {
+      p++;
+    }
+  }
+  if (p != value.c_str() + value.length()) {
+    return fail("Invalid number");
+  }
+  type = JSON_NUMBER;
+  return true;
+}
+
+bool JsonReader::next(String &key, json_type_t &type, String &value) {
+  if (finished) {
+    return false;
+  }
+  if (!started) {
+    started = true;
+    if (!expect('{')) {
+      return fail("Object expected");
+    }
+    if (expect('}')) {
+      finished = true;
+      skipSpaces();
+      return (pos == len) ? false : fail("Trailing characters");
+    }
+  } else if (!expect(',')) {
+    if (expect('}')) {
+      finished = true;
+      skipSpaces();
+      return (pos == len) ? false : fail("Trailing characters");
+    }
+    return fail("',' or '}' expected");
+  }
+
+  if (!parseString(key)) {
+    return false;
+  }
+  if (!expect(':')) {
+    return fail("':' expected");
+  }
+  skipSpaces();
+  if (pos >= len) {
+    return fail("Value expected");
+  }
+  if (json[pos] == '"') {
+    type = JSON_STRING;
+    return parseString(value);
+  }
+  if (json[pos] == '{' || json[pos] == '[') {
+    return fail("Nested values are not supported");
+  }
+  return parseLiteral(type, value);
+}
+
+bool JsonReader::toBool(json_type_t type, const String &value, bool &result) {
+  if (type != JSON_BOOL) {
+    return false;
+  }
+  result = (value == "true");
+  return true;
+}
+
+bool JsonReader::toInt(json_type_t type, const String &value,
+                       int32_t &result) {
+  if (type != JSON_NUMBER) {
+    return false;
+  }
+  char *end;
+  errno = 0;
+  long long number = strtoll(value.c_str(), &end, 10);
+  // All of it, a form argument may hold a NUL
+  if (end != value.c_str() + value.length() || errno != 0 ||
+      number < INT32_MIN || number > INT32_MAX) {
+    return false;
+  }
+  result = (int32_t)number;
+  return true;
+}
+
+bool JsonReader::toUInt(json_type_t type, const String &value,
+                        uint32_t &result) {
+  if (type != JSON_NUMBER || value.startsWith("-")) {
+    return false;
+  }
+  char *end;
+  errno = 0;
+  unsigned long long big = strtoull(value.c_str(), &end, 10);
+  if (end != value.c_str() + value.length() || errno != 0 ||
+      big > UINT32_MAX) {
+    return false;
+  }
+  result = (uint32_t)big;
+  return true;
+}
@@ -0,0 +1,50 @@
+#ifndef _JSON_READER_H_
+#define _JSON_READER_H_
+
+#include <Arduino.h>
+
+typedef enum {
+  JSON_STRING,
+  JSON_NUMBER,
+  JSON_BOOL,
+  JSON_NULL,
+} json_type_t;
+
+// Minimal parser for flat JSON objects: {"key": value, ...} where the values
+// are strings, numbers, booleans or null. Nested objects and arrays are
+// reported as errors.
+class JsonReader {
+
+public:
+  JsonReader(const char *json, size_t len);
+  JsonReader(const JsonReader &) = delete;
+  JsonReader &operator=(const JsonReader &) = delete;
+
+  // Returns the next member of the object, false at the end or on error.
+  // String values are unescaped, other values are returned as literals.
+  bool next(String &key, json_type_t &type, String &value);
+  bool failed(void) const { return error != nullptr; }
+  const char *getError(void) const { return error; }
+  size_t getPosition(void) const { return pos; }
+
+  // Conversion helpers, return false if the value does not fit the type
+  static bool toBool(json_type_t type, const String &value, bool &result);
+  static bool toInt(json_type_t type, const String &value, int32_t &result);
+  static bool toUInt(json_type_t type, const String &value, uint32_t &result);
+
+private:
+  void skipSpaces(void);
+  bool expect(char c);
+  bool parseString(String &str);
+  bool parseLiteral(json_type_t &type, String &value);
+  bool fail(const char *message);
+
+  const char *json;
+  size_t len;
+  size_t pos;
+  const char *error;
+  bool started;
+  bool finished;
+};
+
+#endif
@@ -0,0 +1,192 @@
+#include "JsonWriter.h"
+
+JsonWriter::JsonWriter(char *buffer, size_t size, json_flush_t flush,
+                       void *context)
+    : buffer(buffer), size(size), used(0), flushed(0), flushCallback(flush),
+      context(context), nonEmpty(0), depth(0), overflowed(false) {}
+
+void JsonWriter::flush(void) {
+  if (used > 0 && flushCallback != nullptr) {
+    flushCallback(context, buffer, used);
+    flushed += used;
+    used = 0;
+  }
+}
+
+void JsonWriter::write(char c) {
+  if (used == size) {
+    flush();
+    if (used == size) {
+      overflowed = true;
+      return;
+    }
+  }
+  buffer[used++] = c;
+}
+
+void JsonWriter::write(const char *str, size_t len) {
+  while (len > 0) {
+    if (used == size) {
+      flush();
+      if (used == size) {
+        overflowed = true;
+        return;
+      }
+    }
+    size_t chunk = (len > size - used) ? size - used : len;
+    memcpy(&buffer[used], str, chunk);
+    used += chunk;
+    str += chunk;
+    len -= chunk;
+  }
+}
+
+void JsonWriter::writeEscaped(const char *str, size_t len) {
+  static const char hex[] = "0123456789abcdef";
+  const char *run = str;
+
+  write('"');
+  for (size_t i = 0; i < len; i++) {
+    char c = str[i];
+    char escaped = 0;
+    switch (c) {
+    case '"':
+      escaped = '"';
+      break;
+    case '\\':
+      escaped = '\\';
+      break;
+    case '\n':
+      escaped = 'n';
+      break;
+    case '\r':
+      escaped = 'r';
+      break;
+    case '\t':
+      escaped = 't';
+      break;
+    case '\b':
+      escaped = 'b';
+      break;
+    case '\f':
+      escaped = 'f';
+      break;
+    default:
+      if ((uint8_t)c >= 0x20) {
+        continue;
+      }
+      break;
+    }
+    // Copy the unescaped run in one go
+    write(run, &str[i] - run);
+    run = &str[i + 1];
+    write('\\');
+    if (escaped != 0) {
+      write(escaped);
+    } else {
+      write("u00", 3);
+      write(hex[(uint8_t)c >> 4]);
+      write(hex[c & 0x0F]);
+    }
+  }
+  write(run, &str[len] - run);
+  write('"');
+}
+
+void JsonWriter::writeKey(const char *key) {
+  if (depth > 0 && depth <= MAX_DEPTH) {
+    uint32_t bit = 1UL << (depth - 1);
+    if (nonEmpty & bit) {
+      write(',');
+    }
+    nonEmpty |= bit;
+  }
+  if (key != nullptr) {
+    writeEscaped(key, strlen(key));
+    write(':');
+  }
+}
+
+void JsonWriter::writeNumber(unsigned long long value) {
+  char number[21];
+  int len = snprintf(number, sizeof(number), "%llu", value);
+  write(number, len);
+}
+
+void JsonWriter::beginObject(const char *key) {
+  writeKey(key);
+  write('{');
+  depth++;
+  if (depth <= MAX_DEPTH) {
+    nonEmpty &= ~(1UL << (depth - 1));
+  }
+}
+
+void JsonWriter::endObject(void) {
+  if (depth > 0) {
+    depth--;
+  }
+  write('}');
+}
+
+void JsonWriter::beginArray(const char *key) {
+  writeKey(key);
+  write('[');
+  depth++;
+  if (depth <= MAX_DEPTH) {
+    nonEmpty &= ~(1UL << (depth - 1));
+  }
+}
+
+void JsonWriter::endArray(void) {
+  if (depth > 0) {
+    depth--;
+  }
+  write(']');
+}
+
+void JsonWriter::add(const char *key, const char *value) {
+  if (value == nullptr) {
+    addNull(key);
+    return;
+  }
+  add(key, value, strlen(value));
+}
+
+void JsonWriter::add(const char *key, const char *value, size_t len) {
+  writeKey(key);
+  writeEscaped(value, len);
+}
+
+void JsonWriter::add(const char *key, const String &value) {
+  add(key, value.c_str(), value.length());
+}
+
+void JsonWriter::add(const char *key, bool value) {
+  writeKey(key);
+  if (value) {
+    write("true", 4);
+  } else {
+    write("false", 5);
+  }
+}
+
+void JsonWriter::add(const char *key, long long value) {
+  writeKey(key);
+  if (value < 0) {
+    write('-');
+    writeNumber(0ULL - (unsigned long long)value);
+  } else {
+    writeNumber((unsigned long long)value);
+  }
+}
+
+void JsonWriter::add(const char *key, unsigned long long value) {
+  writeKey(key);
+  writeNumber(value);
+}
+
+void JsonWriter::addNull(const char *key) {
+  writeKey(key);
+  write("null", 4);
+}
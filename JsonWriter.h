@@ -0,0 +1,72 @@
+#ifndef _JSON_WRITER_H_
+#define _JSON_WRITER_H_
+
+#include <Arduino.h>
+
+// Called whenever the buffer is full and when the document is finished
+typedef void (*json_flush_t)(void *context, const char *data, size_t len);
+
+// Streaming JSON serializer writing into a caller provided buffer. It never
+// allocates memory; when the buffer fills up its content is handed over to
+// the flush callback and the buffer is reused.
+class JsonWriter {
+
+public:
+  JsonWriter(char *buffer, size_t size, json_flush_t flush = nullptr,
+             void *context = nullptr);
+  JsonWriter(const JsonWriter &) = delete;
+  JsonWriter &operator=(const JsonWriter &) = delete;
+
+  void beginObject(const char *key = nullptr);
+  void endObject(void);
+  void beginArray(const char *key = nullptr);
+  void endArray(void);
+
+  void add(const char *key, const char *value);
+  void add(const char *key, const char *value, size_t len);
+  void add(const char *key, const String &value);
+  void add(const char *key, bool value);
+  void add(const char *key, long long value);
+  void add(const char *key, unsigned long long value);
+  void add(const char *key, int value) { add(key, (long long)value); }
+  void add(const char *key, long value) { add(key, (long long)value); }
+  void add(const char *key, unsigned int value) {
+    add(key, (unsigned long long)value);
+  }
+  void add(const char *key, unsigned long value) {
+    add(key, (unsigned long long)value);
+  }
+  void addNull(const char *key);
+
+  // Array elements
+  void add(const char *value) { add(nullptr, value); }
+  void add(long long value) { add(nullptr, value); }
+
+  void flush(void);
+  const char *data(void) const { return buffer; }
+  size_t length(void) const { return used; }
+  // Total number of bytes serialized so far including flushed ones
+  size_t total(void) const { return flushed + used; }
+  bool overflow(void) const { return overflowed; }
+
+private:
+  static const uint8_t MAX_DEPTH = 32;
+
+  void write(char c);
+  void write(const char *str, size_t len);
+  void writeEscaped(const char *str, size_t len);
+  void writeKey(const char *key);
+  void writeNumber(unsigned long long value);
+
+  char *buffer;
+  size_t size;
+  size_t used;
+  size_t flushed;
+  json_flush_t flushCallback;
+  void *context;
+  uint32_t nonEmpty; // one bit per nesting level
+  uint8_t depth;
+  bool overflowed;
+};
+
+#endif
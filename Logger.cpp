@@ -0,0 +1,282 @@
+#include "Logger.h"
+#include "SystemMonitor.h"
+#include "config.h"
+
+static const char *const module_names[LOG_MODULE_COUNT] = {
+    "main", "clock", "motor", "time", "net", "web", "prefs", "sound"};
+
+static const char *const level_names[LOG_LEVEL_COUNT] = {"none", "error",
+                                                         "info", "debug"};
+
+// The DEBUG_ switches only choose the levels at boot now
+static log_level_t initialLevel(bool debug) {
+  return debug ? LOG_LEVEL_DEBUG : LOG_LEVEL_ERROR;
+}
+
+Logger &Logger::getInstance() {
+  static Logger instance;
+  return instance;
+}
+
+Logger::Logger() : head(0), serial(LOG_TO_SERIAL), lost(0), logTask(nullptr) {
+  for (log_slot_t &slot : slots) {
+    slot.seq = 0;
+  }
+  for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+    levels[i] = initialLevel(DEBUG);
+  }
+  levels[LOG_CLOCK] = initialLevel(DEBUG_HOLLOW_CLOCK);
+  levels[LOG_MOTOR] = initialLevel(DEBUG_MOTOR);
+  levels[LOG_WEB] = initialLevel(DEBUG_CLOCK_WEB_SERVER);
+  levels[LOG_SOUND] = initialLevel(DEBUG_SOUND);
+}
+
+void Logger::start(void) {
+  if (logTask == nullptr) {
+    xTaskCreate(taskFunction, "log", LOG_TASK_STACK_SIZE, this,
+                LOG_TASK_PRIORITY, &logTask);
+    SystemMonitor::getInstance().addTask("log", logTask, LOG_TASK_STACK_SIZE);
+  }
+}
+
+void Logger::setLevel(log_module_t module, log_level_t level) {
+  levels[module] = level;
+}
+
+log_level_t Logger::getLevel(log_module_t module) {
+  return (log_level_t)levels[module].load();
+}
+
+void Logger::getStats(log_stats_t &stats) {
+  stats.records = head;
+  stats.lost = lost;
+}
+
+void Logger::pack(log_record_t &record, const char *value) {
+  // Truncated to the space left, empty once the text is full
+  size_t offset = record.text_len;
+  if (offset >= LOG_TEXT_SIZE) {
+    offset = LOG_TEXT_SIZE - 1;
+  } else {
+    size_t len = value ? strnlen(value, LOG_TEXT_SIZE - 1 - offset) : 0;
+    if (len > 0) {
+      memcpy(record.text + offset, value, len);
+    }
+    record.text[offset + len] = '\0';
+    record.text_len = offset + len + 1;
+  }
+  packWord(record, LOG_ARG_STRING, offset);
+}
+
+void Logger::packWord(log_record_t &record, log_arg_type_t type,
+                      uint32_t value) {
+  if (record.words + 1 > LOG_ARG_WORDS) {
+    return;
+  }
+  record.args[record.words++] = value;
+  record.types |= type << (2 * record.count++);
+}
+
+// Once an argument is dropped the later ones are as well, they would be
+// formatted with the wrong conversions
+void Logger::packWords(log_record_t &record, log_arg_type_t type,
+                       uint64_t value) {
+  if (record.words + 2 > LOG_ARG_WORDS) {
+    record.words = LOG_ARG_WORDS;
+    return;
+  }
+  record.args[record.words++] = (uint32_t)value;
+  record.args[record.words++] = (uint32_t)(value >> 32);
+  record.types |= type << (2 * record.count++);
+}
+
+// A writer takes the next cursor and owns its slot until it stores the
+// cursor + 1 as the sequence, readers check it before and after the copy
+void Logger::commit(const log_record_t &record) {
+  uint32_t cursor = head.fetch_add(1, std::memory_order_relaxed);
+  log_slot_t &slot = slots[cursor % LOG_RECORDS];
+  slot.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.record = record;
+  slot.seq.store(cursor + 1, std::memory_order_release);
+}
+
+uint32_t Logger::getOldest(void) {
+  uint32_t cursor = head;
+  return cursor > LOG_RECORDS ? cursor - LOG_RECORDS : 0;
+}
+
+bool Logger::read(uint32_t &cursor, log_record_t &record, uint32_t &lost) {
+  for (;;) {
+    uint32_t newest = head.load(std::memory_order_acquire);
+    if (cursor == newest) {
+      return false;
+    }
+    if (newest - cursor > LOG_RECORDS) {
+      lost += newest - cursor - LOG_RECORDS;
+      cursor = newest - LOG_RECORDS;
+    }
+    log_slot_t &slot = slots[cursor % LOG_RECORDS];
+    uint32_t seq = slot.seq.load(std::memory_order_acquire);
+    int32_t ahead = (int32_t)(seq - 1 - cursor);
+    if (seq == 0 || ahead < 0) {
+      // Still being written
+      return false;
+    }
+    if (ahead == 0) {
+      record = slot.record;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.seq.load(std::memory_order_relaxed) == seq) {
+        cursor++;
+        return true;
+      }
+    }
+    // Overwritten by a later record
+    lost++;
+    cursor++;
+  }
+}
+
+size_t Logger::format(const log_record_t &record, char *buffer,
+                      size_t size) {
+  int len = snprintf(buffer, size, "%lu.%03lu %s %c ",
+                     (unsigned long)(record.time / 1000000),
+                     (unsigned long)(record.time / 1000 % 1000),
+                     getModuleName((log_module_t)record.module),
+                     toupper(getLevelName((log_level_t)record.level)[0]));
+  size_t pos = (len < 0) ? 0 : ((size_t)len < size ? len : size - 1);
+  const char *p = record.format;
+  uint8_t arg = 0;
+  uint8_t word = 0;
+
+  while (*p != '\0' && pos + 1 < size) {
+    if (*p != '%' || p[1] == '%') {
+      buffer[pos++] = *p;
+      p += (*p == '%') ? 2 : 1;
+      continue;
+    }
+    // The length modifiers are replaced by the recorded type, no * widths
+    char spec[16] = "%";
+    size_t n = 1;
+    for (p++; *p != '\0' && strchr("-+ #0123456789.", *p) &&
+              n < sizeof(spec) - 4;
+         p++) {
+      spec[n++] = *p;
+    }
+    while (*p != '\0' && strchr("hlLqjzt", *p)) {
+      p++;
+    }
+    char conv = *p;
+    if (conv == '\0') {
+      break;
+    }
+    p++;
+
+    log_arg_type_t type = (log_arg_type_t)((record.types >> (2 * arg)) & 3);
+    const uint32_t *value = record.args + word;
+    bool integer = strchr("dicuxXo", conv) != nullptr;
+    bool is_signed = strchr("dic", conv) != nullptr;
+    if (arg >= record.count) {
+      len = snprintf(buffer + pos, size - pos, "?");
+    } else if (type == LOG_ARG_INT && integer) {
+      spec[n++] = conv;
+      len = is_signed ? snprintf(buffer + pos, size - pos, spec,
+                                 (int)(int32_t)value[0])
+                      : snprintf(buffer + pos, size - pos, spec,
+                                 (unsigned int)value[0]);
+    } else if (type == LOG_ARG_INT64 && (integer || conv == 'p')) {
+      uint64_t bits = value[0] | (uint64_t)value[1] << 32;
+      if (conv == 'p') {
+        spec[n++] = conv;
+        len = snprintf(buffer + pos, size - pos, spec,
+                       (void *)(uintptr_t)bits);
+      } else {
+        spec[n++] = 'l';
+        spec[n++] = 'l';
+        spec[n++] = conv;
+        len = is_signed ? snprintf(buffer + pos, size - pos, spec,
+                                   (long long)bits)
+                        : snprintf(buffer + pos, size - pos, spec,
+                                   (unsigned long long)bits);
+      }
+    } else if (type == LOG_ARG_DOUBLE && strchr("fFeEgGaA", conv)) {
+      double number;
+      uint64_t bits = value[0] | (uint64_t)value[1] << 32;
+      memcpy(&number, &bits, sizeof(number));
+      spec[n++] = conv;
+      len = snprintf(buffer + pos, size - pos, spec, number);
+    } else if (type == LOG_ARG_STRING && conv == 's') {
+      spec[n++] = conv;
+      len = snprintf(buffer + pos, size - pos, spec, record.text + value[0]);
+    } else {
+      // The argument does not match the conversion
+      len = snprintf(buffer + pos, size - pos, "?");
+    }
+    if (arg < record.count) {
+      word += (type == LOG_ARG_INT64 || type == LOG_ARG_DOUBLE) ? 2 : 1;
+      arg++;
+    }
+    if (len > 0) {
+      pos += ((size_t)len < size - pos) ? len : size - pos - 1;
+    }
+  }
+  // The messages end with a newline, the readers add their own
+  while (pos > 0 && buffer[pos - 1] == '\n') {
+    pos--;
+  }
+  buffer[pos] = '\0';
+  return pos;
+}
+
+void Logger::taskFunction(void *arg) {
+  Logger *logger = (Logger *)arg;
+  uint32_t cursor = logger->getOldest();
+  log_record_t record;
+  char line[LOG_LINE_MAX];
+
+  for (;;) {
+    uint32_t lost = 0;
+    while (logger->read(cursor, record, lost)) {
+      if (lost > 0) {
+        logger->lost += lost;
+        if (logger->serial) {
+          Serial.printf("... %lu log records lost\n", (unsigned long)lost);
+        }
+        lost = 0;
+      }
+      size_t len = format(record, line, sizeof(line) - 1);
+      if (logger->serial) {
+        line[len++] = '\n';
+        Serial.write((const uint8_t *)line, len);
+      }
+    }
+    logger->lost += lost;
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_INTERVAL));
+  }
+}
+
+const char *Logger::getModuleName(log_module_t module) {
+  return module < LOG_MODULE_COUNT ? module_names[module] : "unknown";
+}
+
+const char *Logger::getLevelName(log_level_t level) {
+  return level < LOG_LEVEL_COUNT ? level_names[level] : "unknown";
+}
+
+int Logger::findModule(const String &name) {
+  for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+    if (name == module_names[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int Logger::findLevel(const String &name) {
+  for (int i = 0; i < LOG_LEVEL_COUNT; i++) {
+    if (name == level_names[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
@@ -0,0 +1,178 @@
+#ifndef _LOGGER_H_
+#define _LOGGER_H_
+
+#include <Arduino.h>
+#include <atomic>
+#include <string.h>
+#include <type_traits>
+
+#define LOG_RECORDS 64        // ring size, a power of two
+#define LOG_ARG_WORDS 8       // 32-bit words of arguments in a record
+#define LOG_TEXT_SIZE 32      // bytes of copied string arguments in a record
+#define LOG_LINE_MAX 192      // formatted record
+#define LOG_DRAIN_INTERVAL 50 // ms between two drains to the serial port
+
+typedef enum {
+  LOG_LEVEL_NONE = 0,
+  LOG_LEVEL_ERROR,
+  LOG_LEVEL_INFO,
+  LOG_LEVEL_DEBUG,
+  LOG_LEVEL_COUNT
+} log_level_t;
+
+typedef enum {
+  LOG_MAIN = 0,
+  LOG_CLOCK,
+  LOG_MOTOR,
+  LOG_TIME,  // SNTP and time zone
+  LOG_NET,
+  LOG_WEB,   // web server, firmware update and Wi-Fi scan
+  LOG_PREFS, // preferences and boot profiles
+  LOG_SOUND,
+  LOG_MODULE_COUNT
+} log_module_t;
+
+typedef enum {
+  LOG_ARG_INT = 0, // up to 32 bits, one word
+  LOG_ARG_INT64,   // two words
+  LOG_ARG_DOUBLE,  // two words
+  LOG_ARG_STRING   // offset of the copy in text, one word
+} log_arg_type_t;
+
+// The arguments are kept raw, the format string is only applied when the
+// record is read. Its pointer is the message id, so it has to be a literal.
+typedef struct {
+  int64_t time; // us since boot
+  const char *format;
+  uint8_t module;
+  uint8_t level;
+  uint8_t count;    // arguments that fit
+  uint8_t words;    // used of args
+  uint8_t text_len; // used of text
+  uint16_t types;   // log_arg_type_t, two bits per argument
+  uint32_t args[LOG_ARG_WORDS];
+  char text[LOG_TEXT_SIZE];
+} log_record_t;
+
+typedef struct {
+  uint32_t records; // written since boot
+  uint32_t lost;    // overwritten before the serial drain got them
+} log_stats_t;
+
+// The format is only checked against the arguments, never called
+static inline void logCheckFormat(const char *format, ...)
+    __attribute__((format(printf, 1, 2)));
+static inline void logCheckFormat(const char *, ...) {}
+
+#define LOG(module, level, ...)                                               \
+  do {                                                                        \
+    Logger &logger_ = Logger::getInstance();                                  \
+    if (logger_.isEnabled(module, level)) {                                   \
+      logger_.write(module, level, __VA_ARGS__);                              \
+    } else if (false) {                                                       \
+      logCheckFormat(__VA_ARGS__);                                            \
+    }                                                                         \
+  } while (0)
+#define LOG_ERROR(module, ...) LOG(module, LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_INFO(module, ...) LOG(module, LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_DEBUG(module, ...) LOG(module, LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+// Records go to a lock-free ring in RAM without formatting, the caller only
+// copies its arguments. A low priority task formats them for the serial
+// port, the web server reads the ring on its own. The oldest records are
+// overwritten when the readers fall behind.
+class Logger {
+
+public:
+  static Logger &getInstance();
+  Logger(const Logger &) = delete;
+  Logger &operator=(const Logger &) = delete;
+
+  // Starts the task draining the ring to the serial port
+  void start(void);
+
+  bool isEnabled(log_module_t module, log_level_t level) {
+    return level <= levels[module].load(std::memory_order_relaxed);
+  }
+  void setLevel(log_module_t module, log_level_t level);
+  log_level_t getLevel(log_module_t module);
+  void setSerial(bool enable) { serial = enable; }
+  bool getSerial(void) { return serial; }
+  void getStats(log_stats_t &stats);
+
+  template <typename... Args>
+  void write(log_module_t module, log_level_t level, const char *format,
+             Args... args) {
+    log_record_t record;
+    record.time = esp_timer_get_time();
+    record.format = format;
+    record.module = module;
+    record.level = level;
+    record.count = 0;
+    record.words = 0;
+    record.text_len = 0;
+    record.types = 0;
+    int unused[] = {0, (pack(record, args), 0)...};
+    (void)unused;
+    commit(record);
+  }
+
+  // Cursor of the oldest record still in the ring
+  uint32_t getOldest(void);
+  // Copies the record at cursor and advances it, false if there is none
+  // yet. Records overwritten in the meantime are skipped and counted.
+  bool read(uint32_t &cursor, log_record_t &record, uint32_t &lost);
+  // One line without the newline, returns its length
+  static size_t format(const log_record_t &record, char *buffer,
+                       size_t size);
+
+  static const char *getModuleName(log_module_t module);
+  static const char *getLevelName(log_level_t level);
+  // -1 if the name is unknown
+  static int findModule(const String &name);
+  static int findLevel(const String &name);
+
+private:
+  Logger();
+  ~Logger() = default;
+
+  typedef struct {
+    std::atomic<uint32_t> seq; // cursor + 1 of the record, 0 while written
+    log_record_t record;
+  } log_slot_t;
+
+  template <typename T>
+  static typename std::enable_if<std::is_integral<T>::value ||
+                                 std::is_enum<T>::value>::type
+  pack(log_record_t &record, T value) {
+    if (sizeof(T) > sizeof(uint32_t)) {
+      packWords(record, LOG_ARG_INT64, (uint64_t)value);
+    } else {
+      packWord(record, LOG_ARG_INT, (uint32_t)value);
+    }
+  }
+  static void pack(log_record_t &record, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    packWords(record, LOG_ARG_DOUBLE, bits);
+  }
+  static void pack(log_record_t &record, const char *value);
+  static void pack(log_record_t &record, const void *value) {
+    packWords(record, LOG_ARG_INT64, (uint64_t)(uintptr_t)value);
+  }
+  static void packWord(log_record_t &record, log_arg_type_t type,
+                       uint32_t value);
+  static void packWords(log_record_t &record, log_arg_type_t type,
+                        uint64_t value);
+  void commit(const log_record_t &record);
+  static void taskFunction(void *arg);
+
+  log_slot_t slots[LOG_RECORDS];
+  std::atomic<uint32_t> head;
+  std::atomic<uint8_t> levels[LOG_MODULE_COUNT];
+  std::atomic<bool> serial;
+  std::atomic<uint32_t> lost;
+  TaskHandle_t logTask;
+};
+
+#endif
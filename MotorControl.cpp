@@ -1,15 +1,9 @@
 #include "MotorControl.h"
+#include "Logger.h"
 #include "config.h"
 
-#if DEBUG_MOTOR
-#define TRACE(...) Serial.printf(__VA_ARGS__)
-#define ERROR(...) Serial.printf(__VA_ARGS__)
-#define DBG(x) x
-#else
-#define TRACE(...)
-#define ERROR(...)
-#define DBG(x)
-#endif
+#define TRACE(...) LOG_DEBUG(LOG_MOTOR, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_MOTOR, __VA_ARGS__)
 
 MotorControl &MotorControl::getInstance() {
   static MotorControl instance;
@@ -31,6 +25,8 @@ void MotorControl::rotate(int steps, int delaytime, bool flip_rotation) {
   int idx = flip_rotation ? 1 : 0;
 
   int abs_steps = (steps > 0) ? steps : -steps;
+  std::lock_guard<std::mutex> lock(motorMutex);
+  steps_moved += abs_steps;
   for (phaseIndex = 0; phaseIndex < abs_steps; phaseIndex++) {
     phase = (phase + delta) % 4;
     for (stepIndex = 0; stepIndex < 4; stepIndex++) {
@@ -47,8 +43,27 @@ void MotorControl::rotate(int steps, int delaytime, bool flip_rotation) {
   }
 }
 
+uint32_t MotorControl::getRotateTime(int steps, int delaytime) {
+  uint32_t abs_steps = (steps > 0) ? steps : -steps;
+  uint32_t dt;
+
+  if (delaytime > 0) {
+    dt = delaytime * 3;
+  } else {
+    delaytime = 2;
+    dt = 2 * delaytime;
+  }
+  // rotate() starts slow and speeds up by 1 ms per step
+  uint32_t ramp = dt - delaytime;
+  if (ramp > abs_steps) {
+    ramp = abs_steps;
+  }
+  return ramp * dt - ramp * (ramp - 1) / 2 + (abs_steps - ramp) * delaytime;
+}
+
 void MotorControl::playSound(unsigned int freq, unsigned int time) {
-  int i, j, idx = 0;
+  int i, idx = 0;
+  unsigned int j;
 
   if (freq == 0) {
     return;
@@ -59,11 +74,12 @@ void MotorControl::playSound(unsigned int freq, unsigned int time) {
   int phases[2];
 
   waves = waves & 0xFFFFFFFE; // make it even
+  std::lock_guard<std::mutex> lock(motorMutex);
 
   phases[0] = (phase + 1) % 4;
   phases[1] = (phase) % 4;
 
-  DBG(unsigned long startTime = millis());
+  unsigned long startTime = millis();
 
   for (j = 0; j < waves; j++) {
     for (i = 0; i < 4; i++) {
@@ -78,9 +94,7 @@ void MotorControl::playSound(unsigned int freq, unsigned int time) {
     digitalWrite(ports[0][i], LOW);
   }
 
-  DBG(unsigned long endTime = millis());
-  DBG(unsigned long timePassed = endTime - startTime);
-  DBG(Serial.printf("Time passed: %d ms\n", timePassed));
+  TRACE("Time passed: %lu ms\n", millis() - startTime);
 }
 
 MotorControl::MotorControl() {
@@ -2,6 +2,8 @@
 #define _MOTOR_CONTROL_H_
 
 #include <Arduino.h>
+#include <atomic>
+#include <mutex>
 
 class MotorControl {
 
@@ -11,13 +13,20 @@ public:
   MotorControl &operator=(const MotorControl &) = delete;
 
   void rotate(int steps, int delaytime, bool flip_rotation);
+  // Time in ms rotate() takes for the same arguments
+  uint32_t getRotateTime(int steps, int delaytime);
   void playSound(unsigned int freq, unsigned int time);
+  // Total number of steps moved since boot
+  uint32_t getStepsMoved(void) { return steps_moved; }
 
 private:
   MotorControl();
   ~MotorControl() = default;
 
+  // The clock thread and the sound player share the coils
+  std::mutex motorMutex;
   int phase = 0;
+  std::atomic<uint32_t> steps_moved{0};
   int ports[2][4];
 
   // sequence of stepper motor control
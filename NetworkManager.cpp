@@ -0,0 +1,457 @@
+#include "NetworkManager.h"
+#include "BootProfiler.h"
+#include "Logger.h"
+#include "PreferencesManager.h"
+#include "SntpClient.h"
+#include "SoundPlayer.h"
+#include "SystemMonitor.h"
+#include "config.h"
+#include <ESPmDNS.h>
+
+#define TRACE(...) LOG_DEBUG(LOG_NET, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_NET, __VA_ARGS__)
+
+// Notification bits sent from the Wi-Fi events to the network task
+#define NET_EVENT_GOT_IP (1UL << 0)
+#define NET_EVENT_DISCONNECTED (1UL << 1)
+#define NET_EVENT_AUTH_FAILED (1UL << 2)
+
+#define TIME_VALID_AFTER 1577836800 // 2020-01-01, earlier means never set
+
+static const char *net_namespace = "HC5Net";
+static const char *net_cache_key = "Cache";
+
+static const char *const net_state_names[] = {"idle", "connecting",
+                                              "connected", "backoff", "ap"};
+
+NetworkManager &NetworkManager::getInstance() {
+  static NetworkManager instance;
+  return instance;
+}
+
+NetworkManager::NetworkManager()
+    : cacheValid(false), fastAttempt(false), staticAttempt(false),
+      leasePending(false), everConnected(false), bootTime(0), stateSince(0),
+      netTask(nullptr), dnsTask(nullptr), apActive(false) {
+  memset(&stats, 0, sizeof(stats));
+  stats.state = NET_IDLE;
+  // Kept apart from the settings, a factory reset of the clock does not
+  // need to know about it and it never goes through the web pages
+  preferences.begin(net_namespace, false);
+  cacheValid = preferences.getBytes(net_cache_key, &cache, sizeof(cache)) ==
+               sizeof(cache);
+}
+
+const char *NetworkManager::getStateName(net_state_t state) {
+  return (state <= NET_AP) ? net_state_names[state] : "unknown";
+}
+
+String NetworkManager::getAPName(void) {
+  uint64_t chipid = ESP.getEfuseMac() >> 40;
+  String hex = String(chipid, HEX);
+  hex.toUpperCase();
+  return DEFAULT_AP_NAME_PREFIX + hex;
+}
+
+void NetworkManager::getStats(net_stats_t &s) {
+  std::lock_guard<std::mutex> lock(statsMutex);
+  s = stats;
+  s.state_time = millis() - stateSince;
+}
+
+// Runs in the Wi-Fi event task, only hands the event over
+void NetworkManager::onWifiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
+  NetworkManager &nm = getInstance();
+  uint32_t bits = 0;
+
+  switch (event) {
+  case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+    TRACE("WiFi IP:%s\n", WiFi.localIP().toString().c_str());
+    bits = NET_EVENT_GOT_IP;
+    break;
+  case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+    TRACE("Disconnected from AP! Reason:%d\n",
+          info.wifi_sta_disconnected.reason);
+    bits = NET_EVENT_DISCONNECTED;
+    // A wrong password, waiting for the timeout would not help
+    switch (info.wifi_sta_disconnected.reason) {
+    case WIFI_REASON_AUTH_EXPIRE:
+    case WIFI_REASON_AUTH_FAIL:
+    case WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT:
+    case WIFI_REASON_HANDSHAKE_TIMEOUT:
+      bits |= NET_EVENT_AUTH_FAILED;
+      break;
+    default:
+      break;
+    }
+    break;
+  default:
+    break;
+  }
+  if (bits != 0 && nm.netTask != nullptr) {
+    xTaskNotify(nm.netTask, bits, eSetBits);
+  }
+}
+
+void NetworkManager::taskFunction(void *arg) {
+  NetworkManager *nm = (NetworkManager *)arg;
+  uint32_t wait = 0;
+
+  while (true) {
+    uint32_t events = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &events,
+                    (wait == portMAX_DELAY) ? portMAX_DELAY
+                                            : pdMS_TO_TICKS(wait));
+    wait = nm->process(events);
+  }
+}
+
+// Answers the captive portal DNS queries even while loop() is busy
+void NetworkManager::dnsTaskFunction(void *arg) {
+  NetworkManager *nm = (NetworkManager *)arg;
+
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(nm->dnsMutex);
+      if (nm->apActive) {
+        nm->dnsServer.processNextRequest();
+      }
+    }
+    vTaskDelay(pdMS_TO_TICKS(DNS_POLL_INTERVAL));
+  }
+}
+
+void NetworkManager::start(void) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+
+  ssid = pm.getSSID();
+  password = pm.getPassword();
+  hostname = pm.getHostName();
+  bootTime = millis();
+  stateSince = bootTime;
+
+  if (ssid.isEmpty()) {
+    ERROR("SSID is empty, cannot connect to network.\n");
+    startAP();
+    return;
+  }
+  // Apparently this has to be the first WiFi call in order to work
+  WiFi.hostname(hostname);
+  WiFi.disconnect(true);
+  WiFi.mode(WIFI_STA);
+  // Reconnects are done by the task, the driver must not retry on its own
+  // or write its config to flash on every attempt
+  WiFi.setAutoReconnect(false);
+  WiFi.persistent(false);
+  WiFi.setSleep(false);
+  WiFi.onEvent(onWifiEvent, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+  WiFi.onEvent(onWifiEvent, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+
+  xTaskCreate(taskFunction, "network", NET_TASK_STACK_SIZE, this,
+              NET_TASK_PRIORITY, &netTask);
+  SystemMonitor::getInstance().addTask("network", netTask,
+                                       NET_TASK_STACK_SIZE);
+}
+
+// Runs the state machine, returns the time in ms until it needs to run
+// again without an event
+uint32_t NetworkManager::process(uint32_t events) {
+  uint32_t timeout = 0;
+
+  switch (stats.state) {
+  case NET_IDLE:
+    startAttempt();
+    break;
+  case NET_CONNECTING:
+    // A failed association is also reported as a disconnect, but so is the
+    // end of the previous attempt, only the timeout tells them apart. The
+    // previous attempt never ends with an authentication failure.
+    if (events & NET_EVENT_GOT_IP) {
+      connected();
+    } else if (events & NET_EVENT_AUTH_FAILED) {
+      ERROR("WiFi authentication failed\n");
+      attemptFailed();
+    } else if (millis() - stateSince >=
+               (fastAttempt ? WIFI_FAST_CONNECT_TIMEOUT
+                            : WIFI_CONNECT_TIMEOUT)) {
+      attemptFailed();
+    }
+    break;
+  case NET_CONNECTED:
+    if (events & NET_EVENT_DISCONNECTED) {
+      std::unique_lock<std::mutex> lock(statsMutex);
+      stats.disconnects++;
+      // A flapping access point keeps growing the backoff
+      if (millis() - stateSince >= WIFI_STABLE_TIME) {
+        stats.failures = 0;
+      } else {
+        stats.failures++;
+      }
+      lock.unlock();
+      scheduleRetry();
+    } else if (leasePending) {
+      stampLease();
+    }
+    break;
+  case NET_BACKOFF:
+    if (events & NET_EVENT_GOT_IP) {
+      connected(); // the driver got there after all
+    } else if (millis() - stateSince >= stats.backoff) {
+      startAttempt();
+    }
+    break;
+  case NET_AP:
+    break;
+  }
+
+  switch (stats.state) {
+  case NET_CONNECTING:
+    timeout = fastAttempt ? WIFI_FAST_CONNECT_TIMEOUT : WIFI_CONNECT_TIMEOUT;
+    break;
+  case NET_CONNECTED:
+    return leasePending ? WIFI_LEASE_CHECK_INTERVAL : portMAX_DELAY;
+  case NET_BACKOFF:
+    timeout = stats.backoff;
+    break;
+  default:
+    return portMAX_DELAY;
+  }
+  uint32_t elapsed = millis() - stateSince;
+  return (elapsed < timeout) ? timeout - elapsed : 0;
+}
+
+void NetworkManager::setState(net_state_t new_state) {
+  std::lock_guard<std::mutex> lock(statsMutex);
+  TRACE("Network %s -> %s\n", getStateName(stats.state),
+        getStateName(new_state));
+  stats.state = new_state;
+  stateSince = millis();
+}
+
+void NetworkManager::startAttempt(void) {
+  fastAttempt = cacheUsable();
+  staticAttempt = WIFI_CACHE_STATIC_IP && fastAttempt && leaseUsable();
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.attempts++;
+  }
+  if (fastAttempt) {
+    TRACE("WiFi fast connect, channel %d, static IP %d\n", cache.channel,
+          staticAttempt);
+    if (staticAttempt) {
+      WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway),
+                  IPAddress(cache.mask), IPAddress(cache.dns));
+    } else {
+      WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE);
+    }
+    WiFi.begin(ssid.c_str(), password.c_str(), cache.channel, cache.bssid);
+  } else {
+    TRACE("WiFi connecting to %s\n", ssid.c_str());
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE);
+    WiFi.begin(ssid.c_str(), password.c_str());
+  }
+  setState(NET_CONNECTING);
+}
+
+void NetworkManager::attemptFailed(void) {
+  uint32_t failures;
+
+  ERROR("WiFi connect failed\n");
+  WiFi.disconnect();
+  if (fastAttempt) {
+    // The access point moved or the lease is gone
+    invalidateCache();
+  }
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    failures = ++stats.failures;
+  }
+  // Someone may need to fix the settings, the station keeps trying
+  if (!everConnected && !apActive && failures >= WIFI_AP_FALLBACK_ATTEMPTS) {
+    startAP();
+  }
+  scheduleRetry();
+}
+
+// Exponential backoff with +-25% jitter, so clocks behind the same access
+// point do not retry in lockstep
+void NetworkManager::scheduleRetry(void) {
+  std::unique_lock<std::mutex> lock(statsMutex);
+  uint32_t shift = (stats.failures < 8) ? stats.failures : 8;
+  uint32_t backoff = WIFI_BACKOFF_MIN << shift;
+  if (backoff > WIFI_BACKOFF_MAX) {
+    backoff = WIFI_BACKOFF_MAX;
+  }
+  stats.backoff = backoff - backoff / 4 + esp_random() % (backoff / 2 + 1);
+  TRACE("WiFi retry in %lu ms\n", (unsigned long)stats.backoff);
+  lock.unlock();
+  setState(NET_BACKOFF);
+}
+
+void NetworkManager::connected(void) {
+  bool first = !everConnected;
+
+  if (apActive) {
+    stopAP();
+  }
+  storeCache();
+  everConnected = true;
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.connects++;
+    stats.failures = 0;
+    stats.backoff = 0;
+    if (first) {
+      stats.connect_time = millis() - bootTime;
+      stats.fast_connect = fastAttempt;
+    }
+  }
+  setState(NET_CONNECTED);
+  TRACE("WiFi connected. IP address: %s\n",
+        WiFi.localIP().toString().c_str());
+  // Resync now instead of at the next interval
+  SntpClient::getInstance().requestSync();
+  if (first) {
+    BootProfiler &profiler = BootProfiler::getInstance();
+    profiler.mark(BOOT_PHASE_WIFI);
+    MDNS.begin(hostname);
+    profiler.mark(BOOT_PHASE_MDNS);
+    SoundPlayer::getInstance().playMusic(MUSIC_NOKIA_RINGTONE);
+    profiler.mark(BOOT_PHASE_RINGTONE);
+  }
+}
+
+// Without an SSID there is nothing to join and only the access point runs,
+// otherwise the station side stays on and the state machine goes on
+void NetworkManager::startAP(void) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  String ap_name = getAPName();
+
+  TRACE("AP:%s\n", ap_name.c_str());
+  WiFi.mode(ssid.isEmpty() ? WIFI_AP : WIFI_AP_STA);
+  WiFi.softAPConfig(pm.getServerIP().c_str(), pm.getServerGW().c_str(),
+                    pm.getServerMask().c_str());
+  WiFi.softAP(ap_name.c_str());
+  WiFi.setHostname(hostname.c_str());
+  {
+    std::lock_guard<std::mutex> lock(dnsMutex);
+    // Every name resolves to the clock, so phones open the setup page
+    dnsServer.setErrorReplyCode(DNSReplyCode::NoError);
+    dnsServer.start(DNS_PORT, "*", WiFi.softAPIP());
+    apActive = true;
+  }
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.ap_active = true;
+  }
+  if (dnsTask == nullptr) {
+    xTaskCreate(dnsTaskFunction, "dns", DNS_TASK_STACK_SIZE, this,
+                DNS_TASK_PRIORITY, &dnsTask);
+    SystemMonitor::getInstance().addTask("dns", dnsTask, DNS_TASK_STACK_SIZE);
+  }
+  if (ssid.isEmpty()) {
+    setState(NET_AP);
+  }
+}
+
+// The station got an address, the setup page is reached through it now
+void NetworkManager::stopAP(void) {
+  TRACE("AP closed\n");
+  {
+    std::lock_guard<std::mutex> lock(dnsMutex);
+    apActive = false;
+    dnsServer.stop();
+  }
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.ap_active = false;
+  }
+  WiFi.mode(WIFI_STA);
+}
+
+// FNV-1a, only used to notice that the SSID changed
+uint32_t NetworkManager::hashSSID(const String &ssid) {
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < ssid.length(); i++) {
+    hash = (hash ^ (uint8_t)ssid[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+bool NetworkManager::cacheUsable(void) {
+  return cacheValid && cache.ssid_hash == hashSSID(ssid);
+}
+
+// The router may give the address to another device once the lease ran
+// out. The time survives a restart but not a power cut, so the boots on
+// the address are counted as well.
+bool NetworkManager::leaseUsable(void) {
+  time_t now = time(nullptr);
+  if (cache.ip == 0 || cache.boots >= WIFI_CACHE_DHCP_BOOTS) {
+    return false;
+  }
+  if (cache.leased != 0 && now >= TIME_VALID_AFTER) {
+    return now >= (time_t)cache.leased &&
+           now - cache.leased < WIFI_CACHE_LEASE_TIME;
+  }
+  return true;
+}
+
+// DHCP is mostly done before the first NTP update, the lease gets its time
+// once the clock has one
+void NetworkManager::stampLease(void) {
+  time_t now = time(nullptr);
+  if (now < TIME_VALID_AFTER) {
+    return;
+  }
+  leasePending = false;
+  if (cacheValid) {
+    cache.leased = now - (millis() - stateSince) / 1000;
+    writeCache();
+  }
+}
+
+// Only written when the network or the lease changed
+void NetworkManager::storeCache(void) {
+  wifi_cache_t current;
+  uint8_t *bssid = WiFi.BSSID();
+
+  memset(&current, 0, sizeof(current));
+  current.ssid_hash = hashSSID(ssid);
+  if (bssid != nullptr) {
+    memcpy(current.bssid, bssid, sizeof(current.bssid));
+  }
+  current.channel = WiFi.channel();
+  current.ip = WiFi.localIP();
+  current.gateway = WiFi.gatewayIP();
+  current.mask = WiFi.subnetMask();
+  current.dns = WiFi.dnsIP();
+  if (staticAttempt) {
+    current.leased = cache.leased;
+    current.boots = cache.boots + (everConnected ? 0 : 1);
+  } else if (WIFI_CACHE_STATIC_IP) {
+    time_t now = time(nullptr);
+    current.leased = (now >= TIME_VALID_AFTER) ? now : 0;
+    leasePending = current.leased == 0;
+  }
+
+  if (cacheValid && memcmp(&current, &cache, sizeof(cache)) == 0) {
+    return;
+  }
+  cache = current;
+  writeCache();
+}
+
+void NetworkManager::writeCache(void) {
+  cacheValid =
+      preferences.putBytes(net_cache_key, &cache, sizeof(cache)) ==
+      sizeof(cache);
+  TRACE("WiFi cache stored:%d\n", cacheValid);
+}
+
+void NetworkManager::invalidateCache(void) {
+  if (cacheValid) {
+    cacheValid = false;
+    preferences.remove(net_cache_key);
+  }
+}
@@ -0,0 +1,115 @@
+#ifndef _NETWORK_MANAGER_H_
+#define _NETWORK_MANAGER_H_
+
+#include <Arduino.h>
+#include <DNSServer.h>
+#include <Preferences.h>
+#include <WiFi.h>
+#include <mutex>
+
+#define WIFI_CONNECT_TIMEOUT 15000      // ms, one attempt with a full scan
+#define WIFI_FAST_CONNECT_TIMEOUT 3000  // ms, one attempt with the cache
+#define WIFI_BACKOFF_MIN 1000           // ms, first retry
+#define WIFI_BACKOFF_MAX 120000         // ms, longest wait between retries
+#define WIFI_STABLE_TIME 30000          // ms, connected longer resets backoff
+#define WIFI_AP_FALLBACK_ATTEMPTS 3     // failures before the setup AP
+#define WIFI_LEASE_CHECK_INTERVAL 10000 // ms, until the lease gets its time
+
+typedef enum {
+  NET_IDLE = 0,
+  NET_CONNECTING,
+  NET_CONNECTED,
+  NET_BACKOFF,
+  NET_AP,
+} net_state_t;
+
+typedef struct {
+  net_state_t state;
+  uint32_t state_time;   // ms in the current state
+  uint32_t attempts;     // connect attempts since boot
+  uint32_t failures;     // failed attempts in a row
+  uint32_t connects;
+  uint32_t disconnects;  // lost connections
+  uint32_t connect_time; // ms, boot until the first connection
+  uint32_t backoff;      // ms, current wait before the next attempt
+  bool fast_connect;     // the first connection used the cache
+  bool ap_active;        // the setup access point is up
+} net_stats_t;
+
+// Last association, reused at boot to skip the scan and the DHCP exchange
+typedef struct {
+  uint32_t ssid_hash;
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t mask;
+  uint32_t dns;
+  uint32_t leased; // s since 1970 when DHCP gave the address, 0 if unknown
+  uint8_t boots;   // boots on the address since DHCP gave it
+} wifi_cache_t;
+
+// Owns the station connection. The Wi-Fi events only wake the network
+// task, which connects, retries with a jittered exponential backoff and
+// opens the setup access point when the network cannot be joined. The
+// retries go on next to the access point, which closes once the station
+// has an address.
+class NetworkManager {
+
+public:
+  static NetworkManager &getInstance();
+  NetworkManager(const NetworkManager &) = delete;
+  NetworkManager &operator=(const NetworkManager &) = delete;
+
+  void start(void);
+  void getStats(net_stats_t &stats);
+  static const char *getStateName(net_state_t state);
+  // Drops the cached access point, the next connect does a full scan
+  void invalidateCache(void);
+  static String getAPName(void);
+
+private:
+  NetworkManager();
+  ~NetworkManager() = default;
+
+  static void taskFunction(void *arg);
+  static void dnsTaskFunction(void *arg);
+  static void onWifiEvent(WiFiEvent_t event, WiFiEventInfo_t info);
+  uint32_t process(uint32_t events);
+  void setState(net_state_t new_state);
+  void startAttempt(void);
+  void attemptFailed(void);
+  void scheduleRetry(void);
+  void connected(void);
+  void startAP(void);
+  void stopAP(void);
+  bool cacheUsable(void);
+  bool leaseUsable(void);
+  void stampLease(void);
+  void storeCache(void);
+  void writeCache(void);
+  static uint32_t hashSSID(const String &ssid);
+
+  String ssid;
+  String password;
+  String hostname;
+  Preferences preferences;
+  wifi_cache_t cache;
+  bool cacheValid;
+  bool fastAttempt;
+  bool staticAttempt; // the cached address was reused without DHCP
+  bool leasePending;  // DHCP gave the address before the time was known
+  bool everConnected;
+  unsigned long bootTime;
+  unsigned long stateSince;
+  TaskHandle_t netTask;
+  TaskHandle_t dnsTask;
+  DNSServer dnsServer;
+  std::mutex dnsMutex; // the DNS task answers while the network task stops it
+  bool apActive;
+
+  std::mutex statsMutex;
+  net_stats_t stats;
+};
+
+#endif
@@ -1,16 +1,210 @@
 #include "PreferencesManager.h"
+#include "HollowClock.h"
+#include "Logger.h"
+#include "SystemMonitor.h"
 #include <Preferences.h>
+#include <nvs.h>
 #include <nvs_flash.h>
 
-#if DEBUG
-#define DBG(x) x
-#define TRACE(...) Serial.printf(__VA_ARGS__)
-#define ERROR(...) Serial.printf(__VA_ARGS__)
-#else
-#define DBG(x)
-#define TRACE(...)
-#define ERROR(...)
-#endif
+#define TRACE(...) LOG_DEBUG(LOG_PREFS, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_PREFS, __VA_ARGS__)
+
+#define PREF_DIRTY(key) (1UL << (key))
+#define PREF_DIRTY_ALL (PREF_DIRTY(PREF_KEY_COUNT) - 1)
+
+static const char *prefs_version_key = "Version";
+static const char *prefs_clock_position_key = "ClockPos";
+
+static StackType_t prefs_stack[PREFS_TASK_STACK_SIZE];
+static StaticTask_t prefs_task_buffer;
+
+// Validators used by the schema
+template <typename T> static bool checkAny(const T &) { return true; }
+
+static bool checkNotEmpty(const String &value) { return !value.isEmpty(); }
+
+static bool checkIP(const String &value) {
+  IPAddress ipAddr;
+  return ipAddr.fromString(value);
+}
+
+static bool checkSSID(const String &value) { return value.length() <= 32; }
+
+static bool checkPassword(const String &value) {
+  return value.length() <= 63;
+}
+
+static bool checkNTPUpdate(const uint32_t &value) {
+  return value >= 15 && value <= MAX_NTP_UPDATE;
+}
+
+static bool checkZone(const zone_id_t &value) {
+  zone_entry_t zone;
+  return zones_FindById(value, zone);
+}
+
+static bool checkTimezoneValue(const int &value) {
+  return value >= MIN_TIMEZONE_OFFSET && value <= MAX_TIMEZONE_OFFSET;
+}
+
+static bool checkStepsPerMinute(const uint32_t &value) {
+  return value != 0 && value <= STEPS_PER_MINUTE_MAX;
+}
+
+static bool checkDelayTime(const uint8_t &value) { return value >= 2; }
+
+static bool checkJumpPolicy(const uint8_t &value) {
+  return value < JUMP_POLICY_COUNT;
+}
+
+static zone_id_t defaultZone(void) {
+  zone_entry_t zone;
+  return zones_FindByName(DEFAULT_TIMEZONE_LOCATION, zone) ? zone.id
+                                                           : ZONE_INVALID_ID;
+}
+
+// Storage formats, the NVS types match the ones used by Preferences
+struct pref_kind_STR {
+  static void load(Preferences &prefs, const char *key, String &value) {
+    value = prefs.getString(key, value);
+  }
+  static esp_err_t store(nvs_handle_t handle, const char *key,
+                         const String &value) {
+    return nvs_set_str(handle, key, value.c_str());
+  }
+  static void toJson(JsonWriter &json, const char *name, const String &value) {
+    json.add(name, value);
+  }
+  static bool fromJson(json_type_t type, const String &text, String &value) {
+    value = text;
+    return type == JSON_STRING;
+  }
+  static void print(const char *key, const String &value) {
+    TRACE("\t%s: %s\n", key, value.c_str());
+  }
+};
+
+struct pref_kind_BOOL {
+  static void load(Preferences &prefs, const char *key, bool &value) {
+    value = prefs.getBool(key, value);
+  }
+  static esp_err_t store(nvs_handle_t handle, const char *key, bool value) {
+    return nvs_set_u8(handle, key, value);
+  }
+  static void toJson(JsonWriter &json, const char *name, bool value) {
+    json.add(name, value);
+  }
+  static bool fromJson(json_type_t type, const String &text, bool &value) {
+    return JsonReader::toBool(type, text, value);
+  }
+  static void print(const char *key, bool value) {
+    TRACE("\t%s: %s\n", key, value ? "true" : "false");
+  }
+};
+
+struct pref_kind_U8 {
+  static void load(Preferences &prefs, const char *key, uint8_t &value) {
+    value = prefs.getUChar(key, value);
+  }
+  static esp_err_t store(nvs_handle_t handle, const char *key, uint8_t value) {
+    return nvs_set_u8(handle, key, value);
+  }
+  static void toJson(JsonWriter &json, const char *name, uint8_t value) {
+    json.add(name, (unsigned int)value);
+  }
+  static bool fromJson(json_type_t type, const String &text, uint8_t &value) {
+    uint32_t number;
+    if (!JsonReader::toUInt(type, text, number) || number > UINT8_MAX) {
+      return false;
+    }
+    value = number;
+    return true;
+  }
+  static void print(const char *key, uint8_t value) {
+    TRACE("\t%s: %u\n", key, value);
+  }
+};
+
+struct pref_kind_U32 {
+  static void load(Preferences &prefs, const char *key, uint32_t &value) {
+    value = prefs.getUInt(key, value);
+  }
+  static esp_err_t store(nvs_handle_t handle, const char *key,
+                         uint32_t value) {
+    return nvs_set_u32(handle, key, value);
+  }
+  static void toJson(JsonWriter &json, const char *name, uint32_t value) {
+    json.add(name, value);
+  }
+  static bool fromJson(json_type_t type, const String &text, uint32_t &value) {
+    return JsonReader::toUInt(type, text, value);
+  }
+  static void print(const char *key, uint32_t value) {
+    TRACE("\t%s: %lu\n", key, (unsigned long)value);
+  }
+};
+
+struct pref_kind_I32 {
+  static void load(Preferences &prefs, const char *key, int &value) {
+    value = prefs.getInt(key, value);
+  }
+  static esp_err_t store(nvs_handle_t handle, const char *key, int value) {
+    return nvs_set_i32(handle, key, value);
+  }
+  static void toJson(JsonWriter &json, const char *name, int value) {
+    json.add(name, value);
+  }
+  static bool fromJson(json_type_t type, const String &text, int &value) {
+    int32_t number;
+    if (!JsonReader::toInt(type, text, number)) {
+      return false;
+    }
+    value = number;
+    return true;
+  }
+  static void print(const char *key, int value) {
+    TRACE("\t%s: %d\n", key, value);
+  }
+};
+
+// Zone ID, exchanged as the location name in JSON
+struct pref_kind_ZONE {
+  static void load(Preferences &prefs, const char *key, zone_id_t &value) {
+    value = prefs.getUInt(key, value);
+  }
+  static esp_err_t store(nvs_handle_t handle, const char *key,
+                         zone_id_t value) {
+    return nvs_set_u32(handle, key, value);
+  }
+  static void toJson(JsonWriter &json, const char *name, zone_id_t value) {
+    zone_entry_t zone;
+    if (zones_FindById(value, zone)) {
+      json.add(name, zone.name);
+    } else {
+      json.addNull(name);
+    }
+  }
+  static bool fromJson(json_type_t type, const String &text,
+                       zone_id_t &value) {
+    zone_entry_t zone;
+    if (type != JSON_STRING || !zones_FindByName(text.c_str(), zone)) {
+      return false;
+    }
+    value = zone.id;
+    return true;
+  }
+  static void print(const char *key, zone_id_t value) {
+    zone_entry_t zone;
+    TRACE("\t%s: %08X %s\n", key, (unsigned int)value,
+          zones_FindById(value, zone) ? zone.name : "unknown");
+  }
+};
+
+#define PREF_JSON_NAME(field, Name, key, json, type, kind, def, check, msg)   \
+  json,
+static const char *const pref_json_names[PREF_FIELDS_COUNT] = {
+    PREFS_SCHEMA(PREF_JSON_NAME)};
+#undef PREF_JSON_NAME
 
 PreferencesManager &PreferencesManager::getInstance() {
   static PreferencesManager instance;
@@ -18,28 +212,22 @@ PreferencesManager &PreferencesManager::getInstance() {
 }
 
 void PreferencesManager::printPreferences(void) {
+  std::lock_guard<std::mutex> lock(prefsMutex);
   TRACE("Preferences:\n");
-  TRACE("\tServer Hostname: %s\n", server_hostname.c_str());
-  TRACE("\tSSID: %s\n", ssid.c_str());
-  TRACE("\tPassword: %s\n", password.c_str());
-  TRACE("\tNTP Server: %s\n", ntpserver.c_str());
-  TRACE("\tTimezone: %s\n", timezone.c_str());
-  TRACE("\tNTP Timeout: %d\n", ntp_update);
-  TRACE("\tTimezone Location: %s\n", timezone_location.c_str());
-  TRACE("\tManual Timezone: %s\n", timezone_manual ? "true" : "false");
-  TRACE("\tManual Timezone Value: %d\n", timezone_manual_value);
-  TRACE("\tFlip Rotation: %s\n", flip_rotation ? "true" : "false");
-  TRACE("\tAllow Backward: %s\n", allow_backward ? "true" : "false");
-  TRACE("\tChime: %s\n", chime ? "true" : "false");
-  TRACE("\tSteps Per Minute: %d\n", steps_per_minute);
-  TRACE("\tDelay Time: %d\n", delay_time);
-  TRACE("\tServer IP: %s\n", server_ip.c_str());
-  TRACE("\tClock Position: %d\n", clock_position);
-  TRACE("\tServer Gateway: %s\n", server_gw.c_str());
-  TRACE("\tServer Mask: %s\n", server_mask.c_str());
+#define PREF_PRINT(field, Name, key, json, type, kind, def, check, msg)       \
+  pref_kind_##kind::print(key, settings.field);
+  PREFS_SCHEMA(PREF_PRINT)
+#undef PREF_PRINT
+  TRACE("\tClock Position: %lu\n", (unsigned long)clock_position);
 }
 
 void PreferencesManager::eraseAll(void) {
+  std::lock_guard<std::mutex> flushLock(flushMutex);
+  {
+    // Pending changes must not be written back after the wipe
+    std::lock_guard<std::mutex> lock(prefsMutex);
+    dirty = 0;
+  }
   TRACE("Wiping flash....\n");
   esp_err_t error;
   error = nvs_flash_erase(); // erase the NVS partition and...
@@ -49,267 +237,346 @@ void PreferencesManager::eraseAll(void) {
       ERROR("Flash init status ....:%d\n", error);
     }
   } else {
-    ERROR("Wiping flash error ....:%d\n");
+    ERROR("Wiping flash error ....:%d\n", error);
   }
 }
 
-String PreferencesManager::getHostName(void) { return server_hostname; }
-
-pref_result_t PreferencesManager::setHostName(const String &hostname) {
-  if (hostname.isEmpty()) {
-    ERROR("Hostname is empty\n");
-    return PREF_ERROR;
-  }
-  if (server_hostname != hostname) {
-    server_hostname = hostname;
-    preferences.putString(prefs_server_hostname_key, hostname);
+// Called with prefsMutex held
+void PreferencesManager::markDirty(uint32_t keys) {
+  if (keys != 0) {
+    dirty |= keys;
+    lastChange = millis();
+    flushCondition.notify_one();
   }
-  return PREF_OK;
 }
 
-String PreferencesManager::getNTPServer(void) { return ntpserver; }
+#define PREF_ACCESSORS(field, Name, key, json, type, kind, def, check, msg)   \
+  type PreferencesManager::get##Name(void) {                                   \
+    std::lock_guard<std::mutex> lock(prefsMutex);                              \
+    return settings.field;                                                     \
+  }                                                                            \
+                                                                               \
+  pref_result_t PreferencesManager::set##Name(const type &value) {             \
+    if (!check(value)) {                                                       \
+      ERROR("%s: %s\n", key, msg);                                             \
+      return PREF_ERROR;                                                       \
+    }                                                                          \
+    std::lock_guard<std::mutex> lock(prefsMutex);                              \
+    if (settings.field != value) {                                             \
+      settings.field = value;                                                  \
+      markDirty(PREF_DIRTY(PREF_KEY_##Name));                                  \
+    }                                                                          \
+    return PREF_OK;                                                            \
+  }
+PREFS_SCHEMA(PREF_ACCESSORS)
+#undef PREF_ACCESSORS
 
-pref_result_t PreferencesManager::setNTPServer(const String &ntpServer) {
-  if (ntpserver != ntpServer) {
-    ntpserver = ntpServer;
-    preferences.putString(prefs_ntpserver_key, ntpServer);
+String PreferencesManager::getTimeZone(void) {
+  zone_entry_t zone;
+  if (!zones_FindById(getTimeZoneId(), zone)) {
+    return DEFAULT_TIMEZONE;
   }
-  return PREF_OK;
+  return zone.rule;
 }
 
-String PreferencesManager::getTimeZone(void) { return timezone; }
-
-pref_result_t PreferencesManager::setTimeZone(const String &tz) {
-  if (timezone != tz) {
-    timezone = tz;
-    preferences.putString(prefs_timezone_key, tz);
+String PreferencesManager::getTimeZoneLocation(void) {
+  zone_entry_t zone;
+  if (!zones_FindById(getTimeZoneId(), zone)) {
+    return DEFAULT_TIMEZONE_LOCATION;
   }
-  return PREF_OK;
+  return zone.name;
 }
 
-String PreferencesManager::getSSID(void) { return ssid; }
-
-pref_result_t PreferencesManager::setSSID(const String &network_ssid) {
-  if (ssid != network_ssid) {
-    ssid = network_ssid;
-    preferences.putString(prefs_ssid_key, network_ssid);
+pref_result_t
+PreferencesManager::setTimeZoneLocation(const String &tz_location) {
+  zone_entry_t zone;
+  if (!zones_FindByName(tz_location.c_str(), zone)) {
+    ERROR("Unknown timezone location:%s\n", tz_location.c_str());
+    return PREF_ERROR;
   }
-  return PREF_OK;
+  return setTimeZoneId(zone.id);
 }
 
-String PreferencesManager::getPassword(void) { return password; }
+String PreferencesManager::getServerGW(void) { return DEFAULT_SERVER_GW; }
 
-pref_result_t PreferencesManager::setPassword(const String &pwd) {
-  if (password != pwd) {
-    password = pwd;
-    preferences.putString(prefs_password_key, pwd);
-  }
-  return PREF_OK;
-}
+String PreferencesManager::getServerMask(void) { return DEFAULT_SERVER_MASK; }
 
-String PreferencesManager::getTimeZoneLocation(void) {
-  return timezone_location;
+uint32_t PreferencesManager::getClockPosition(void) {
+  std::lock_guard<std::mutex> lock(prefsMutex);
+  return clock_position;
 }
 
-pref_result_t
-PreferencesManager::setTimeZoneLocation(const String &tz_location) {
-  if (timezone_location != tz_location) {
-    timezone_location = tz_location;
-    preferences.putString(prefs_timezone_location_key, tz_location);
+pref_result_t PreferencesManager::setClock(uint32_t position) {
+  std::lock_guard<std::mutex> lock(prefsMutex);
+  if (clock_position != position) {
+    clock_position = position;
+    markDirty(PREF_DIRTY(PREF_KEY_CLOCK_POSITION));
   }
   return PREF_OK;
 }
 
-bool PreferencesManager::getManualTimezone(void) { return timezone_manual; }
+void PreferencesManager::getSettings(pref_settings_t &s) {
+  std::lock_guard<std::mutex> lock(prefsMutex);
+  s = settings;
+}
 
-pref_result_t PreferencesManager::setManualTimezone(bool manual) {
-  if (timezone_manual != manual) {
-    timezone_manual = manual;
-    preferences.putBool(prefs_tz_manual_key, manual);
+pref_result_t PreferencesManager::validateSettings(const pref_settings_t &s,
+                                                   const char *&error) {
+  error = nullptr;
+#define PREF_VALIDATE(field, Name, key, json, type, kind, def, check, msg)    \
+  if (error == nullptr && !check(s.field)) {                                   \
+    error = msg;                                                               \
+  }
+  PREFS_SCHEMA(PREF_VALIDATE)
+#undef PREF_VALIDATE
+  if (error != nullptr) {
+    ERROR("%s\n", error);
+    return PREF_ERROR;
   }
   return PREF_OK;
 }
 
-int PreferencesManager::getManualTimezoneValue(void) {
-  return timezone_manual_value;
-}
+pref_result_t PreferencesManager::applySettings(const pref_settings_t &s,
+                                                const char *&error) {
+  uint32_t changed = 0;
 
-pref_result_t PreferencesManager::setManualTimezoneValue(int tz_value) {
-  if (tz_value < -12 * 60 * 60 || tz_value > 12 * 60 * 60) {
-    ERROR("Invalid timezone value:%d\n", tz_value);
+  if (validateSettings(s, error) != PREF_OK) {
     return PREF_ERROR;
   }
-  if (timezone_manual_value != tz_value) {
-    timezone_manual_value = tz_value;
-    preferences.putInt(prefs_tz_manual_value_key, tz_value);
-  }
-  return PREF_OK;
-}
-
-bool PreferencesManager::getFlipRotation(void) { return flip_rotation; }
 
-pref_result_t PreferencesManager::setFlipRotation(bool flip) {
-  if (flip_rotation != flip) {
-    flip_rotation = flip;
-    preferences.putBool(prefs_flip_rotation_key, flip);
+  // All values change at once, the flush writes them with a single commit
+  std::lock_guard<std::mutex> lock(prefsMutex);
+#define PREF_APPLY(field, Name, key, json, type, kind, def, check, msg)       \
+  if (settings.field != s.field) {                                             \
+    settings.field = s.field;                                                  \
+    changed |= PREF_DIRTY(PREF_KEY_##Name);                                    \
   }
+  PREFS_SCHEMA(PREF_APPLY)
+#undef PREF_APPLY
+  markDirty(changed);
   return PREF_OK;
 }
 
-bool PreferencesManager::getAllowBackward(void) { return allow_backward; }
-pref_result_t PreferencesManager::setAllowBackward(bool allow) {
-  if (allow_backward != allow) {
-    allow_backward = allow;
-    preferences.putBool(prefs_allow_backward_key, allow);
+int PreferencesManager::findField(const String &json_name) {
+  for (int field = 0; field < PREF_FIELDS_COUNT; field++) {
+    if (json_name == pref_json_names[field]) {
+      return field;
+    }
   }
-  return PREF_OK;
+  return -1;
 }
 
-uint32_t PreferencesManager::getStepsPerMinute(void) {
-  return steps_per_minute;
+const char *PreferencesManager::getFieldName(int field) {
+  return (field >= 0 && field < PREF_FIELDS_COUNT) ? pref_json_names[field]
+                                                   : nullptr;
 }
 
-pref_result_t PreferencesManager::setStepsPerMinute(uint32_t steps) {
-  if (steps_per_minute != steps) {
-    steps_per_minute = steps;
-    preferences.putUInt(prefs_steps_per_minute_key, steps);
+bool PreferencesManager::parseField(int field, json_type_t json_type,
+                                    const String &value, pref_settings_t &s) {
+  switch (field) {
+#define PREF_PARSE(field, Name, key, json, type, kind, def, check, msg)       \
+  case PREF_KEY_##Name:                                                        \
+    return pref_kind_##kind::fromJson(json_type, value, s.field);
+    PREFS_SCHEMA(PREF_PARSE)
+#undef PREF_PARSE
   }
-  return PREF_OK;
+  return false;
 }
 
-uint8_t PreferencesManager::getDelayTime(void) { return delay_time; }
+void PreferencesManager::writeJson(JsonWriter &json_writer,
+                                   const pref_settings_t &s) {
+#define PREF_JSON(field, Name, key, json, type, kind, def, check, msg)        \
+  pref_kind_##kind::toJson(json_writer, json, s.field);
+  PREFS_SCHEMA(PREF_JSON)
+#undef PREF_JSON
+}
 
-pref_result_t PreferencesManager::setDelayTime(uint8_t delay) {
-  if (delay < 2) {
-    ERROR("Invalid delay time:%d\n", delay);
-    return PREF_ERROR;
-  }
-  if (delay_time != delay) {
-    delay_time = delay;
-    preferences.putUChar(prefs_delay_time_key, delay_time);
+pref_result_t PreferencesManager::commit(void) {
+  std::lock_guard<std::mutex> flushLock(flushMutex);
+  pref_settings_t s;
+  uint32_t position;
+  uint32_t pending;
+
+  // Take a snapshot, the flash is written without blocking the setters
+  {
+    std::lock_guard<std::mutex> lock(prefsMutex);
+    pending = dirty;
+    if (pending == 0) {
+      return PREF_OK;
+    }
+    s = settings;
+    position = clock_position;
+    dirty = 0;
   }
-  return PREF_OK;
-}
 
-String PreferencesManager::getServerIP(void) { return server_ip; }
+  nvs_handle_t handle;
+  esp_err_t err = nvs_open(PREFS_NAMESPACE, NVS_READWRITE, &handle);
+  if (err == ESP_OK) {
+#define PREF_STORE(field, Name, key, json, type, kind, def, check, msg)       \
+  if (err == ESP_OK && (pending & PREF_DIRTY(PREF_KEY_##Name))) {              \
+    err = pref_kind_##kind::store(handle, key, s.field);                       \
+    nvs_writes++;                                                              \
+  }
+    PREFS_SCHEMA(PREF_STORE)
+#undef PREF_STORE
+    if (err == ESP_OK && (pending & PREF_DIRTY(PREF_KEY_VERSION))) {
+      err = pref_kind_U8::store(handle, prefs_version_key,
+                                PREFS_CURRENT_VERSION);
+      nvs_writes++;
+    }
+    if (err == ESP_OK && (pending & PREF_DIRTY(PREF_KEY_CLOCK_POSITION))) {
+      err = pref_kind_U32::store(handle, prefs_clock_position_key, position);
+      nvs_writes++;
+    }
+    if (err == ESP_OK) {
+      err = nvs_commit(handle);
+      nvs_commits++;
+    }
+    nvs_close(handle);
+  }
 
-pref_result_t PreferencesManager::setServerIP(const String &ip) {
-  IPAddress ipAddr;
-  if (!ipAddr.fromString(ip)) {
-    ERROR("Invalid IP address: %s\n", ip.c_str());
+  if (err != ESP_OK) {
+    ERROR("Storing settings failed:%d\n", err);
+    // Try again with the next flush
+    std::lock_guard<std::mutex> lock(prefsMutex);
+    markDirty(pending);
     return PREF_ERROR;
   }
-  if (server_ip != ip) {
-    server_ip = ip;
-    preferences.putString(prefs_server_ip_key, ip);
-  }
+  TRACE("Settings stored:%08X\n", pending);
   return PREF_OK;
 }
 
-uint32_t PreferencesManager::getClockPosition(void) { return clock_position; }
+// Writes the changes once no new ones came for PREFS_FLUSH_DELAY
+void PreferencesManager::flushTaskFunction(void *arg) {
+  ((PreferencesManager *)arg)->flushThreadFunction();
+}
 
-pref_result_t PreferencesManager::setClock(uint32_t position) {
-  if (clock_position != position) {
-    clock_position = position;
-    preferences.putUInt(prefs_clock_position_key, position);
+void PreferencesManager::flushThreadFunction(void) {
+  std::unique_lock<std::mutex> lock(prefsMutex);
+  while (true) {
+    if (dirty == 0) {
+      flushCondition.wait(lock);
+      continue;
+    }
+    unsigned long quiet = millis() - lastChange;
+    if (quiet < PREFS_FLUSH_DELAY) {
+      flushCondition.wait_for(
+          lock, std::chrono::milliseconds(PREFS_FLUSH_DELAY - quiet));
+      continue;
+    }
+    // A failed commit marks the keys dirty again and is retried later
+    lock.unlock();
+    commit();
+    lock.lock();
   }
-  return PREF_OK;
 }
 
-uint32_t PreferencesManager::getNTPUpdate(void) { return ntp_update; }
-
-pref_result_t PreferencesManager::setNTPUpdate(uint32_t update) {
-  if (ntp_update != update) {
-    ntp_update = update;
-    preferences.putUInt(prefs_ntp_timeout_key, update);
+// migrations[n] converts the settings of version n + 1 to version n + 2
+const PreferencesManager::migration_t PreferencesManager::migrations[] = {
+    &PreferencesManager::migrateTimeZoneId, // 1 -> 2
+};
+
+// Brings the stored settings to the current version in place, one version
+// at a time. Only this namespace is touched, the clock keeps its position.
+pref_result_t PreferencesManager::migrateSettings(uint8_t version) {
+  static_assert(sizeof(migrations) / sizeof(migrations[0]) ==
+                    PREFS_CURRENT_VERSION - 1,
+                "Every prefs version needs a migration");
+
+  for (; version < PREFS_CURRENT_VERSION; version++) {
+    TRACE("Migrating prefs %d -> %d\n", version, version + 1);
+    if (version == 0 || (this->*migrations[version - 1])() != PREF_OK) {
+      ERROR("Prefs migration from version %d failed, using defaults\n",
+            version);
+      preferences.clear();
+      writeInitialSettings();
+      return PREF_ERROR;
+    }
   }
+  std::lock_guard<std::mutex> lock(prefsMutex);
+  markDirty(PREF_DIRTY(PREF_KEY_VERSION));
   return PREF_OK;
 }
 
-bool PreferencesManager::getChime(void) { return chime; }
+// Version 1 stored the location and the POSIX rule as strings
+pref_result_t PreferencesManager::migrateTimeZoneId(void) {
+  static const char *timezone_location_key = "TZLocation";
+  static const char *timezone_key = "TZ";
 
-pref_result_t PreferencesManager::setChime(bool chime) {
-  if (chime != chime) {
-    chime = chime;
-    preferences.putBool(prefs_chime_key, chime);
+  if (!preferences.isKey(timezone_location_key)) {
+    return PREF_OK;
   }
+  String location = preferences.getString(timezone_location_key);
+  zone_entry_t zone;
+  if (zones_FindByName(location.c_str(), zone)) {
+    preferences.putUInt("TZId", zone.id);
+    nvs_writes++;
+    TRACE("Converted timezone location %s to id %08X\n", location.c_str(),
+          zone.id);
+  }
+  preferences.remove(timezone_location_key);
+  preferences.remove(timezone_key);
   return PREF_OK;
 }
 
-String PreferencesManager::getServerGW(void) { return server_gw; }
-
-String PreferencesManager::getServerMask(void) { return server_mask; }
-
 void PreferencesManager::writeInitialSettings(void) {
-  preferences.putUChar(prefs_version_key, PREFS_CURRENT_VERSION);
-  preferences.putString(prefs_server_hostname_key, server_hostname);
-  preferences.putString(prefs_ssid_key, ssid);
-  preferences.putString(prefs_password_key, password);
-  preferences.putString(prefs_ntpserver_key, ntpserver);
-  preferences.putString(prefs_timezone_key, timezone);
-  preferences.putUInt(prefs_ntp_timeout_key, ntp_update);
-  preferences.putString(prefs_timezone_location_key, timezone_location);
-  preferences.putBool(prefs_tz_manual_key, timezone_manual);
-  preferences.putInt(prefs_tz_manual_value_key, timezone_manual_value);
-  preferences.putBool(prefs_flip_rotation_key, flip_rotation);
-  preferences.putBool(prefs_allow_backward_key, allow_backward);
-  preferences.putUInt(prefs_steps_per_minute_key, steps_per_minute);
-  preferences.putUChar(prefs_delay_time_key, delay_time);
-  preferences.putString(prefs_server_ip_key, server_ip);
-  preferences.putUInt(prefs_clock_position_key, clock_position);
-  preferences.putBool(prefs_chime_key, chime);
+  {
+    std::lock_guard<std::mutex> lock(prefsMutex);
+    markDirty(PREF_DIRTY_ALL);
+  }
+  commit();
 }
 
 void PreferencesManager::readAllSettings() {
-  server_hostname =
-      preferences.getString(prefs_server_hostname_key, server_hostname);
-  ssid = preferences.getString(prefs_ssid_key, ssid);
-  password = preferences.getString(prefs_password_key, password);
-  ntpserver = preferences.getString(prefs_ntpserver_key, ntpserver);
-  timezone = preferences.getString(prefs_timezone_key, timezone);
-  ntp_update = preferences.getUInt(prefs_ntp_timeout_key, ntp_update);
-  timezone_location =
-      preferences.getString(prefs_timezone_location_key, timezone_location);
-  timezone_manual = preferences.getBool(prefs_tz_manual_key, timezone_manual);
-  timezone_manual_value =
-      preferences.getInt(prefs_tz_manual_value_key, timezone_manual_value);
-  flip_rotation = preferences.getBool(prefs_flip_rotation_key, flip_rotation);
-  allow_backward =
-      preferences.getBool(prefs_allow_backward_key, allow_backward);
-  steps_per_minute =
-      preferences.getUInt(prefs_steps_per_minute_key, steps_per_minute);
-  delay_time = preferences.getUChar(prefs_delay_time_key, delay_time);
-  server_ip = preferences.getString(prefs_server_ip_key, server_ip);
-  clock_position =
-      preferences.getUInt(prefs_clock_position_key, clock_position);
-  chime = preferences.getBool(prefs_chime_key, chime);
-}
-PreferencesManager::PreferencesManager() {
-  // Constructor implementation
-  preferences.begin("HC5Plus", false);
+  std::lock_guard<std::mutex> lock(prefsMutex);
+  // Keys missing from the flash keep their default, so do values an older
+  // firmware allowed
+#define PREF_LOAD(field, Name, key, json, type, kind, def, check, msg)        \
+  pref_kind_##kind::load(preferences, key, settings.field);                    \
+  if (!check(settings.field)) {                                                \
+    ERROR("%s: %s, using the default\n", key, msg);                            \
+    settings.field = def;                                                      \
+  }
+  PREFS_SCHEMA(PREF_LOAD)
+#undef PREF_LOAD
+  pref_kind_U32::load(preferences, prefs_clock_position_key, clock_position);
+}
+
+PreferencesManager::PreferencesManager() : dirty(0), lastChange(0) {
+#define PREF_DEFAULT(field, Name, key, json, type, kind, def, check, msg)     \
+  settings.field = def;
+  PREFS_SCHEMA(PREF_DEFAULT)
+#undef PREF_DEFAULT
+  clock_position = INVALID_CLOCK_POSITION;
+
+  preferences.begin(PREFS_NAMESPACE, false);
   bool prefs_init = preferences.isKey(prefs_version_key);
   if (prefs_init == true) {
     unsigned char pref_version = preferences.getUChar(prefs_version_key);
     TRACE("Prefs version:%d\n", pref_version);
 
-    if (pref_version != PREFS_CURRENT_VERSION) {
-      // ToDo conversion
-      // Wipe all for now
-      eraseAll();
-      delay(500);
-      ERROR("Rebooting....\n");
-      ESP.restart();
-    } else {
-      readAllSettings();
-      DBG(printPreferences());
+    if (pref_version < PREFS_CURRENT_VERSION) {
+      migrateSettings(pref_version);
+    } else if (pref_version > PREFS_CURRENT_VERSION) {
+      // Written by a newer firmware, keys are only ever added
+      ERROR("Prefs version %d is newer than %d\n", pref_version,
+            PREFS_CURRENT_VERSION);
     }
+    readAllSettings();
+    printPreferences();
   } else {
     TRACE("Initialize prefs\n");
     writeInitialSettings();
   }
+
+  TaskHandle_t task =
+      xTaskCreateStatic(flushTaskFunction, "prefs", PREFS_TASK_STACK_SIZE, this,
+                        PREFS_TASK_PRIORITY, prefs_stack, &prefs_task_buffer);
+  SystemMonitor::getInstance().addTask("prefs", task, PREFS_TASK_STACK_SIZE);
 }
 
 PreferencesManager::~PreferencesManager() {
   // Destructor implementation
+  commit();
   preferences.end();
 }
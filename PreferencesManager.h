@@ -1,19 +1,87 @@
 #ifndef _PREFERENCEMANAGER_H_
 #define _PREFERENCEMANAGER_H_
 
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "Zones.h"
 #include "config.h"
 #include <Preferences.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#define PREFS_FLUSH_DELAY 5000 // ms without changes before they are written
 
 typedef enum {
   PREF_OK = 0,
   PREF_ERROR = -1,
 } pref_result_t;
 
-class PreferencesManager {
-private:
-  const unsigned char PREFS_CURRENT_VERSION = 1;
+// User configurable settings, one row per value:
+// X(field, Name, key, json, type, kind, default, check, error)
+//   field   - member of pref_settings_t
+//   Name    - generates getName() and setName()
+//   key     - NVS key, json - name in the JSON config
+//   kind    - storage format: STR, BOOL, U8, U32, I32 or ZONE
+//   check   - validator, error - message when it fails
+#define PREFS_SCHEMA(X)                                                        \
+  X(hostname, HostName, "Hostname", "host_name", String, STR,                  \
+    DEFAULT_LOCALHOST_NAME, checkNotEmpty, "Invalid Host Name")                \
+  X(server_ip, ServerIP, "ServerIP", "host_ip", String, STR,                   \
+    DEFAULT_SERVER_IP, checkIP, "Invalid Host IP")                             \
+  X(ssid, SSID, "SSID", "ssid", String, STR, "", checkSSID, "Invalid SSID")    \
+  X(password, Password, "Password", "password", String, STR, "",               \
+    checkPassword, "Invalid Password")                                         \
+  X(ntpserver, NTPServer, "NtpServer", "ntp_server", String, STR,              \
+    DEFAULT_NTP_SERVER, checkNotEmpty, "Invalid NTP Server")                   \
+  X(ntp_update, NTPUpdate, "NtpTimeout", "ntp_timeout", uint32_t, U32,         \
+    DEFAULT_NTP_UPDATE, checkNTPUpdate, "Invalid NTP Timeout")                 \
+  X(timezone_id, TimeZoneId, "TZId", "timezone_location", zone_id_t, ZONE,     \
+    defaultZone(), checkZone, "Unknown TimeZone Location")                     \
+  X(timezone_manual, ManualTimezone, "TZManual", "tz_manual_en", bool, BOOL,   \
+    false, checkAny, "")                                                       \
+  X(timezone_manual_value, ManualTimezoneValue, "TZManualValue", "tz_manual",  \
+    int, I32, 0, checkTimezoneValue, "Invalid Manual Timezone Value")          \
+  X(flip_rotation, FlipRotation, "FlipRotation", "flip_rotation", bool, BOOL,  \
+    false, checkAny, "")                                                       \
+  X(allow_backward, AllowBackward, "AllowBackward", "allow_backward", bool,    \
+    BOOL, false, checkAny, "")                                                 \
+  X(chime, Chime, "Chime", "chime", bool, BOOL, true, checkAny, "")            \
+  X(jump_policy, JumpPolicy, "JumpPolicy", "jump_policy", uint8_t, U8,         \
+    JUMP_POLICY_CONFIRM, checkJumpPolicy, "Invalid Jump Policy")               \
+  X(steps_per_minute, StepsPerMinute, "StepsPm", "steps_per_minute", uint32_t, \
+    U32, 256, checkStepsPerMinute, "Invalid Steps Per Minute")                 \
+  X(delay_time, DelayTime, "DelayTime", "delay_time", uint8_t, U8, 2,          \
+    checkDelayTime, "Invalid Delay Time")
+
+#define PREF_FIELD(field, Name, key, json, type, kind, def, check, error)      \
+  type field;
+typedef struct {
+  PREFS_SCHEMA(PREF_FIELD)
+} pref_settings_t;
+#undef PREF_FIELD
+
+// Stored values, bit positions of the dirty mask
+#define PREF_KEY(field, Name, key, json, type, kind, def, check, error)        \
+  PREF_KEY_##Name,
+enum {
+  PREFS_SCHEMA(PREF_KEY)
+  PREF_FIELDS_COUNT,                       // user settings end here
+  PREF_KEY_VERSION = PREF_FIELDS_COUNT,
+  PREF_KEY_CLOCK_POSITION,
+  PREF_KEY_COUNT
+};
+#undef PREF_KEY
 
+// Settings live in RAM, setters only mark them dirty. A background task
+// writes the changes to NVS after PREFS_FLUSH_DELAY of quiet, commit()
+// writes them right away (e.g. before a restart).
+class PreferencesManager {
 public:
+  // Bump when stored keys change and add a migration
+  static constexpr uint8_t PREFS_CURRENT_VERSION = 2;
+  static constexpr const char *PREFS_NAMESPACE = "HC5Plus";
+
   static PreferencesManager &getInstance();
   PreferencesManager(const PreferencesManager &) = delete;
   PreferencesManager &operator=(const PreferencesManager &) = delete;
@@ -21,56 +89,46 @@ public:
   void printPreferences(void);
   void eraseAll(void);
 
-  String getHostName(void);
-  pref_result_t setHostName(const String &hostname);
-
-  String getNTPServer(void);
-  pref_result_t setNTPServer(const String &ntpServer);
+  void getSettings(pref_settings_t &settings);
+  // Checks all values, 'error' describes the first invalid one
+  pref_result_t validateSettings(const pref_settings_t &settings,
+                                 const char *&error);
+  // Validates all values first, then changes them together. Nothing is
+  // changed if any value is invalid.
+  pref_result_t applySettings(const pref_settings_t &settings,
+                              const char *&error);
+
+  // Field of the JSON config, -1 if unknown
+  static int findField(const String &json_name);
+  static const char *getFieldName(int field);
+  // Sets one field from a JSON value, false if the value does not fit
+  static bool parseField(int field, json_type_t type, const String &value,
+                         pref_settings_t &settings);
+  // Adds all settings as members of the current JSON object
+  static void writeJson(JsonWriter &json, const pref_settings_t &settings);
+
+#define PREF_ACCESSORS(field, Name, key, json, type, kind, def, check, error)  \
+  type get##Name(void);                                                        \
+  pref_result_t set##Name(const type &value);
+  PREFS_SCHEMA(PREF_ACCESSORS)
+#undef PREF_ACCESSORS
 
   String getTimeZone(void);
-  pref_result_t setTimeZone(const String &timezone);
-
   String getTimeZoneLocation(void);
   pref_result_t setTimeZoneLocation(const String &timezone);
 
-  bool getManualTimezone(void);
-  pref_result_t setManualTimezone(bool manual);
-
-  int getManualTimezoneValue(void);
-  pref_result_t setManualTimezoneValue(int timezone);
-
-  bool getFlipRotation(void);
-  pref_result_t setFlipRotation(bool flip);
-
-  bool getAllowBackward(void);
-  pref_result_t setAllowBackward(bool allow);
-
-  uint32_t getStepsPerMinute(void);
-  pref_result_t setStepsPerMinute(uint32_t steps);
-
-  uint8_t getDelayTime(void);
-  pref_result_t setDelayTime(uint8_t delay);
-
-  String getServerIP(void);
-  pref_result_t setServerIP(const String &ip);
-
   String getServerGW(void);
   String getServerMask(void);
 
-  String getSSID(void);
-  pref_result_t setSSID(const String &ssid);
-
-  String getPassword(void);
-  pref_result_t setPassword(const String &password);
-
   uint32_t getClockPosition(void);
   pref_result_t setClock(uint32_t position);
 
-  uint32_t getNTPUpdate(void);
-  pref_result_t setNTPUpdate(uint32_t update);
+  // Writes pending changes to the flash now
+  pref_result_t commit(void);
 
-  bool getChime(void);
-  pref_result_t setChime(bool chime);
+  // Number of values written and NVS commits since boot
+  uint32_t getNvsWrites(void) { return nvs_writes; }
+  uint32_t getNvsCommits(void) { return nvs_commits; }
 
   static const uint32_t INVALID_CLOCK_POSITION = 0xFFFFFFFF;
 
@@ -81,43 +139,25 @@ private:
   void writeInitialSettings(void);
   void readAllSettings(void);
 
-  const char *prefs_version_key = "Version" PROGMEM;
-  const char *prefs_server_hostname_key = "Hostname" PROGMEM;
-  const char *prefs_server_ip_key = "ServerIP" PROGMEM;
-  const char *prefs_ssid_key = "SSID" PROGMEM;
-  const char *prefs_password_key = "Password" PROGMEM;
-  const char *prefs_ntpserver_key = "NtpServer" PROGMEM;
-  const char *prefs_ntp_timeout_key = "NtpTimeout" PROGMEM;
-  const char *prefs_timezone_key = "TZ" PROGMEM;
-  const char *prefs_timezone_location_key = "TZLocation" PROGMEM;
-  const char *prefs_tz_manual_key = "TZManual" PROGMEM;
-  const char *prefs_tz_manual_value_key = "TZManualValue" PROGMEM;
-  const char *prefs_flip_rotation_key = "FlipRotation" PROGMEM;
-  const char *prefs_allow_backward_key = "AllowBackward" PROGMEM;
-  const char *prefs_steps_per_minute_key = "StepsPm" PROGMEM;
-  const char *prefs_delay_time_key = "DelayTime" PROGMEM;
-  const char *prefs_clock_position_key = "ClockPos" PROGMEM;
-  const char *prefs_chime_key = "Chime" PROGMEM;
-
-  String server_ip = "192.168.100.1" PROGMEM;
-  String server_gw = "192.168.100.1" PROGMEM;
-  String server_mask = "255.255.255.0" PROGMEM;
-
-  String server_hostname = DEFAULT_LOCALHOST_NAME PROGMEM;
-  String ssid = "" PROGMEM;
-  String password = "" PROGMEM;
-  String ntpserver = DEFAULT_NTP_SERVER PROGMEM;
-  String timezone = DEFAULT_TIMEZONE PROGMEM;
-  String timezone_location = DEFAULT_TIMEZONE_LOCATION PROGMEM;
-  bool timezone_manual = false;
-  int timezone_manual_value = 0;
-  bool flip_rotation = false;
-  bool allow_backward = false;
-  bool chime = true;
-  uint32_t steps_per_minute = 256;
-  uint8_t delay_time = 2;
-  uint32_t ntp_update = DEFAULT_NTP_UPDATE;
-  uint32_t clock_position = INVALID_CLOCK_POSITION;
+  typedef pref_result_t (PreferencesManager::*migration_t)(void);
+  pref_result_t migrateSettings(uint8_t version);
+  pref_result_t migrateTimeZoneId(void);
+  static const migration_t migrations[];
+  void markDirty(uint32_t keys);
+  static void flushTaskFunction(void *arg);
+  void flushThreadFunction(void);
+
+  pref_settings_t settings;
+  uint32_t clock_position;
+
+  std::atomic<uint32_t> nvs_writes{0};
+  std::atomic<uint32_t> nvs_commits{0};
+
+  uint32_t dirty;
+  unsigned long lastChange;
+  std::mutex prefsMutex; // guards the values and the dirty mask
+  std::mutex flushMutex; // one flush at a time
+  std::condition_variable flushCondition;
 
   Preferences preferences;
 };
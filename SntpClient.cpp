@@ -0,0 +1,484 @@
+#include "SntpClient.h"
+#include "BootProfiler.h"
+#include "HollowClock.h"
+#include "Logger.h"
+#include "PreferencesManager.h"
+#include "SystemMonitor.h"
+#include "TimeZone.h"
+#include "config.h"
+#include "esp_sntp.h"
+#include <WiFi.h>
+#include <lwip/netdb.h>
+#include <lwip/sockets.h>
+#include <math.h>
+#include <sys/time.h>
+
+#define TRACE(...) LOG_DEBUG(LOG_TIME, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_TIME, __VA_ARGS__)
+
+#define NTP_PACKET_SIZE 48
+#define NTP_UNIX_OFFSET 2208988800ULL // s, from 1900 to 1970
+
+static int64_t nowUs(void) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return (int64_t)now.tv_sec * 1000000 + now.tv_usec;
+}
+
+static uint32_t readU32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | p[3];
+}
+
+// NTP timestamp to us since 1970. Era 1 starts in 2036, timestamps with
+// the top bit clear belong to it.
+static int64_t readTimestamp(const uint8_t *p) {
+  uint64_t seconds = readU32(p);
+  uint64_t fraction = readU32(p + 4);
+  if (!(seconds & 0x80000000UL)) {
+    seconds += 1ULL << 32;
+  }
+  return (int64_t)(seconds - NTP_UNIX_OFFSET) * 1000000 +
+         (int64_t)((fraction * 1000000) >> 32);
+}
+
+// NTP short format, 16.16 seconds
+static int64_t readShort(const uint8_t *p) {
+  return (int64_t)(((uint64_t)readU32(p) * 1000000) >> 16);
+}
+
+SntpClient &SntpClient::getInstance() {
+  static SntpClient instance;
+  return instance;
+}
+
+SntpClient::SntpClient() : sntpTask(nullptr), serversCount(0) {
+  memset(servers, 0, sizeof(servers));
+  memset(&stats, 0, sizeof(stats));
+}
+
+void SntpClient::start(void) {
+  // lwIP keeps the servers of DHCP option 42 even with its client stopped
+  esp_sntp_servermode_dhcp(true);
+  xTaskCreate(taskFunction, "sntp", SNTP_TASK_STACK_SIZE, this,
+              SNTP_TASK_PRIORITY, &sntpTask);
+  SystemMonitor::getInstance().addTask("sntp", sntpTask, SNTP_TASK_STACK_SIZE);
+}
+
+void SntpClient::requestSync(void) {
+  if (sntpTask != nullptr) {
+    xTaskNotifyGive(sntpTask);
+  }
+}
+
+void SntpClient::getStats(sntp_stats_t &s) {
+  std::lock_guard<std::mutex> lock(sntpMutex);
+  s = stats;
+}
+
+size_t SntpClient::getServers(sntp_server_t *list, size_t max) {
+  std::lock_guard<std::mutex> lock(sntpMutex);
+  size_t count = (serversCount < max) ? serversCount : max;
+  memcpy(list, servers, count * sizeof(sntp_server_t));
+  return count;
+}
+
+// Failed polls are retried with an exponential backoff up to the update
+// interval, a sync request starts over with the shortest one
+void SntpClient::taskFunction(void *arg) {
+  SntpClient *client = (SntpClient *)arg;
+  uint64_t retry = SNTP_RETRY_INTERVAL;
+
+  while (true) {
+    uint64_t update = PreferencesManager::getInstance().getNTPUpdate();
+    update = constrain(update, 15ULL, (uint64_t)MAX_NTP_UPDATE) * 1000;
+    uint64_t interval = update;
+    if (client->poll()) {
+      retry = SNTP_RETRY_INTERVAL;
+    } else {
+      interval = (retry < update) ? retry : update;
+      retry = (retry * 2 < update) ? retry * 2 : update;
+    }
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(interval)) > 0) {
+      retry = SNTP_RETRY_INTERVAL;
+    }
+  }
+}
+
+void SntpClient::addServer(sntp_server_t *list, uint8_t &count,
+                           const char *name, uint16_t port) {
+  if (count >= SNTP_SERVERS_MAX || *name == '\0') {
+    return;
+  }
+  for (int i = 0; i < count; i++) {
+    if (list[i].port == port && strcmp(list[i].name, name) == 0) {
+      return;
+    }
+  }
+  sntp_server_t &server = list[count++];
+  memset(&server, 0, sizeof(server));
+  snprintf(server.name, sizeof(server.name), "%s", name);
+  server.port = port;
+  // Keep the reachability of servers that stay in the list
+  for (int i = 0; i < serversCount; i++) {
+    if (servers[i].port == port && strcmp(servers[i].name, name) == 0) {
+      server.reach = servers[i].reach;
+    }
+  }
+}
+
+// The configured server first, then the one from DHCP and the pool. The
+// configured name may carry a port, e.g. for a local test server.
+void SntpClient::setupServers(void) {
+  static const char *const pool[] = SNTP_POOL_SERVERS;
+  sntp_server_t list[SNTP_SERVERS_MAX];
+  uint8_t count = 0;
+  char name[sizeof(list[0].name)];
+  uint16_t port = SNTP_PORT;
+
+  String configured = PreferencesManager::getInstance().getNTPServer();
+  int colon = configured.lastIndexOf(':');
+  if (colon > 0) {
+    port = configured.substring(colon + 1).toInt();
+    configured = configured.substring(0, colon);
+  }
+  addServer(list, count, configured.c_str(), port ? port : SNTP_PORT);
+
+  const ip_addr_t *dhcp = esp_sntp_getserver(0);
+  if (dhcp != nullptr && IP_IS_V4(dhcp) && !ip_addr_isany(dhcp)) {
+    uint32_t address = ip_2_ip4(dhcp)->addr;
+    snprintf(name, sizeof(name), "%u.%u.%u.%u", address & 0xFF,
+             (address >> 8) & 0xFF, (address >> 16) & 0xFF, address >> 24);
+    addServer(list, count, name, SNTP_PORT);
+  }
+
+  for (const char *server : pool) {
+    addServer(list, count, server, SNTP_PORT);
+  }
+
+  std::lock_guard<std::mutex> lock(sntpMutex);
+  memcpy(servers, list, count * sizeof(sntp_server_t));
+  serversCount = count;
+  stats.servers = count;
+}
+
+// Names are resolved again on every poll, the pool rotates its addresses
+void SntpClient::resolveServers(void) {
+  uint32_t addresses[SNTP_SERVERS_MAX];
+  struct addrinfo hints;
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_DGRAM;
+  for (int i = 0; i < serversCount; i++) {
+    struct addrinfo *result = nullptr;
+    addresses[i] = 0;
+    if (getaddrinfo(servers[i].name, nullptr, &hints, &result) == 0 &&
+        result != nullptr) {
+      addresses[i] =
+          ((struct sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
+    } else {
+      ERROR("SNTP: cannot resolve %s\n", servers[i].name);
+    }
+    if (result != nullptr) {
+      freeaddrinfo(result);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(sntpMutex);
+  for (int i = 0; i < serversCount; i++) {
+    servers[i].address = addresses[i];
+  }
+}
+
+// Client mode, version 4. The transmit timestamp is random and the local
+// time is kept here, which also matches the reply to the request.
+void SntpClient::sendRequests(int sock, const sntp_server_t *servers,
+                              uint8_t count, sntp_request_t *requests) {
+  uint8_t packet[NTP_PACKET_SIZE];
+
+  for (int i = 0; i < count; i++) {
+    if (servers[i].address == 0) {
+      continue;
+    }
+    struct sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(servers[i].port);
+    to.sin_addr.s_addr = servers[i].address;
+
+    uint32_t cookie[2] = {esp_random(), esp_random()};
+    memcpy(requests[i].cookie, cookie, sizeof(requests[i].cookie));
+    memset(packet, 0, sizeof(packet));
+    packet[0] = (4 << 3) | 3;
+    memcpy(packet + 40, requests[i].cookie, sizeof(requests[i].cookie));
+    requests[i].sent = nowUs();
+    sendto(sock, packet, sizeof(packet), 0, (struct sockaddr *)&to,
+           sizeof(to));
+  }
+}
+
+void SntpClient::receiveReplies(int sock, const sntp_server_t *servers,
+                                uint8_t count, const sntp_request_t *requests,
+                                sntp_sample_t samples[][SNTP_BURST],
+                                uint8_t *samples_count) {
+  uint8_t packet[NTP_PACKET_SIZE];
+  bool answered[SNTP_SERVERS_MAX] = {};
+  int expected = 0;
+  unsigned long start = millis();
+
+  for (int i = 0; i < count; i++) {
+    expected += (servers[i].address != 0);
+  }
+
+  while (expected > 0 && millis() - start < SNTP_TIMEOUT) {
+    uint32_t left = SNTP_TIMEOUT - (millis() - start);
+    struct timeval tv = {(time_t)(left / 1000),
+                         (suseconds_t)((left % 1000) * 1000)};
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(sock, &fds);
+    if (select(sock + 1, &fds, nullptr, nullptr, &tv) <= 0) {
+      break;
+    }
+
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+    int len = recvfrom(sock, packet, sizeof(packet), 0,
+                       (struct sockaddr *)&from, &from_len);
+    int64_t received = nowUs();
+    if (len < NTP_PACKET_SIZE) {
+      continue;
+    }
+
+    int i = 0;
+    while (i < count &&
+           (answered[i] || servers[i].address != from.sin_addr.s_addr ||
+            servers[i].port != ntohs(from.sin_port) ||
+            memcmp(packet + 24, requests[i].cookie, 8) != 0)) {
+      i++;
+    }
+    if (i == count) {
+      continue; // late or forged
+    }
+    answered[i] = true;
+    expected--;
+
+    // Server mode, synchronized, and no kiss-o'-death
+    uint8_t leap = packet[0] >> 6;
+    uint8_t mode = packet[0] & 0x07;
+    uint8_t stratum = packet[1];
+    if (mode != 4 || leap == 3 || stratum == 0 || stratum > 15 ||
+        readU32(packet + 40) == 0) {
+      ERROR("SNTP: %s is not usable\n", servers[i].name);
+      continue;
+    }
+
+    int64_t t2 = readTimestamp(packet + 32);
+    int64_t t3 = readTimestamp(packet + 40);
+    sntp_sample_t &sample = samples[i][samples_count[i]++];
+    sample.offset = ((t2 - requests[i].sent) + (t3 - received)) / 2;
+    sample.delay = (received - requests[i].sent) - (t3 - t2);
+    if (sample.delay < 0) {
+      sample.delay = 0;
+    }
+    sample.root = readShort(packet + 4) / 2 + readShort(packet + 8);
+    sample.stratum = stratum;
+  }
+}
+
+// Like the NTP clock filter, the sample with the lowest delay has the
+// least asymmetry and is the one used
+void SntpClient::filterSamples(sntp_server_t &server,
+                               const sntp_sample_t *samples, uint8_t count) {
+  server.valid = false;
+  server.selected = false;
+  if (count == 0) {
+    return;
+  }
+
+  const sntp_sample_t *best = &samples[0];
+  for (int i = 1; i < count; i++) {
+    if (samples[i].delay < best->delay) {
+      best = &samples[i];
+    }
+  }
+
+  double sum = 0;
+  for (int i = 0; i < count; i++) {
+    double diff = samples[i].offset - best->offset;
+    sum += diff * diff;
+  }
+  server.offset = best->offset;
+  server.delay = best->delay;
+  server.jitter = (count > 1) ? sqrt(sum / (count - 1)) : 0;
+  server.distance = best->delay / 2 + best->root + server.jitter;
+  server.valid = server.distance <= SNTP_MAX_DISTANCE;
+}
+
+// Marzullo's algorithm: finds the offset range most servers agree on.
+// Only the servers overlapping it are combined, weighted by their
+// distance. Without a majority, e.g. two servers that disagree, none of
+// them can be told from a falseticker and the clock keeps its time.
+bool SntpClient::selectServers(sntp_server_t *servers, uint8_t count,
+                               int64_t &offset, sntp_stats_t &stats) {
+  struct {
+    int64_t value;
+    int type; // -1 start, +1 end, starts sort first
+  } edges[2 * SNTP_SERVERS_MAX];
+  int edges_count = 0;
+  int candidates = 0;
+
+  for (int i = 0; i < count; i++) {
+    if (servers[i].valid) {
+      edges[edges_count++] = {servers[i].offset - servers[i].distance, -1};
+      edges[edges_count++] = {servers[i].offset + servers[i].distance, 1};
+      candidates++;
+    }
+  }
+  for (int i = 1; i < edges_count; i++) {
+    for (int j = i; j > 0 &&
+                    (edges[j].value < edges[j - 1].value ||
+                     (edges[j].value == edges[j - 1].value &&
+                      edges[j].type < edges[j - 1].type));
+         j--) {
+      std::swap(edges[j], edges[j - 1]);
+    }
+  }
+
+  int overlap = 0, best = 0;
+  int64_t low = 0, high = 0;
+  for (int i = 0; i < edges_count; i++) {
+    overlap -= edges[i].type;
+    if (overlap > best) {
+      best = overlap;
+      low = edges[i].value;
+      high = edges[i + 1].value; // a start is always followed by an edge
+    }
+  }
+  stats.selected = 0;
+  if (best == 0) {
+    return false;
+  }
+  if (best * 2 <= candidates) {
+    ERROR("SNTP: no majority among %d servers, time kept\n", candidates);
+    stats.disagreements++;
+    return false;
+  }
+
+  double weights = 0, sum = 0;
+  int64_t best_distance = INT64_MAX;
+  for (int i = 0; i < count; i++) {
+    sntp_server_t &server = servers[i];
+    server.selected = server.valid &&
+                      server.offset - server.distance <= high &&
+                      server.offset + server.distance >= low;
+    if (server.selected) {
+      double weight = 1.0 / (server.distance + 1);
+      weights += weight;
+      sum += weight * server.offset;
+      if (server.distance < best_distance) {
+        best_distance = server.distance;
+        stats.delay = server.delay;
+      }
+      stats.selected++;
+    }
+  }
+  offset = (int64_t)(sum / weights);
+
+  double spread = 0;
+  for (int i = 0; i < count; i++) {
+    if (servers[i].selected) {
+      double diff = servers[i].offset - offset;
+      spread += diff * diff;
+    }
+  }
+  stats.jitter = sqrt(spread / stats.selected);
+  return true;
+}
+
+// Small offsets are slewed so the hands never jump, large ones and the
+// first update step the clock
+void SntpClient::adjustClock(int64_t offset) {
+  bool step;
+  {
+    std::lock_guard<std::mutex> lock(sntpMutex);
+    step = !stats.synced || llabs(offset) >= SNTP_STEP_THRESHOLD;
+    stats.synced = true;
+    stats.offset = offset;
+    if (step) {
+      stats.steps++;
+    } else {
+      stats.slews++;
+    }
+  }
+
+  if (step) {
+    int64_t time_us = nowUs() + offset;
+    struct timeval tv = {(time_t)(time_us / 1000000),
+                         (suseconds_t)(time_us % 1000000)};
+    settimeofday(&tv, NULL);
+  } else {
+    struct timeval delta = {(time_t)(offset / 1000000),
+                            (suseconds_t)(offset % 1000000)};
+    adjtime(&delta, NULL);
+  }
+  TRACE("SNTP: %s %lld us\n", step ? "stepped" : "slewing",
+        (long long)offset);
+
+  int64_t offset_ms = offset / 1000;
+  HollowClock &hclock = HollowClock::getInstance();
+  hclock.notifyTimeSync((int32_t)constrain(offset_ms, INT32_MIN, INT32_MAX));
+  BootProfiler::getInstance().mark(BOOT_PHASE_NTP);
+  struct tm timeinfo;
+  char time_str[6];
+  TimeZone::getInstance().localTime(time(nullptr), timeinfo);
+  strftime(time_str, sizeof(time_str), "%I:%M", &timeinfo);
+  hclock.setLastSyncedTime(time_str);
+}
+
+// One burst to all servers, returns true if the clock was updated
+bool SntpClient::poll(void) {
+  sntp_sample_t samples[SNTP_SERVERS_MAX][SNTP_BURST];
+  sntp_request_t requests[SNTP_SERVERS_MAX];
+  uint8_t count[SNTP_SERVERS_MAX] = {};
+
+  if (WiFi.status() != WL_CONNECTED) {
+    return false;
+  }
+  setupServers();
+  resolveServers();
+
+  int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (sock < 0) {
+    ERROR("SNTP: no socket\n");
+    return false;
+  }
+  for (int round = 0; round < SNTP_BURST; round++) {
+    if (round > 0) {
+      vTaskDelay(pdMS_TO_TICKS(SNTP_BURST_INTERVAL));
+    }
+    sendRequests(sock, servers, serversCount, requests);
+    receiveReplies(sock, servers, serversCount, requests, samples, count);
+  }
+  close(sock);
+
+  int64_t offset;
+  bool selected;
+  {
+    std::lock_guard<std::mutex> lock(sntpMutex);
+    stats.polls++;
+    for (int i = 0; i < serversCount; i++) {
+      servers[i].reach = (servers[i].reach << 1) | (count[i] > 0);
+      if (count[i] > 0) {
+        servers[i].stratum = samples[i][count[i] - 1].stratum;
+      }
+      filterSamples(servers[i], samples[i], count[i]);
+    }
+    selected = selectServers(servers, serversCount, offset, stats);
+  }
+  if (selected) {
+    adjustClock(offset);
+  }
+  return selected;
+}
@@ -0,0 +1,109 @@
+#ifndef _SNTP_CLIENT_H_
+#define _SNTP_CLIENT_H_
+
+#include <Arduino.h>
+#include <mutex>
+
+#define SNTP_SERVERS_MAX 5
+#define SNTP_PORT 123
+#define SNTP_BURST 4                // samples per server and poll
+#define SNTP_BURST_INTERVAL 2000    // ms between the samples of a burst
+#define SNTP_TIMEOUT 1000           // ms to wait for the replies of a round
+#define SNTP_RETRY_INTERVAL 15000   // ms, first retry, doubles up to the update
+#define SNTP_STEP_THRESHOLD 128000  // us, smaller offsets are slewed
+#define SNTP_MAX_DISTANCE 1500000   // us, servers further away are ignored
+#define SNTP_POOL_SERVERS                                                      \
+  {"0.pool.ntp.org", "1.pool.ntp.org", "2.pool.ntp.org"}
+
+typedef struct {
+  int64_t offset; // us, server minus local time
+  int64_t delay;  // us, round trip
+  int64_t root;   // us, error of the server against its reference
+  uint8_t stratum;
+} sntp_sample_t;
+
+// One request in flight, the reply has to echo the random cookie
+typedef struct {
+  uint8_t cookie[8];
+  int64_t sent; // us, local time the request left
+} sntp_request_t;
+
+typedef struct {
+  char name[64];
+  uint16_t port;
+  uint32_t address; // IPv4 in network order, 0 if it did not resolve
+  uint8_t stratum;
+  uint8_t reach;    // one bit per poll, set if the server answered
+  int64_t offset;   // us, of the sample with the lowest delay
+  int64_t delay;    // us
+  int64_t jitter;   // us, RMS of the other samples against the chosen one
+  int64_t distance; // us, half the delay plus the server's own error
+  bool valid;       // has a filtered sample from the last poll
+  bool selected;    // agrees with the majority and was used
+} sntp_server_t;
+
+typedef struct {
+  bool synced;
+  int64_t offset; // us, combined offset of the selected servers
+  int64_t delay;  // us, of the best selected server
+  int64_t jitter; // us, spread of the selected servers
+  uint32_t polls;
+  uint32_t steps;
+  uint32_t slews;
+  uint32_t disagreements; // polls without a majority, the time was kept
+  uint8_t servers;
+  uint8_t selected;
+} sntp_stats_t;
+
+// Polls several NTP servers at once from its own task. Each server's
+// burst goes through a clock filter, the servers that agree are combined
+// and small offsets are slewed with adjtime() instead of stepping.
+class SntpClient {
+
+public:
+  static SntpClient &getInstance();
+  SntpClient(const SntpClient &) = delete;
+  SntpClient &operator=(const SntpClient &) = delete;
+
+  void start(void);
+  // Polls now instead of at the next interval
+  void requestSync(void);
+  void getStats(sntp_stats_t &stats);
+  // Copies the server states, returns the number of servers
+  size_t getServers(sntp_server_t *servers, size_t max);
+
+  // The steps of a poll on a list of servers
+  static void sendRequests(int sock, const sntp_server_t *servers,
+                           uint8_t count, sntp_request_t *requests);
+  static void receiveReplies(int sock, const sntp_server_t *servers,
+                             uint8_t count, const sntp_request_t *requests,
+                             sntp_sample_t samples[][SNTP_BURST],
+                             uint8_t *samples_count);
+  static void filterSamples(sntp_server_t &server,
+                            const sntp_sample_t *samples, uint8_t count);
+  // Marks the servers that agree and combines their offsets, fills in
+  // the selected count, delay and jitter of the stats. False if no server
+  // is usable or they have no majority.
+  static bool selectServers(sntp_server_t *servers, uint8_t count,
+                            int64_t &offset, sntp_stats_t &stats);
+
+private:
+  SntpClient();
+  ~SntpClient() = default;
+
+  static void taskFunction(void *arg);
+  void setupServers(void);
+  void addServer(sntp_server_t *list, uint8_t &count, const char *name,
+                 uint16_t port);
+  bool poll(void);
+  void resolveServers(void);
+  void adjustClock(int64_t offset);
+
+  TaskHandle_t sntpTask;
+  std::mutex sntpMutex;
+  sntp_server_t servers[SNTP_SERVERS_MAX];
+  uint8_t serversCount;
+  sntp_stats_t stats;
+};
+
+#endif
@@ -1,16 +1,12 @@
 // filepath: /Users/poopi/Documents/Arduino/HollowClock5Plus/SoundPlayer.cpp
 #include "SoundPlayer.h"
+#include "Logger.h"
 #include "MotorControl.h"
 #include "config.h"
 #include "pitches.h"
 
-#if DEBUG_SOUND
-#define TRACE(...) Serial.printf(__VA_ARGS__)
-#define ERROR(...) Serial.printf(__VA_ARGS__)
-#else
-#define TRACE(...)
-#define ERROR(...)
-#endif
+#define TRACE(...) LOG_DEBUG(LOG_SOUND, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_SOUND, __VA_ARGS__)
 
 // Musics taken from https://github.com/robsoncouto/arduino-songs
 
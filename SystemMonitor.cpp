@@ -0,0 +1,194 @@
+#include "SystemMonitor.h"
+#include "Logger.h"
+#include "config.h"
+
+#define TRACE(...) LOG_DEBUG(LOG_MAIN, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_MAIN, __VA_ARGS__)
+
+static const char *const alert_names[MONITOR_ALERT_COUNT] = {
+    "stack", "heap", "fragmentation", "leak"};
+
+SystemMonitor &SystemMonitor::getInstance() {
+  static SystemMonitor instance;
+  return instance;
+}
+
+SystemMonitor::SystemMonitor()
+    : task_count(0), history_next(0), history_count(0), heap_sum(0),
+      heap_samples(0), last_sample(0), last_history(0) {
+  memset(tasks, 0, sizeof(tasks));
+  memset(&stats, 0, sizeof(stats));
+  memset(history, 0, sizeof(history));
+}
+
+void SystemMonitor::addTask(const char *name, TaskHandle_t handle,
+                            uint32_t stack_size) {
+  std::lock_guard<std::mutex> lock(monitorMutex);
+  if (handle == nullptr || task_count >= MONITOR_TASKS_MAX) {
+    ERROR("Task %s not monitored\n", name);
+    return;
+  }
+  tasks[task_count++] = {name, handle, stack_size, stack_size};
+}
+
+void SystemMonitor::process(void) {
+  unsigned long now = millis();
+  // Nothing is sampled before the first call
+  if (stats.heap_free == 0 || now - last_sample >= MONITOR_SAMPLE_INTERVAL) {
+    last_sample = now;
+    sample();
+  }
+}
+
+void SystemMonitor::sample(void) {
+  std::lock_guard<std::mutex> lock(monitorMutex);
+  uint32_t alerts = 0;
+
+  for (size_t i = 0; i < task_count; i++) {
+    monitor_task_t &task = tasks[i];
+    task.stack_free = uxTaskGetStackHighWaterMark(task.handle);
+    if (task.stack_free < MONITOR_STACK_MIN) {
+      alerts |= 1 << MONITOR_ALERT_STACK;
+    }
+  }
+
+  stats.heap_free = ESP.getFreeHeap();
+  stats.heap_min_free = ESP.getMinFreeHeap();
+  stats.heap_largest = ESP.getMaxAllocHeap();
+  stats.fragmentation =
+      (stats.heap_free > 0 && stats.heap_largest < stats.heap_free)
+          ? 100 - (uint64_t)stats.heap_largest * 100 / stats.heap_free
+          : 0;
+  if (stats.heap_free < MONITOR_HEAP_MIN) {
+    alerts |= 1 << MONITOR_ALERT_HEAP;
+  }
+  if (stats.fragmentation > MONITOR_FRAGMENTATION_MAX) {
+    alerts |= 1 << MONITOR_ALERT_FRAGMENTATION;
+  }
+
+  heap_sum += stats.heap_free;
+  heap_samples++;
+  if (millis() - last_history >= MONITOR_HISTORY_INTERVAL) {
+    last_history = millis();
+    history[history_next] = heap_sum / heap_samples;
+    history_next = (history_next + 1) % MONITOR_HISTORY;
+    if (history_count < MONITOR_HISTORY) {
+      history_count++;
+    }
+    heap_sum = 0;
+    heap_samples = 0;
+    updateTrend();
+  }
+  if (stats.hours_left > 0 && stats.hours_left < MONITOR_EXHAUSTION_HOURS) {
+    alerts |= 1 << MONITOR_ALERT_LEAK;
+  }
+  raiseAlerts(alerts);
+}
+
+// Least squares slope of the hourly averages, the first hour of a boot is
+// left out, it still allocates
+void SystemMonitor::updateTrend(void) {
+  size_t count = history_count;
+  size_t first = (history_next + MONITOR_HISTORY - count) % MONITOR_HISTORY;
+  if (count < MONITOR_HISTORY) {
+    first = (first + 1) % MONITOR_HISTORY;
+    count--;
+  }
+  if (count < MONITOR_TREND_MIN_SAMPLES) {
+    stats.heap_trend = 0;
+    stats.hours_left = 0;
+    return;
+  }
+
+  double sum_x = 0, sum_y = 0, sum_xy = 0, sum_xx = 0;
+  for (size_t i = 0; i < count; i++) {
+    double y = history[(first + i) % MONITOR_HISTORY];
+    sum_x += i;
+    sum_y += y;
+    sum_xy += i * y;
+    sum_xx += (double)i * i;
+  }
+  double slope = (count * sum_xy - sum_x * sum_y) /
+                 (count * sum_xx - sum_x * sum_x);
+  stats.heap_trend = (int32_t)slope;
+  stats.hours_left =
+      (stats.heap_trend < 0) ? stats.heap_free / -stats.heap_trend + 1 : 0;
+}
+
+// Called with monitorMutex held, logs the alerts when they come and go
+void SystemMonitor::raiseAlerts(uint32_t alerts) {
+  uint32_t raised = alerts & ~stats.alerts;
+  uint32_t cleared = stats.alerts & ~alerts;
+  for (int i = 0; i < MONITOR_ALERT_COUNT; i++) {
+    if (raised & (1 << i)) {
+      stats.alert_count++;
+      ERROR("Alert %s: heap %lu free, %lu largest, trend %ld B/h\n",
+            alert_names[i], (unsigned long)stats.heap_free,
+            (unsigned long)stats.heap_largest, (long)stats.heap_trend);
+    } else if (cleared & (1 << i)) {
+      TRACE("Alert %s cleared\n", alert_names[i]);
+    }
+  }
+  for (size_t i = 0; i < task_count && (raised & 1 << MONITOR_ALERT_STACK);
+       i++) {
+    if (tasks[i].stack_free < MONITOR_STACK_MIN) {
+      ERROR("Task %s: %lu of %lu bytes stack never used\n", tasks[i].name,
+            (unsigned long)tasks[i].stack_free,
+            (unsigned long)tasks[i].stack_size);
+    }
+  }
+  stats.alerts = alerts;
+}
+
+void SystemMonitor::getStats(monitor_stats_t &stats) {
+  std::lock_guard<std::mutex> lock(monitorMutex);
+  stats = this->stats;
+}
+
+size_t SystemMonitor::getTasks(monitor_task_t *tasks, size_t max) {
+  std::lock_guard<std::mutex> lock(monitorMutex);
+  size_t count = (task_count < max) ? task_count : max;
+  memcpy(tasks, this->tasks, count * sizeof(monitor_task_t));
+  return count;
+}
+
+void SystemMonitor::writeJson(JsonWriter &json) {
+  std::lock_guard<std::mutex> lock(monitorMutex);
+  json.add("heap_free", stats.heap_free);
+  json.add("heap_min_free", stats.heap_min_free);
+  json.add("heap_largest", stats.heap_largest);
+  json.add("fragmentation", (unsigned int)stats.fragmentation);
+  json.add("heap_trend", (int)stats.heap_trend);
+  json.add("hours_left", stats.hours_left);
+  json.add("alert_count", stats.alert_count);
+  json.beginArray("alerts");
+  for (int i = 0; i < MONITOR_ALERT_COUNT; i++) {
+    if (stats.alerts & (1 << i)) {
+      json.add(alert_names[i]);
+    }
+  }
+  json.endArray();
+
+  json.beginArray("tasks");
+  for (size_t i = 0; i < task_count; i++) {
+    json.beginObject();
+    json.add("name", tasks[i].name);
+    json.add("stack_size", tasks[i].stack_size);
+    json.add("stack_free", tasks[i].stack_free);
+    json.endObject();
+  }
+  json.endArray();
+
+  // Oldest first
+  json.beginArray("heap_history");
+  for (size_t i = 0; i < history_count; i++) {
+    json.add((long long)history[(history_next + MONITOR_HISTORY -
+                                 history_count + i) %
+                                MONITOR_HISTORY]);
+  }
+  json.endArray();
+}
+
+const char *SystemMonitor::getAlertName(monitor_alert_t alert) {
+  return alert < MONITOR_ALERT_COUNT ? alert_names[alert] : "unknown";
+}
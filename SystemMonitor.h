@@ -0,0 +1,85 @@
+#ifndef _SYSTEM_MONITOR_H_
+#define _SYSTEM_MONITOR_H_
+
+#include "JsonWriter.h"
+#include <Arduino.h>
+#include <mutex>
+
+#define MONITOR_TASKS_MAX 8
+#define MONITOR_SAMPLE_INTERVAL 10000     // ms
+#define MONITOR_HISTORY 48                // hourly heap averages
+#define MONITOR_HISTORY_INTERVAL 3600000  // ms
+#define MONITOR_TREND_MIN_SAMPLES 6       // hours before a trend counts
+#define MONITOR_STACK_MIN 512             // bytes of stack never used
+#define MONITOR_HEAP_MIN 16384            // bytes
+#define MONITOR_FRAGMENTATION_MAX 70      // % of the free heap not in a block
+#define MONITOR_EXHAUSTION_HOURS (24 * 7) // alert when the trend ends sooner
+
+typedef enum {
+  MONITOR_ALERT_STACK = 0,     // a task came close to its stack end
+  MONITOR_ALERT_HEAP,          // little free heap left
+  MONITOR_ALERT_FRAGMENTATION, // the largest block is small for the free heap
+  MONITOR_ALERT_LEAK,          // the heap shrinks and runs out within a week
+  MONITOR_ALERT_COUNT
+} monitor_alert_t;
+
+typedef struct {
+  const char *name;
+  TaskHandle_t handle;
+  uint32_t stack_size; // bytes
+  uint32_t stack_free; // bytes never used, the high-water mark
+} monitor_task_t;
+
+typedef struct {
+  uint32_t heap_free;
+  uint32_t heap_min_free; // lowest since boot
+  uint32_t heap_largest;  // largest block that can be allocated
+  uint8_t fragmentation;  // % of the free heap outside the largest block
+  int32_t heap_trend;     // bytes per hour over the history
+  uint32_t hours_left;    // until the trend empties the heap, 0 if it grows
+  uint32_t alerts;        // bits of monitor_alert_t
+  uint32_t alert_count;   // alerts raised since boot
+} monitor_stats_t;
+
+// Samples the stack high-water marks of the tasks and the heap, keeps the
+// hourly heap averages of the last two days and raises alerts before the
+// stacks or the heap run out. A leak shows as a falling trend long before
+// the allocations fail.
+class SystemMonitor {
+
+public:
+  static SystemMonitor &getInstance();
+  SystemMonitor(const SystemMonitor &) = delete;
+  SystemMonitor &operator=(const SystemMonitor &) = delete;
+
+  void addTask(const char *name, TaskHandle_t handle, uint32_t stack_size);
+  // Called from loop(), samples every MONITOR_SAMPLE_INTERVAL
+  void process(void);
+  void getStats(monitor_stats_t &stats);
+  // Copies the tasks, returns their number
+  size_t getTasks(monitor_task_t *tasks, size_t max);
+  void writeJson(JsonWriter &json);
+  static const char *getAlertName(monitor_alert_t alert);
+
+private:
+  SystemMonitor();
+  ~SystemMonitor() = default;
+
+  void sample(void);
+  void updateTrend(void);
+  void raiseAlerts(uint32_t alerts);
+
+  std::mutex monitorMutex;
+  monitor_task_t tasks[MONITOR_TASKS_MAX];
+  size_t task_count;
+  monitor_stats_t stats;
+  uint32_t history[MONITOR_HISTORY]; // hourly averages of the free heap
+  uint8_t history_next;
+  uint8_t history_count;
+  uint64_t heap_sum; // samples of the current hour
+  uint32_t heap_samples;
+  unsigned long last_sample;
+  unsigned long last_history;
+};
+
+#endif
@@ -0,0 +1,335 @@
+#include "TimeZone.h"
+#include "Logger.h"
+#include "config.h"
+
+#define TRACE(...) LOG_DEBUG(LOG_TIME, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_TIME, __VA_ARGS__)
+
+#define SECONDS_PER_DAY 86400L
+#define TZ_DEFAULT_TIME 7200       // 02:00 local when a rule has no time
+#define TZ_MAX_TIME (167 * 3600L)  // RFC 8536 allows transitions +-167 h
+#define TZ_MAX_OFFSET (25 * 3600L) // POSIX offsets are at most 24:59:59
+// Used by glibc when a DST name is given without rules
+#define TZ_DEFAULT_START "M3.2.0"
+#define TZ_DEFAULT_END "M11.1.0"
+
+static bool isLeap(int year) {
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int monthDays(int year, int month) {
+  static const uint8_t days[12] = {31, 28, 31, 30, 31, 30,
+                                   31, 31, 30, 31, 30, 31};
+  return days[month - 1] + (month == 2 && isLeap(year) ? 1 : 0);
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date
+static int64_t daysFromCivil(int year, int month, int day) {
+  year -= month <= 2;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t yoe = year - era * 400;
+  int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+// Proleptic Gregorian date of the days since 1970-01-01, month is 1..12
+static void civilFromDays(int64_t days, int &year, int &month, int &day) {
+  days += 719468;
+  int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  int64_t doe = days - era * 146097;
+  int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  int64_t mp = (5 * doy + 2) / 153;
+  day = (int)(doy - (153 * mp + 2) / 5 + 1);
+  month = (int)(mp < 10 ? mp + 3 : mp - 9);
+  year = (int)(yoe + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+static int64_t floorDiv(int64_t a, int64_t b) {
+  return a / b - (a % b != 0 && (a < 0) != (b < 0) ? 1 : 0);
+}
+
+static const char *parseNumber(const char *p, long min, long max,
+                               long &value) {
+  if (!isdigit((unsigned char)*p)) {
+    return nullptr;
+  }
+  value = 0;
+  while (isdigit((unsigned char)*p)) {
+    value = value * 10 + (*p++ - '0');
+    if (value > max) {
+      return nullptr;
+    }
+  }
+  return value < min ? nullptr : p;
+}
+
+// Plain names are letters only, quoted ones may contain digits and signs
+static const char *parseName(const char *p, char *name) {
+  const char *begin = p;
+  const char *end;
+  if (*p == '<') {
+    begin = ++p;
+    while (isalnum((unsigned char)*p) || *p == '+' || *p == '-') {
+      p++;
+    }
+    if (*p != '>') {
+      return nullptr;
+    }
+    end = p++;
+  } else {
+    while (isalpha((unsigned char)*p)) {
+      p++;
+    }
+    end = p;
+  }
+  if (end - begin < 3) {
+    return nullptr;
+  }
+  size_t len = end - begin;
+  if (len > TZ_NAME_MAX - 1) {
+    len = TZ_NAME_MAX - 1;
+  }
+  memcpy(name, begin, len);
+  name[len] = '\0';
+  return p;
+}
+
+// [+|-]hh[:mm[:ss]], in seconds
+static const char *parseTime(const char *p, long max, int32_t &seconds) {
+  bool negative = *p == '-';
+  if (*p == '+' || *p == '-') {
+    p++;
+  }
+  long hours, minutes = 0, secs = 0;
+  p = parseNumber(p, 0, max / 3600, hours);
+  if (p && *p == ':') {
+    p = parseNumber(p + 1, 0, 59, minutes);
+    if (p && *p == ':') {
+      p = parseNumber(p + 1, 0, 59, secs);
+    }
+  }
+  if (!p) {
+    return nullptr;
+  }
+  seconds = hours * 3600 + minutes * 60 + secs;
+  if (negative) {
+    seconds = -seconds;
+  }
+  return p;
+}
+
+static const char *parseDate(const char *p, tz_date_t &date) {
+  long value = 0;
+  if (*p == 'J') {
+    date.type = TZ_DATE_JULIAN;
+    p = parseNumber(p + 1, 1, 365, value);
+    date.day = value;
+  } else if (*p == 'M') {
+    long week, wday;
+    date.type = TZ_DATE_MONTH;
+    p = parseNumber(p + 1, 1, 12, value);
+    if (!p || *p != '.' || !(p = parseNumber(p + 1, 1, 5, week)) ||
+        *p != '.' || !(p = parseNumber(p + 1, 0, 6, wday))) {
+      return nullptr;
+    }
+    date.month = value;
+    date.week = week;
+    date.wday = wday;
+  } else {
+    date.type = TZ_DATE_DAY;
+    p = parseNumber(p, 0, 365, value);
+    date.day = value;
+  }
+  if (!p) {
+    return nullptr;
+  }
+  date.time = TZ_DEFAULT_TIME;
+  if (*p == '/') {
+    p = parseTime(p + 1, TZ_MAX_TIME, date.time);
+  }
+  return p;
+}
+
+static const char *parseRules(const char *p, tz_rule_t &parsed) {
+  if (!(p = parseDate(p, parsed.start)) || *p != ',') {
+    return nullptr;
+  }
+  return parseDate(p + 1, parsed.end);
+}
+
+TimeZone &TimeZone::getInstance() {
+  static TimeZone instance;
+  return instance;
+}
+
+TimeZone::TimeZone() { setRule("UTC0"); }
+
+bool TimeZone::parseRule(const char *rule, tz_rule_t &parsed) {
+  memset(&parsed, 0, sizeof(parsed));
+  int32_t offset;
+  const char *p = parseName(rule, parsed.std_name);
+  if (!p || !(p = parseTime(p, TZ_MAX_OFFSET, offset))) {
+    return false;
+  }
+  // POSIX counts the offsets west of UTC
+  parsed.std_offset = -offset;
+  if (*p == '\0') {
+    return true;
+  }
+
+  if (!(p = parseName(p, parsed.dst_name))) {
+    return false;
+  }
+  parsed.has_dst = true;
+  parsed.dst_offset = parsed.std_offset + 3600;
+  if (*p != ',' && *p != '\0') {
+    if (!(p = parseTime(p, TZ_MAX_OFFSET, offset))) {
+      return false;
+    }
+    parsed.dst_offset = -offset;
+  }
+  if (*p == '\0') {
+    return parseRules(TZ_DEFAULT_START "," TZ_DEFAULT_END, parsed);
+  }
+  p = *p == ',' ? parseRules(p + 1, parsed) : nullptr;
+  return p && *p == '\0';
+}
+
+void TimeZone::manualRule(int32_t minutes_west, char *rule, size_t size) {
+  long offset = minutes_west * 60L;
+  long abs_offset = labs(offset);
+  snprintf(rule, size, "UTC%c%ld:%02ld:%02ld", offset < 0 ? '-' : '+',
+           abs_offset / 3600, (abs_offset % 3600) / 60, abs_offset % 60);
+}
+
+bool TimeZone::setRule(const char *rule) {
+  tz_rule_t parsed;
+  bool valid = parseRule(rule, parsed);
+  if (!valid) {
+    ERROR("Invalid TZ rule: %s\n", rule);
+    parseRule("UTC0", parsed);
+  }
+
+  std::lock_guard<std::mutex> lock(zoneMutex);
+  this->rule = parsed;
+  // Empty period, the next query computes the transitions
+  period_start = 0;
+  period_end = 0;
+  return valid;
+}
+
+// UTC seconds of a rule date in a year, offset is the one in effect before
+int64_t TimeZone::transitionTime(const tz_date_t &date, int year,
+                                 int32_t offset) {
+  int64_t days;
+  if (date.type == TZ_DATE_JULIAN) {
+    days = daysFromCivil(year, 1, 1) + date.day - 1 +
+           (isLeap(year) && date.day >= 60 ? 1 : 0);
+  } else if (date.type == TZ_DATE_DAY) {
+    days = daysFromCivil(year, 1, 1) + date.day;
+  } else {
+    int64_t first = daysFromCivil(year, date.month, 1);
+    int first_wday = (int)((first % 7 + 11) % 7); // 1970-01-01 was Thursday
+    int mday = 1 + (date.wday - first_wday + 7) % 7 + (date.week - 1) * 7;
+    while (mday > monthDays(year, date.month)) {
+      mday -= 7;
+    }
+    days = first + mday - 1;
+  }
+  return days * SECONDS_PER_DAY + date.time - offset;
+}
+
+void TimeZone::update(int64_t utc) {
+  if (!rule.has_dst) {
+    period_start = INT64_MIN;
+    period_end = TZ_NO_TRANSITION;
+    period_offset = rule.std_offset;
+    period_dst = false;
+    return;
+  }
+
+  int year, month, day;
+  civilFromDays(floorDiv(utc, SECONDS_PER_DAY), year, month, day);
+  size_t count = 0;
+  for (int y = year - 1; y <= year + 1; y++) {
+    transitions[count++] = {transitionTime(rule.start, y, rule.std_offset),
+                            rule.dst_offset, true};
+    transitions[count++] = {transitionTime(rule.end, y, rule.dst_offset),
+                            rule.std_offset, false};
+  }
+  // The southern hemisphere ends DST before it starts in the same year
+  for (size_t i = 1; i < count; i++) {
+    tz_transition_t t = transitions[i];
+    size_t j = i;
+    for (; j > 0 && transitions[j - 1].at > t.at; j--) {
+      transitions[j] = transitions[j - 1];
+    }
+    transitions[j] = t;
+  }
+
+  // Before the first transition the opposite of it is in effect
+  period_start = INT64_MIN;
+  period_end = transitions[0].at;
+  period_dst = !transitions[0].dst;
+  period_offset = period_dst ? rule.dst_offset : rule.std_offset;
+  for (size_t i = 0; i < count && transitions[i].at <= utc; i++) {
+    period_start = transitions[i].at;
+    period_end = i + 1 < count ? transitions[i + 1].at : TZ_NO_TRANSITION;
+    period_offset = transitions[i].offset;
+    period_dst = transitions[i].dst;
+  }
+}
+
+// Returns the end of the period utc is in
+int64_t TimeZone::lookup(time_t utc, int32_t &offset, bool &dst) {
+  std::lock_guard<std::mutex> lock(zoneMutex);
+  if (utc < period_start || utc >= period_end) {
+    update(utc);
+  }
+  offset = period_offset;
+  dst = period_dst;
+  return period_end;
+}
+
+int32_t TimeZone::getOffset(time_t utc) {
+  int32_t offset;
+  bool dst;
+  lookup(utc, offset, dst);
+  return offset;
+}
+
+bool TimeZone::isDst(time_t utc) {
+  int32_t offset;
+  bool dst;
+  lookup(utc, offset, dst);
+  return dst;
+}
+
+void TimeZone::localTime(time_t utc, struct tm &tm) {
+  int32_t offset;
+  bool dst;
+  lookup(utc, offset, dst);
+  // Split without gmtime_r(), it costs more than the rest of the lookup
+  int64_t local = (int64_t)utc + offset;
+  int64_t days = floorDiv(local, SECONDS_PER_DAY);
+  int32_t seconds = local - days * SECONDS_PER_DAY;
+  int year, month, day;
+  civilFromDays(days, year, month, day);
+  tm.tm_sec = seconds % 60;
+  tm.tm_min = seconds / 60 % 60;
+  tm.tm_hour = seconds / 3600;
+  tm.tm_mday = day;
+  tm.tm_mon = month - 1;
+  tm.tm_year = year - 1900;
+  tm.tm_wday = (int)((days % 7 + 11) % 7); // 1970-01-01 was Thursday
+  tm.tm_yday = (int)(days - daysFromCivil(year, 1, 1));
+  tm.tm_isdst = dst ? 1 : 0;
+}
+
+int64_t TimeZone::getNextTransition(time_t utc) {
+  int32_t offset;
+  bool dst;
+  return lookup(utc, offset, dst);
+}
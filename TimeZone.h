@@ -0,0 +1,87 @@
+#ifndef _TIME_ZONE_H_
+#define _TIME_ZONE_H_
+
+#include <Arduino.h>
+#include <mutex>
+#include <time.h>
+
+#define TZ_NAME_MAX 8
+#define TZ_TRANSITIONS 6 // two per year for the previous, current and next
+#define TZ_NO_TRANSITION INT64_MAX
+
+typedef enum {
+  TZ_DATE_JULIAN = 0, // Jn, 1..365, February 29 is never counted
+  TZ_DATE_DAY,        // n, 0..365, February 29 is counted
+  TZ_DATE_MONTH       // Mm.w.d, day d of week w of month m, week 5 is last
+} tz_date_type_t;
+
+typedef struct {
+  tz_date_type_t type;
+  uint16_t day;
+  uint8_t month;
+  uint8_t week;
+  uint8_t wday;
+  int32_t time; // s after local midnight, may be negative or over 24 h
+} tz_date_t;
+
+// Offsets are east of UTC, local = UTC + offset
+typedef struct {
+  char std_name[TZ_NAME_MAX];
+  char dst_name[TZ_NAME_MAX];
+  int32_t std_offset;
+  int32_t dst_offset;
+  bool has_dst;
+  tz_date_t start; // to DST, in local standard time
+  tz_date_t end;   // back to standard time, in local DST
+} tz_rule_t;
+
+typedef struct {
+  int64_t at; // UTC seconds
+  int32_t offset;
+  bool dst;
+} tz_transition_t;
+
+// Parses the POSIX TZ rule once into the transitions around the current
+// time. A local time is then an add while the time stays before the cached
+// next transition, the transitions are only recomputed when it is passed.
+class TimeZone {
+
+public:
+  static TimeZone &getInstance();
+  TimeZone(const TimeZone &) = delete;
+  TimeZone &operator=(const TimeZone &) = delete;
+
+  // Falls back to UTC and returns false if the rule can't be parsed
+  bool setRule(const char *rule);
+  int32_t getOffset(time_t utc);
+  bool isDst(time_t utc);
+  // Fills tm like localtime_r() does
+  void localTime(time_t utc, struct tm &tm);
+  // UTC seconds of the first transition after utc, TZ_NO_TRANSITION if the
+  // rule has no DST
+  int64_t getNextTransition(time_t utc);
+
+  static bool parseRule(const char *rule, tz_rule_t &parsed);
+  // Rule of a fixed offset in minutes west of UTC, the manual time zone
+  static void manualRule(int32_t minutes_west, char *rule, size_t size);
+
+private:
+  TimeZone();
+  ~TimeZone() = default;
+
+  int64_t lookup(time_t utc, int32_t &offset, bool &dst);
+  void update(int64_t utc);
+  static int64_t transitionTime(const tz_date_t &date, int year,
+                                int32_t offset);
+
+  std::mutex zoneMutex;
+  tz_rule_t rule;
+  tz_transition_t transitions[TZ_TRANSITIONS];
+  // The cached period [period_start, period_end) has a single offset
+  int64_t period_start;
+  int64_t period_end;
+  int32_t period_offset;
+  bool period_dst;
+};
+
+#endif
@@ -0,0 +1,117 @@
+#include "WifiScanner.h"
+#include "Logger.h"
+#include "config.h"
+#include <WiFi.h>
+
+#define TRACE(...) LOG_DEBUG(LOG_WEB, __VA_ARGS__)
+#define ERROR(...) LOG_ERROR(LOG_WEB, __VA_ARGS__)
+
+WifiScanner &WifiScanner::getInstance() {
+  static WifiScanner instance;
+  return instance;
+}
+
+bool WifiScanner::startScan(void) {
+  std::lock_guard<std::mutex> lock(scanMutex);
+  if (scanning) {
+    return true;
+  }
+  // Asynchronous scan, results are picked up by process()
+  int16_t result = WiFi.scanNetworks(true);
+  if (result == WIFI_SCAN_FAILED) {
+    ERROR("Failed to start WiFi scan\n");
+    return false;
+  }
+  scanning = true;
+  scanStarted = millis();
+  TRACE("WiFi scan started\n");
+  return true;
+}
+
+void WifiScanner::process(void) {
+  std::lock_guard<std::mutex> lock(scanMutex);
+  if (!scanning) {
+    return;
+  }
+  int16_t n = WiFi.scanComplete();
+  if (n == WIFI_SCAN_RUNNING) {
+    if (millis() - scanStarted > WIFI_SCAN_TIMEOUT) {
+      ERROR("WiFi scan timed out\n");
+      WiFi.scanDelete();
+      scanning = false;
+    }
+    return;
+  }
+  scanning = false;
+  if (n < 0) {
+    ERROR("WiFi scan failed:%d\n", n);
+    return;
+  }
+
+  count = 0;
+  for (int16_t i = 0; i < n; i++) {
+    addNetwork(WiFi.SSID(i), WiFi.RSSI(i));
+  }
+  WiFi.scanDelete();
+  valid = true;
+  scanFinished = millis();
+  TRACE("WiFi scan done: %d networks, %d unique\n", n, (int)count);
+}
+
+// Inserts the network keeping the list sorted by RSSI in descending order
+// and only the strongest entry for each SSID
+void WifiScanner::addNetwork(const String &ssid, int32_t rssi) {
+  if (ssid.isEmpty() || ssid.length() >= sizeof(networks[0].ssid)) {
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (strcmp(networks[i].ssid, ssid.c_str()) == 0) {
+      if (networks[i].rssi >= rssi) {
+        return;
+      }
+      // Weaker duplicate, remove it and insert again below
+      memmove(&networks[i], &networks[i + 1],
+              (count - i - 1) * sizeof(networks[0]));
+      count--;
+      break;
+    }
+  }
+
+  size_t pos = 0;
+  while (pos < count && networks[pos].rssi >= rssi) {
+    pos++;
+  }
+  if (pos >= WIFI_SCAN_MAX_NETWORKS) {
+    return;
+  }
+  size_t tail = (count < WIFI_SCAN_MAX_NETWORKS) ? count : count - 1;
+  memmove(&networks[pos + 1], &networks[pos],
+          (tail - pos) * sizeof(networks[0]));
+  snprintf(networks[pos].ssid, sizeof(networks[pos].ssid), "%s",
+           ssid.c_str());
+  networks[pos].rssi = (int8_t)rssi;
+  if (count < WIFI_SCAN_MAX_NETWORKS) {
+    count++;
+  }
+}
+
+bool WifiScanner::isScanning(void) {
+  std::lock_guard<std::mutex> lock(scanMutex);
+  return scanning;
+}
+
+size_t WifiScanner::getNetworks(wifi_network_t *list, size_t max) {
+  std::lock_guard<std::mutex> lock(scanMutex);
+  size_t n = (count < max) ? count : max;
+  memcpy(list, networks, n * sizeof(networks[0]));
+  return n;
+}
+
+uint32_t WifiScanner::getAge(void) {
+  std::lock_guard<std::mutex> lock(scanMutex);
+  return valid ? millis() - scanFinished : UINT32_MAX;
+}
+
+WifiScanner::WifiScanner()
+    : count(0), scanning(false), valid(false), scanStarted(0),
+      scanFinished(0) {}
@@ -0,0 +1,50 @@
+#ifndef _WIFI_SCANNER_H_
+#define _WIFI_SCANNER_H_
+
+#include <Arduino.h>
+#include <mutex>
+
+#define WIFI_SCAN_MAX_NETWORKS 16
+#define WIFI_SCAN_TTL 60000      // ms, results older than that are refreshed
+#define WIFI_SCAN_TIMEOUT 15000  // ms, give up waiting for the driver
+
+typedef struct {
+  char ssid[33];
+  int8_t rssi;
+} wifi_network_t;
+
+// Runs Wi-Fi scans in the background and keeps the deduplicated results
+// sorted by signal strength, so they can be served without waiting.
+class WifiScanner {
+
+public:
+  static WifiScanner &getInstance();
+  WifiScanner(const WifiScanner &) = delete;
+  WifiScanner &operator=(const WifiScanner &) = delete;
+
+  // Starts a scan unless one is already running
+  bool startScan(void);
+  // Collects the results of a finished scan, call it periodically
+  void process(void);
+  bool isScanning(void);
+  // Copies the cached results, returns number of networks
+  size_t getNetworks(wifi_network_t *networks, size_t max);
+  // Age of the cached results in ms, UINT32_MAX if never scanned
+  uint32_t getAge(void);
+
+private:
+  WifiScanner();
+  ~WifiScanner() = default;
+
+  void addNetwork(const String &ssid, int32_t rssi);
+
+  wifi_network_t networks[WIFI_SCAN_MAX_NETWORKS];
+  size_t count;
+  bool scanning;
+  bool valid;
+  unsigned long scanStarted;
+  unsigned long scanFinished;
+  std::mutex scanMutex;
+};
+
+#endif
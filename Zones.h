@@ -1,6 +1,27 @@
 #ifndef ZONES_H
 #define ZONES_H
 
-void zones_ListJson(void);
+#include <Arduino.h>
+#include <functional>
 
-#endif // ZONES_H
\ No newline at end of file
+// Stable zone identifier stored in preferences instead of the zone strings
+typedef uint32_t zone_id_t;
+#define ZONE_INVALID_ID 0
+
+typedef struct {
+  zone_id_t id;
+  const char *name;
+  const char *rule; // POSIX TZ rule
+} zone_entry_t;
+
+// Return false from the callback to stop the iteration
+typedef std::function<bool(const zone_entry_t &entry)> zones_callback_t;
+
+size_t zones_ForEach(const char *prefix, zones_callback_t callback);
+bool zones_FindByName(const char *name, zone_entry_t &entry);
+bool zones_FindById(zone_id_t id, zone_entry_t &entry);
+
+const uint8_t *zones_JsonGz(size_t &len);
+const char *zones_ETag(void);
+
+#endif // ZONES_H
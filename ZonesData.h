@@ -0,0 +1,1055 @@
+// Generated by tools/zones_gen.py from data/zones.json - do not edit
+#ifndef ZONES_DATA_H
+#define ZONES_DATA_H
+
+#include <Arduino.h>
+
+#define ZONES_COUNT 461
+#define ZONES_RULES_COUNT 94
+#define ZONES_ETAG "61234dcb78335e64"
+#define ZONES_JSON_SIZE 15143
+
+// Zone names sorted in strcmp() order
+static const char zones_names[] PROGMEM =
+    "Africa/Abidjan\0"
+    "Africa/Accra\0"
+    "Africa/Addis_Ababa\0"
+    "Africa/Algiers\0"
+    "Africa/Asmara\0"
+    "Africa/Bamako\0"
+    "Africa/Bangui\0"
+    "Africa/Banjul\0"
+    "Africa/Bissau\0"
+    "Africa/Blantyre\0"
+    "Africa/Brazzaville\0"
+    "Africa/Bujumbura\0"
+    "Africa/Cairo\0"
+    "Africa/Casablanca\0"
+    "Africa/Ceuta\0"
+    "Africa/Conakry\0"
+    "Africa/Dakar\0"
+    "Africa/Dar_es_Salaam\0"
+    "Africa/Djibouti\0"
+    "Africa/Douala\0"
+    "Africa/El_Aaiun\0"
+    "Africa/Freetown\0"
+    "Africa/Gaborone\0"
+    "Africa/Harare\0"
+    "Africa/Johannesburg\0"
+    "Africa/Juba\0"
+    "Africa/Kampala\0"
+    "Africa/Khartoum\0"
+    "Africa/Kigali\0"
+    "Africa/Kinshasa\0"
+    "Africa/Lagos\0"
+    "Africa/Libreville\0"
+    "Africa/Lome\0"
+    "Africa/Luanda\0"
+    "Africa/Lubumbashi\0"
+    "Africa/Lusaka\0"
+    "Africa/Malabo\0"
+    "Africa/Maputo\0"
+    "Africa/Maseru\0"
+    "Africa/Mbabane\0"
+    "Africa/Mogadishu\0"
+    "Africa/Monrovia\0"
+    "Africa/Nairobi\0"
+    "Africa/Ndjamena\0"
+    "Africa/Niamey\0"
+    "Africa/Nouakchott\0"
+    "Africa/Ouagadougou\0"
+    "Africa/Porto-Novo\0"
+    "Africa/Sao_Tome\0"
+    "Africa/Tripoli\0"
+    "Africa/Tunis\0"
+    "Africa/Windhoek\0"
+    "America/Adak\0"
+    "America/Anchorage\0"
+    "America/Anguilla\0"
+    "America/Antigua\0"
+    "America/Araguaina\0"
+    "America/Argentina/Buenos_Aires\0"
+    "America/Argentina/Catamarca\0"
+    "America/Argentina/Cordoba\0"
+    "America/Argentina/Jujuy\0"
+    "America/Argentina/La_Rioja\0"
+    "America/Argentina/Mendoza\0"
+    "America/Argentina/Rio_Gallegos\0"
+    "America/Argentina/Salta\0"
+    "America/Argentina/San_Juan\0"
+    "America/Argentina/San_Luis\0"
+    "America/Argentina/Tucuman\0"
+    "America/Argentina/Ushuaia\0"
+    "America/Aruba\0"
+    "America/Asuncion\0"
+    "America/Atikokan\0"
+    "America/Bahia\0"
+    "America/Bahia_Banderas\0"
+    "America/Barbados\0"
+    "America/Belem\0"
+    "America/Belize\0"
+    "America/Blanc-Sablon\0"
+    "America/Boa_Vista\0"
+    "America/Bogota\0"
+    "America/Boise\0"
+    "America/Cambridge_Bay\0"
+    "America/Campo_Grande\0"
+    "America/Cancun\0"
+    "America/Caracas\0"
+    "America/Cayenne\0"
+    "America/Cayman\0"
+    "America/Chicago\0"
+    "America/Chihuahua\0"
+    "America/Costa_Rica\0"
+    "America/Creston\0"
+    "America/Cuiaba\0"
+    "America/Curacao\0"
+    "America/Danmarkshavn\0"
+    "America/Dawson\0"
+    "America/Dawson_Creek\0"
+    "America/Denver\0"
+    "America/Detroit\0"
+    "America/Dominica\0"
+    "America/Edmonton\0"
+    "America/Eirunepe\0"
+    "America/El_Salvador\0"
+    "America/Fort_Nelson\0"
+    "America/Fortaleza\0"
+    "America/Glace_Bay\0"
+    "America/Godthab\0"
+    "America/Goose_Bay\0"
+    "America/Grand_Turk\0"
+    "America/Grenada\0"
+    "America/Guadeloupe\0"
+    "America/Guatemala\0"
+    "America/Guayaquil\0"
+    "America/Guyana\0"
+    "America/Halifax\0"
+    "America/Havana\0"
+    "America/Hermosillo\0"
+    "America/Indiana/Indianapolis\0"
+    "America/Indiana/Knox\0"
+    "America/Indiana/Marengo\0"
+    "America/Indiana/Petersburg\0"
+    "America/Indiana/Tell_City\0"
+    "America/Indiana/Vevay\0"
+    "America/Indiana/Vincennes\0"
+    "America/Indiana/Winamac\0"
+    "America/Inuvik\0"
+    "America/Iqaluit\0"
+    "America/Jamaica\0"
+    "America/Juneau\0"
+    "America/Kentucky/Louisville\0"
+    "America/Kentucky/Monticello\0"
+    "America/Kralendijk\0"
+    "America/La_Paz\0"
+    "America/Lima\0"
+    "America/Los_Angeles\0"
+    "America/Lower_Princes\0"
+    "America/Maceio\0"
+    "America/Managua\0"
+    "America/Manaus\0"
+    "America/Marigot\0"
+    "America/Martinique\0"
+    "America/Matamoros\0"
+    "America/Mazatlan\0"
+    "America/Menominee\0"
+    "America/Merida\0"
+    "America/Metlakatla\0"
+    "America/Mexico_City\0"
+    "America/Miquelon\0"
+    "America/Moncton\0"
+    "America/Monterrey\0"
+    "America/Montevideo\0"
+    "America/Montreal\0"
+    "America/Montserrat\0"
+    "America/Nassau\0"
+    "America/New_York\0"
+    "America/Nipigon\0"
+    "America/Nome\0"
+    "America/Noronha\0"
+    "America/North_Dakota/Beulah\0"
+    "America/North_Dakota/Center\0"
+    "America/North_Dakota/New_Salem\0"
+    "America/Nuuk\0"
+    "America/Ojinaga\0"
+    "America/Panama\0"
+    "America/Pangnirtung\0"
+    "America/Paramaribo\0"
+    "America/Phoenix\0"
+    "America/Port-au-Prince\0"
+    "America/Port_of_Spain\0"
+    "America/Porto_Velho\0"
+    "America/Puerto_Rico\0"
+    "America/Punta_Arenas\0"
+    "America/Rainy_River\0"
+    "America/Rankin_Inlet\0"
+    "America/Recife\0"
+    "America/Regina\0"
+    "America/Resolute\0"
+    "America/Rio_Branco\0"
+    "America/Santarem\0"
+    "America/Santiago\0"
+    "America/Santo_Domingo\0"
+    "America/Sao_Paulo\0"
+    "America/Scoresbysund\0"
+    "America/Sitka\0"
+    "America/St_Barthelemy\0"
+    "America/St_Johns\0"
+    "America/St_Kitts\0"
+    "America/St_Lucia\0"
+    "America/St_Thomas\0"
+    "America/St_Vincent\0"
+    "America/Swift_Current\0"
+    "America/Tegucigalpa\0"
+    "America/Thule\0"
+    "America/Thunder_Bay\0"
+    "America/Tijuana\0"
+    "America/Toronto\0"
+    "America/Tortola\0"
+    "America/Vancouver\0"
+    "America/Whitehorse\0"
+    "America/Winnipeg\0"
+    "America/Yakutat\0"
+    "America/Yellowknife\0"
+    "Antarctica/Casey\0"
+    "Antarctica/Davis\0"
+    "Antarctica/DumontDUrville\0"
+    "Antarctica/Macquarie\0"
+    "Antarctica/Mawson\0"
+    "Antarctica/McMurdo\0"
+    "Antarctica/Palmer\0"
+    "Antarctica/Rothera\0"
+    "Antarctica/Syowa\0"
+    "Antarctica/Troll\0"
+    "Antarctica/Vostok\0"
+    "Arctic/Longyearbyen\0"
+    "Asia/Aden\0"
+    "Asia/Almaty\0"
+    "Asia/Amman\0"
+    "Asia/Anadyr\0"
+    "Asia/Aqtau\0"
+    "Asia/Aqtobe\0"
+    "Asia/Ashgabat\0"
+    "Asia/Atyrau\0"
+    "Asia/Baghdad\0"
+    "Asia/Bahrain\0"
+    "Asia/Baku\0"
+    "Asia/Bangkok\0"
+    "Asia/Barnaul\0"
+    "Asia/Beirut\0"
+    "Asia/Bishkek\0"
+    "Asia/Brunei\0"
+    "Asia/Chita\0"
+    "Asia/Choibalsan\0"
+    "Asia/Colombo\0"
+    "Asia/Damascus\0"
+    "Asia/Dhaka\0"
+    "Asia/Dili\0"
+    "Asia/Dubai\0"
+    "Asia/Dushanbe\0"
+    "Asia/Famagusta\0"
+    "Asia/Gaza\0"
+    "Asia/Hebron\0"
+    "Asia/Ho_Chi_Minh\0"
+    "Asia/Hong_Kong\0"
+    "Asia/Hovd\0"
+    "Asia/Irkutsk\0"
+    "Asia/Jakarta\0"
+    "Asia/Jayapura\0"
+    "Asia/Jerusalem\0"
+    "Asia/Kabul\0"
+    "Asia/Kamchatka\0"
+    "Asia/Karachi\0"
+    "Asia/Kathmandu\0"
+    "Asia/Khandyga\0"
+    "Asia/Kolkata\0"
+    "Asia/Krasnoyarsk\0"
+    "Asia/Kuala_Lumpur\0"
+    "Asia/Kuching\0"
+    "Asia/Kuwait\0"
+    "Asia/Macau\0"
+    "Asia/Magadan\0"
+    "Asia/Makassar\0"
+    "Asia/Manila\0"
+    "Asia/Muscat\0"
+    "Asia/Nicosia\0"
+    "Asia/Novokuznetsk\0"
+    "Asia/Novosibirsk\0"
+    "Asia/Omsk\0"
+    "Asia/Oral\0"
+    "Asia/Phnom_Penh\0"
+    "Asia/Pontianak\0"
+    "Asia/Pyongyang\0"
+    "Asia/Qatar\0"
+    "Asia/Qyzylorda\0"
+    "Asia/Riyadh\0"
+    "Asia/Sakhalin\0"
+    "Asia/Samarkand\0"
+    "Asia/Seoul\0"
+    "Asia/Shanghai\0"
+    "Asia/Singapore\0"
+    "Asia/Srednekolymsk\0"
+    "Asia/Taipei\0"
+    "Asia/Tashkent\0"
+    "Asia/Tbilisi\0"
+    "Asia/Tehran\0"
+    "Asia/Thimphu\0"
+    "Asia/Tokyo\0"
+    "Asia/Tomsk\0"
+    "Asia/Ulaanbaatar\0"
+    "Asia/Urumqi\0"
+    "Asia/Ust-Nera\0"
+    "Asia/Vientiane\0"
+    "Asia/Vladivostok\0"
+    "Asia/Yakutsk\0"
+    "Asia/Yangon\0"
+    "Asia/Yekaterinburg\0"
+    "Asia/Yerevan\0"
+    "Atlantic/Azores\0"
+    "Atlantic/Bermuda\0"
+    "Atlantic/Canary\0"
+    "Atlantic/Cape_Verde\0"
+    "Atlantic/Faroe\0"
+    "Atlantic/Madeira\0"
+    "Atlantic/Reykjavik\0"
+    "Atlantic/South_Georgia\0"
+    "Atlantic/St_Helena\0"
+    "Atlantic/Stanley\0"
+    "Australia/Adelaide\0"
+    "Australia/Brisbane\0"
+    "Australia/Broken_Hill\0"
+    "Australia/Currie\0"
+    "Australia/Darwin\0"
+    "Australia/Eucla\0"
+    "Australia/Hobart\0"
+    "Australia/Lindeman\0"
+    "Australia/Lord_Howe\0"
+    "Australia/Melbourne\0"
+    "Australia/Perth\0"
+    "Australia/Sydney\0"
+    "Etc/GMT\0"
+    "Etc/GMT+0\0"
+    "Etc/GMT+1\0"
+    "Etc/GMT+10\0"
+    "Etc/GMT+11\0"
+    "Etc/GMT+12\0"
+    "Etc/GMT+2\0"
+    "Etc/GMT+3\0"
+    "Etc/GMT+4\0"
+    "Etc/GMT+5\0"
+    "Etc/GMT+6\0"
+    "Etc/GMT+7\0"
+    "Etc/GMT+8\0"
+    "Etc/GMT+9\0"
+    "Etc/GMT-0\0"
+    "Etc/GMT-1\0"
+    "Etc/GMT-10\0"
+    "Etc/GMT-11\0"
+    "Etc/GMT-12\0"
+    "Etc/GMT-13\0"
+    "Etc/GMT-14\0"
+    "Etc/GMT-2\0"
+    "Etc/GMT-3\0"
+    "Etc/GMT-4\0"
+    "Etc/GMT-5\0"
+    "Etc/GMT-6\0"
+    "Etc/GMT-7\0"
+    "Etc/GMT-8\0"
+    "Etc/GMT-9\0"
+    "Etc/GMT0\0"
+    "Etc/Greenwich\0"
+    "Etc/UCT\0"
+    "Etc/UTC\0"
+    "Etc/Universal\0"
+    "Etc/Zulu\0"
+    "Europe/Amsterdam\0"
+    "Europe/Andorra\0"
+    "Europe/Astrakhan\0"
+    "Europe/Athens\0"
+    "Europe/Belgrade\0"
+    "Europe/Berlin\0"
+    "Europe/Bratislava\0"
+    "Europe/Brussels\0"
+    "Europe/Bucharest\0"
+    "Europe/Budapest\0"
+    "Europe/Busingen\0"
+    "Europe/Chisinau\0"
+    "Europe/Copenhagen\0"
+    "Europe/Dublin\0"
+    "Europe/Gibraltar\0"
+    "Europe/Guernsey\0"
+    "Europe/Helsinki\0"
+    "Europe/Isle_of_Man\0"
+    "Europe/Istanbul\0"
+    "Europe/Jersey\0"
+    "Europe/Kaliningrad\0"
+    "Europe/Kiev\0"
+    "Europe/Kirov\0"
+    "Europe/Lisbon\0"
+    "Europe/Ljubljana\0"
+    "Europe/London\0"
+    "Europe/Luxembourg\0"
+    "Europe/Madrid\0"
+    "Europe/Malta\0"
+    "Europe/Mariehamn\0"
+    "Europe/Minsk\0"
+    "Europe/Monaco\0"
+    "Europe/Moscow\0"
+    "Europe/Oslo\0"
+    "Europe/Paris\0"
+    "Europe/Podgorica\0"
+    "Europe/Prague\0"
+    "Europe/Riga\0"
+    "Europe/Rome\0"
+    "Europe/Samara\0"
+    "Europe/San_Marino\0"
+    "Europe/Sarajevo\0"
+    "Europe/Saratov\0"
+    "Europe/Simferopol\0"
+    "Europe/Skopje\0"
+    "Europe/Sofia\0"
+    "Europe/Stockholm\0"
+    "Europe/Tallinn\0"
+    "Europe/Tirane\0"
+    "Europe/Ulyanovsk\0"
+    "Europe/Uzhgorod\0"
+    "Europe/Vaduz\0"
+    "Europe/Vatican\0"
+    "Europe/Vienna\0"
+    "Europe/Vilnius\0"
+    "Europe/Volgograd\0"
+    "Europe/Warsaw\0"
+    "Europe/Zagreb\0"
+    "Europe/Zaporozhye\0"
+    "Europe/Zurich\0"
+    "Indian/Antananarivo\0"
+    "Indian/Chagos\0"
+    "Indian/Christmas\0"
+    "Indian/Cocos\0"
+    "Indian/Comoro\0"
+    "Indian/Kerguelen\0"
+    "Indian/Mahe\0"
+    "Indian/Maldives\0"
+    "Indian/Mauritius\0"
+    "Indian/Mayotte\0"
+    "Indian/Reunion\0"
+    "Pacific/Apia\0"
+    "Pacific/Auckland\0"
+    "Pacific/Bougainville\0"
+    "Pacific/Chatham\0"
+    "Pacific/Chuuk\0"
+    "Pacific/Easter\0"
+    "Pacific/Efate\0"
+    "Pacific/Enderbury\0"
+    "Pacific/Fakaofo\0"
+    "Pacific/Fiji\0"
+    "Pacific/Funafuti\0"
+    "Pacific/Galapagos\0"
+    "Pacific/Gambier\0"
+    "Pacific/Guadalcanal\0"
+    "Pacific/Guam\0"
+    "Pacific/Honolulu\0"
+    "Pacific/Kiritimati\0"
+    "Pacific/Kosrae\0"
+    "Pacific/Kwajalein\0"
+    "Pacific/Majuro\0"
+    "Pacific/Marquesas\0"
+    "Pacific/Midway\0"
+    "Pacific/Nauru\0"
+    "Pacific/Niue\0"
+    "Pacific/Norfolk\0"
+    "Pacific/Noumea\0"
+    "Pacific/Pago_Pago\0"
+    "Pacific/Palau\0"
+    "Pacific/Pitcairn\0"
+    "Pacific/Pohnpei\0"
+    "Pacific/Port_Moresby\0"
+    "Pacific/Rarotonga\0"
+    "Pacific/Saipan\0"
+    "Pacific/Tahiti\0"
+    "Pacific/Tarawa\0"
+    "Pacific/Tongatapu\0"
+    "Pacific/Wake\0"
+    "Pacific/Wallis\0";
+
+static const uint16_t zones_name_offsets[ZONES_COUNT] PROGMEM = {
+    0, 15, 28, 47, 62, 76, 90, 104, 118, 132,
+    148, 167, 184, 197, 215, 228, 243, 256, 277, 293,
+    307, 323, 339, 355, 369, 389, 401, 416, 432, 446,
+    462, 475, 493, 505, 519, 537, 551, 565, 579, 593,
+    608, 625, 641, 656, 672, 686, 704, 723, 741, 757,
+    772, 785, 801, 814, 832, 849, 865, 883, 914, 942,
+    968, 992, 1019, 1045, 1076, 1100, 1127, 1154, 1180, 1206,
+    1220, 1237, 1254, 1268, 1291, 1308, 1322, 1337, 1358, 1376,
+    1391, 1405, 1427, 1448, 1463, 1479, 1495, 1510, 1526, 1544,
+    1563, 1579, 1594, 1610, 1631, 1646, 1667, 1682, 1698, 1715,
+    1732, 1749, 1769, 1789, 1807, 1825, 1841, 1859, 1878, 1894,
+    1913, 1931, 1949, 1964, 1980, 1995, 2014, 2043, 2064, 2088,
+    2115, 2141, 2163, 2189, 2213, 2228, 2244, 2260, 2275, 2303,
+    2331, 2350, 2365, 2378, 2398, 2420, 2435, 2451, 2466, 2482,
+    2501, 2519, 2536, 2554, 2569, 2588, 2608, 2625, 2641, 2659,
+    2678, 2695, 2714, 2729, 2746, 2762, 2775, 2791, 2819, 2847,
+    2878, 2891, 2907, 2922, 2942, 2961, 2977, 3000, 3022, 3042,
+    3062, 3083, 3103, 3124, 3139, 3154, 3171, 3190, 3207, 3224,
+    3246, 3264, 3285, 3299, 3321, 3338, 3355, 3372, 3390, 3409,
+    3431, 3451, 3465, 3485, 3501, 3517, 3533, 3551, 3570, 3587,
+    3603, 3623, 3640, 3657, 3683, 3704, 3722, 3741, 3759, 3778,
+    3795, 3812, 3830, 3850, 3860, 3872, 3883, 3895, 3906, 3918,
+    3932, 3944, 3957, 3970, 3980, 3993, 4006, 4018, 4031, 4043,
+    4054, 4070, 4083, 4097, 4108, 4118, 4129, 4143, 4158, 4168,
+    4180, 4197, 4212, 4222, 4235, 4248, 4262, 4277, 4288, 4303,
+    4316, 4331, 4345, 4358, 4375, 4393, 4406, 4418, 4429, 4442,
+    4456, 4468, 4480, 4493, 4511, 4528, 4538, 4548, 4564, 4579,
+    4594, 4605, 4620, 4632, 4646, 4661, 4672, 4686, 4701, 4720,
+    4732, 4746, 4759, 4771, 4784, 4795, 4806, 4823, 4835, 4849,
+    4864, 4881, 4894, 4906, 4925, 4938, 4954, 4971, 4987, 5007,
+    5022, 5039, 5058, 5081, 5100, 5117, 5136, 5155, 5177, 5194,
+    5211, 5227, 5244, 5263, 5283, 5303, 5319, 5336, 5344, 5354,
+    5364, 5375, 5386, 5397, 5407, 5417, 5427, 5437, 5447, 5457,
+    5467, 5477, 5487, 5497, 5508, 5519, 5530, 5541, 5552, 5562,
+    5572, 5582, 5592, 5602, 5612, 5622, 5632, 5641, 5655, 5663,
+    5671, 5685, 5694, 5711, 5726, 5743, 5757, 5773, 5787, 5805,
+    5821, 5838, 5854, 5870, 5886, 5904, 5918, 5935, 5951, 5967,
+    5986, 6002, 6016, 6035, 6047, 6060, 6074, 6091, 6105, 6123,
+    6137, 6150, 6167, 6180, 6194, 6208, 6220, 6233, 6250, 6264,
+    6276, 6288, 6302, 6320, 6336, 6351, 6369, 6383, 6396, 6413,
+    6428, 6442, 6459, 6475, 6488, 6503, 6517, 6532, 6549, 6563,
+    6577, 6595, 6609, 6629, 6643, 6660, 6673, 6687, 6704, 6716,
+    6732, 6749, 6764, 6779, 6792, 6809, 6830, 6846, 6860, 6875,
+    6889, 6907, 6923, 6936, 6953, 6971, 6987, 7007, 7020, 7037,
+    7056, 7071, 7089, 7104, 7122, 7137, 7151, 7164, 7180, 7195,
+    7213, 7227, 7244, 7260, 7281, 7299, 7314, 7329, 7344, 7362,
+    7375,
+};
+
+static const char zones_rules[] PROGMEM =
+    "<+00>0<+02>-2,M3.5.0/1,M10.5.0/3\0"
+    "<+01>-1\0"
+    "<+02>-2\0"
+    "<+0330>-3:30\0"
+    "<+03>-3\0"
+    "<+0430>-4:30\0"
+    "<+04>-4\0"
+    "<+0530>-5:30\0"
+    "<+0545>-5:45\0"
+    "<+05>-5\0"
+    "<+0630>-6:30\0"
+    "<+06>-6\0"
+    "<+07>-7\0"
+    "<+0845>-8:45\0"
+    "<+08>-8\0"
+    "<+09>-9\0"
+    "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0\0"
+    "<+10>-10\0"
+    "<+11>-11\0"
+    "<+11>-11<+12>,M10.1.0,M4.1.0/3\0"
+    "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45\0"
+    "<+12>-12\0"
+    "<+13>-13\0"
+    "<+14>-14\0"
+    "<-01>1\0"
+    "<-01>1<+00>,M3.5.0/0,M10.5.0/1\0"
+    "<-02>2\0"
+    "<-02>2<-01>,M3.5.0/-1,M10.5.0/0\0"
+    "<-03>3\0"
+    "<-03>3<-02>,M3.2.0,M11.1.0\0"
+    "<-04>4\0"
+    "<-04>4<-03>,M10.1.0/0,M3.4.0/0\0"
+    "<-04>4<-03>,M9.1.6/24,M4.1.6/24\0"
+    "<-05>5\0"
+    "<-06>6\0"
+    "<-06>6<-05>,M9.1.6/22,M4.1.6/22\0"
+    "<-07>7\0"
+    "<-08>8\0"
+    "<-0930>9:30\0"
+    "<-09>9\0"
+    "<-10>10\0"
+    "<-11>11\0"
+    "<-12>12\0"
+    "ACST-9:30\0"
+    "ACST-9:30ACDT,M10.1.0,M4.1.0/3\0"
+    "AEST-10\0"
+    "AEST-10AEDT,M10.1.0,M4.1.0/3\0"
+    "AKST9AKDT,M3.2.0,M11.1.0\0"
+    "AST4\0"
+    "AST4ADT,M3.2.0,M11.1.0\0"
+    "AWST-8\0"
+    "CAT-2\0"
+    "CET-1\0"
+    "CET-1CEST,M3.5.0,M10.5.0/3\0"
+    "CST-8\0"
+    "CST5CDT,M3.2.0/0,M11.1.0/1\0"
+    "CST6\0"
+    "CST6CDT,M3.2.0,M11.1.0\0"
+    "ChST-10\0"
+    "EAT-3\0"
+    "EET-2\0"
+    "EET-2EEST,M3.4.4/50,M10.4.4/50\0"
+    "EET-2EEST,M3.5.0,M10.5.0/3\0"
+    "EET-2EEST,M3.5.0/0,M10.5.0/0\0"
+    "EET-2EEST,M3.5.0/3,M10.5.0/4\0"
+    "EET-2EEST,M4.5.5/0,M10.5.4/24\0"
+    "EST5\0"
+    "EST5EDT,M3.2.0,M11.1.0\0"
+    "GMT0\0"
+    "GMT0BST,M3.5.0/1,M10.5.0\0"
+    "HKT-8\0"
+    "HST10\0"
+    "HST10HDT,M3.2.0,M11.1.0\0"
+    "IST-1GMT0,M10.5.0,M3.5.0/1\0"
+    "IST-2IDT,M3.4.4/26,M10.5.0\0"
+    "IST-5:30\0"
+    "JST-9\0"
+    "KST-9\0"
+    "MSK-3\0"
+    "MST7\0"
+    "MST7MDT,M3.2.0,M11.1.0\0"
+    "NST3:30NDT,M3.2.0,M11.1.0\0"
+    "NZST-12NZDT,M9.5.0,M4.1.0/3\0"
+    "PKT-5\0"
+    "PST-8\0"
+    "PST8PDT,M3.2.0,M11.1.0\0"
+    "SAST-2\0"
+    "SST11\0"
+    "UTC0\0"
+    "WAT-1\0"
+    "WET0WEST,M3.5.0/1,M10.5.0\0"
+    "WIB-7\0"
+    "WIT-9\0"
+    "WITA-8\0";
+
+static const uint16_t zones_rule_offsets[ZONES_RULES_COUNT] PROGMEM = {
+    0, 33, 41, 49, 62, 70, 83, 91, 104, 117,
+    125, 138, 146, 154, 167, 175, 183, 220, 229, 238,
+    269, 314, 323, 332, 341, 348, 379, 386, 418, 425,
+    452, 459, 490, 522, 529, 536, 568, 575, 582, 594,
+    601, 609, 617, 625, 635, 666, 674, 703, 728, 733,
+    756, 763, 769, 775, 802, 808, 835, 840, 863, 871,
+    877, 883, 914, 941, 970, 999, 1029, 1034, 1057, 1062,
+    1087, 1093, 1099, 1123, 1150, 1177, 1186, 1192, 1198, 1204,
+    1209, 1232, 1258, 1286, 1292, 1298, 1321, 1328, 1334, 1339,
+    1345, 1371, 1377, 1383,
+};
+
+// Index into zones_rule_offsets for every zone
+static const uint8_t zones_rule_index[ZONES_COUNT] PROGMEM = {
+    68, 68, 59, 52, 59, 68, 89, 68, 68, 51, 89, 51, 65, 1, 53, 68,
+    68, 59, 59, 89, 1, 68, 51, 51, 86, 51, 59, 51, 51, 89, 89, 89,
+    68, 89, 51, 51, 89, 51, 86, 86, 59, 68, 59, 89, 89, 68, 68, 89,
+    68, 60, 52, 51, 72, 47, 48, 48, 28, 28, 28, 28, 28, 28, 28, 28,
+    28, 28, 28, 28, 28, 48, 31, 66, 28, 56, 48, 28, 56, 48, 30, 33,
+    80, 80, 30, 66, 30, 28, 66, 57, 56, 56, 79, 30, 48, 68, 79, 79,
+    80, 67, 48, 80, 33, 56, 79, 28, 49, 27, 49, 67, 48, 48, 56, 33,
+    30, 49, 55, 79, 67, 57, 67, 67, 57, 67, 67, 67, 80, 67, 66, 47,
+    67, 67, 48, 30, 33, 85, 48, 28, 56, 30, 48, 48, 57, 79, 57, 56,
+    47, 56, 29, 49, 56, 28, 67, 48, 67, 67, 67, 47, 26, 57, 57, 57,
+    27, 57, 66, 67, 28, 79, 67, 48, 30, 48, 28, 57, 57, 28, 56, 57,
+    33, 28, 32, 48, 28, 27, 47, 48, 81, 48, 48, 48, 48, 56, 56, 49,
+    67, 85, 67, 48, 85, 79, 57, 47, 80, 14, 12, 17, 46, 9, 82, 28,
+    28, 4, 0, 9, 53, 4, 9, 4, 21, 9, 9, 9, 9, 4, 4, 6,
+    12, 12, 63, 11, 14, 15, 14, 7, 4, 11, 15, 6, 9, 64, 61, 61,
+    12, 70, 12, 14, 91, 92, 74, 5, 21, 83, 8, 15, 75, 12, 14, 14,
+    4, 54, 18, 93, 84, 6, 64, 12, 12, 11, 9, 12, 91, 77, 4, 9,
+    4, 18, 9, 77, 54, 14, 18, 54, 9, 6, 3, 11, 76, 12, 14, 11,
+    17, 12, 17, 15, 10, 9, 6, 25, 49, 90, 24, 90, 90, 68, 26, 68,
+    28, 44, 45, 44, 46, 43, 13, 46, 45, 16, 46, 50, 46, 68, 68, 24,
+    40, 41, 42, 26, 28, 30, 33, 34, 36, 37, 39, 68, 1, 17, 18, 21,
+    22, 23, 2, 4, 6, 9, 11, 12, 14, 15, 68, 68, 88, 88, 88, 88,
+    53, 53, 6, 64, 53, 53, 53, 53, 64, 53, 53, 62, 53, 73, 53, 69,
+    64, 69, 4, 69, 60, 64, 78, 90, 53, 69, 53, 53, 53, 64, 4, 53,
+    78, 53, 53, 53, 53, 64, 53, 6, 53, 53, 6, 78, 53, 64, 53, 64,
+    53, 6, 64, 53, 53, 53, 64, 78, 53, 53, 64, 53, 59, 11, 12, 10,
+    59, 9, 6, 9, 6, 59, 6, 22, 82, 18, 20, 17, 35, 18, 22, 22,
+    21, 21, 34, 39, 18, 58, 71, 23, 18, 21, 21, 38, 87, 21, 41, 19,
+    18, 87, 15, 37, 18, 17, 40, 58, 40, 21, 22, 21, 21,
+};
+
+// Stable zone IDs (FNV-1a of the name) for every zone
+static const uint32_t zones_ids[ZONES_COUNT] PROGMEM = {
+    0xbf09e573u, 0x8a7a4848u, 0xd0a40347u, 0x97f3c9d7u, 0x1e9c706bu, 0xa30c41b5u,
+    0xdaadd50cu, 0x26d08f98u, 0x2d919b89u, 0xbcd0a23fu, 0x9c3899e6u, 0x03f326c3u,
+    0xea8d067cu, 0x9d46d8d5u, 0x02176fb4u, 0xd435f4b1u, 0xedc8b11fu, 0x16a558f8u,
+    0x335e9c26u, 0x29319a30u, 0x9aefb58cu, 0x47a1e57eu, 0x01705d3du, 0x2c07183bu,
+    0x32957e52u, 0x4f17c560u, 0x5b083fbbu, 0xb52adee7u, 0xbdf2f38bu, 0x8085e070u,
+    0x151eeb2au, 0xd8ec8642u, 0xc606962bu, 0x8479eb87u, 0x0f910492u, 0xa1fa1033u,
+    0x1a629ffau, 0xa0362ea0u, 0xf4559c17u, 0x668a0926u, 0x86ec5aa7u, 0xa1b683b3u,
+    0x290a0946u, 0xde108d60u, 0x66b415cdu, 0xc9855702u, 0x2743126au, 0xb3338427u,
+    0x3310b275u, 0x04ba57f3u, 0xa3887bebu, 0xbbf13aafu, 0xcf37f849u, 0x8388b3e4u,
+    0x30323aadu, 0x7d6a8987u, 0x8935717du, 0xca600c69u, 0x796d7b7fu, 0x97901e76u,
+    0x60f9dae1u, 0x16ded075u, 0x7045bc4eu, 0x394af297u, 0xa39f98f1u, 0x3ee4bb8bu,
+    0x2d6e52bau, 0xc385fd1bu, 0xc9259ab2u, 0xfe5e128fu, 0xd7b790f2u, 0xc3a4f5c8u,
+    0x8adf9cb5u, 0x62f59f62u, 0x1c29c09eu, 0x8111f1adu, 0xabb6332bu, 0x0f6163aau,
+    0xd45eb960u, 0xf20ef746u, 0xcce44d52u, 0x53869679u, 0x6b20b1f6u, 0xb38be558u,
+    0xcb528c5au, 0x1367a775u, 0x151e5589u, 0x365363d4u, 0xd6283302u, 0x3b037304u,
+    0xad9886cau, 0xa8f20277u, 0x53c1275au, 0x6ad1dfdcu, 0x869e3c80u, 0x24a79c47u,
+    0x686b615cu, 0x7e0adc17u, 0x4faf37feu, 0xebea80d2u, 0xf114226du, 0x5bbd5288u,
+    0x25d5a177u, 0xe5bdb30au, 0x3498ac69u, 0xcf31c5a5u, 0xbc53c6e0u, 0x36147c3bu,
+    0x30f758eeu, 0x686893cfu, 0xe340dd05u, 0x07213b7au, 0x5dee8317u, 0xd77dee9bu,
+    0xf792be2bu, 0x0d80f950u, 0x5e5b13d2u, 0xc87a49e5u, 0x898d16b4u, 0x0a730cb6u,
+    0xe7cd241au, 0xcf9a74ceu, 0xab73e630u, 0x236cb7c1u, 0x8e6d072cu, 0x89e41efbu,
+    0x7afb85aeu, 0x044685d6u, 0x27fa3213u, 0xfd0ed995u, 0xebc8b203u, 0xcd789167u,
+    0xa3989009u, 0x99387cd4u, 0x4508f384u, 0xe2d24aceu, 0x7d1a9566u, 0x051cc24bu,
+    0x3ea12dc3u, 0x23b262fbu, 0x3c95ead7u, 0x8ceab754u, 0x2a9396ddu, 0xc7321684u,
+    0x9a1da2acu, 0xa6081577u, 0x47f6d02cu, 0x26c46b64u, 0x36870b5fu, 0x457781b0u,
+    0xe325dc7eu, 0x35c21c5fu, 0x864702e9u, 0x0796405cu, 0xc052dfe2u, 0x543d0ef5u,
+    0xde842ec1u, 0x78fa75a6u, 0xe192c222u, 0x7d5acd92u, 0x9e3ec36du, 0xe4da8899u,
+    0x140a6620u, 0x944a76f1u, 0xd69bf6b2u, 0xb317bfbfu, 0x0d8ee0beu, 0xc01875e7u,
+    0x13ac84edu, 0xfbb761d5u, 0x29446fe1u, 0x05654224u, 0xb689169eu, 0xb7f9f738u,
+    0x67afb100u, 0x08c2854fu, 0xa3300aaeu, 0x75b5030fu, 0xaaea918au, 0x9179d2a5u,
+    0x84616a89u, 0x403618a8u, 0x0d6f7a68u, 0x0a3d9401u, 0x6a2ce86eu, 0x105682adu,
+    0xa5d03082u, 0x9fb03810u, 0x154cc4e3u, 0x88a6687du, 0x0d198d72u, 0x126d63b4u,
+    0xc7452675u, 0x8adb80e4u, 0xbfd5a989u, 0xe87de3cbu, 0x7ca6fc4bu, 0x6c12d442u,
+    0xdf76a985u, 0xa448f747u, 0xa793b71du, 0xb36acd21u, 0x75de8761u, 0x99a17f62u,
+    0xdd18ea92u, 0xd97fdd83u, 0x096adc77u, 0x80a7d409u, 0x4c928285u, 0xe912db7bu,
+    0xca03b031u, 0xbe4a7584u, 0xa9ca929bu, 0x5c4f25d2u, 0xc64adc6cu, 0x4391107eu,
+    0x48394fd1u, 0x7884b118u, 0x1573e2d2u, 0x3dcb75bfu, 0x8e57470cu, 0x503dc8b7u,
+    0x270ed30du, 0xdbffe145u, 0x39e5c8bdu, 0x20cfedd1u, 0xde01881fu, 0x0124a15fu,
+    0xbc03606du, 0x190bc005u, 0xd16aa440u, 0x4d386c51u, 0xc89ec203u, 0xbe181427u,
+    0x1ba19858u, 0x6b2f60cdu, 0x19b04026u, 0x7371bcebu, 0xda1fb251u, 0x10a0f02au,
+    0xcc18acd9u, 0x9af27096u, 0xd0d6464fu, 0xe0aa9e5fu, 0xc9d160e2u, 0xb0f63a1du,
+    0xb8ffe55eu, 0xfaaf5187u, 0xac41aaadu, 0xd5c98f4du, 0x6706f6bbu, 0x718c28c3u,
+    0xeebfa085u, 0x7339b6f0u, 0x5d1a2684u, 0x505b70c1u, 0xa76d1515u, 0x6f433821u,
+    0x1c2ff935u, 0xdc444367u, 0x2b6486e8u, 0xebc4bae9u, 0x9abef296u, 0x41b4c5ffu,
+    0x59bc664fu, 0xd248042eu, 0x344abdb0u, 0x949d098au, 0xdde257d5u, 0x3b531e62u,
+    0x61db443du, 0x8c8b2c5fu, 0xbefc6c3bu, 0x334a20e9u, 0x63e7d6cau, 0x488f56f8u,
+    0xb5393381u, 0xda5ab2b2u, 0xe23de65du, 0x9c054990u, 0xa8dc3202u, 0x184e6476u,
+    0x00ffa612u, 0x412b3ea9u, 0x8eeb637eu, 0x8be415dau, 0x900a1838u, 0xab8083a3u,
+    0x7ea12f63u, 0x2a9c6f69u, 0xb4fce960u, 0xbee32f3cu, 0x215f0598u, 0x67627258u,
+    0xa8f0fa30u, 0xe617ca18u, 0x3a3292e6u, 0x54072282u, 0x37150e50u, 0xfa2f94a3u,
+    0x500da217u, 0x636d5dfcu, 0x0190f190u, 0x546bdfd3u, 0x2021d904u, 0x0e70bef7u,
+    0x0ad00ebeu, 0x73d4ef07u, 0xd084eaa8u, 0x04f252bdu, 0x8d527a6au, 0x627ed078u,
+    0xa340648eu, 0x5cc4672bu, 0xd4d24271u, 0x2c198415u, 0x7fd5a7f2u, 0xbead98cau,
+    0x57d0a2b9u, 0x56d0a126u, 0xc06d95a2u, 0xc16d9735u, 0xbe6d927cu, 0x55d09f93u,
+    0x54d09e00u, 0x5bd0a905u, 0x5ad0a772u, 0x59d0a5dfu, 0x58d0a44cu, 0x5fd0af51u,
+    0x5ed0adbeu, 0x5bdfb38fu, 0x5adfb1fcu, 0xda24e424u, 0xdb24e5b7u, 0xdc24e74au,
+    0xdd24e8ddu, 0xd624ddd8u, 0x5ddfb6b5u, 0x5cdfb522u, 0x57dfad43u, 0x56dfabb0u,
+    0x59dfb069u, 0x58dfaed6u, 0x63dfc027u, 0x62dfbe94u, 0x2547d18eu, 0x5edaa64au,
+    0xa6cd5f5eu, 0x89fc8fecu, 0x7c58b2fbu, 0x299d01c8u, 0xd31f79b8u, 0x3254d54du,
+    0x593a435du, 0xe44314d9u, 0xa0f29f32u, 0x31405cd4u, 0xc4ee4377u, 0xad2a9fd1u,
+    0xd9217e23u, 0x92f933a6u, 0xe0bb4979u, 0x2b2807eeu, 0x73ea5cb8u, 0x647b7116u,
+    0x83d49e3cu, 0x48045a82u, 0x2b125bb5u, 0xf5e78532u, 0x087b2252u, 0x1a408790u,
+    0x762c96a8u, 0xa5a264abu, 0x23993fd7u, 0xe61883dbu, 0xa9f332bbu, 0xbe803f4eu,
+    0xda3292a4u, 0x7b669695u, 0x48115e29u, 0x5a2fae4au, 0x92f733eau, 0x3d58a0fbu,
+    0x0082155cu, 0x7ab7ac0fu, 0x6dfa7f8fu, 0x7f23c0b0u, 0xdaf5d05cu, 0x6a4c2015u,
+    0xcae2d7ddu, 0x13c63993u, 0x31134943u, 0x54cf41cfu, 0x24cf1036u, 0xa48ef8d4u,
+    0xfd3ce6a4u, 0xa11cbf72u, 0x65f13f8cu, 0x8cf030beu, 0xd7a437fbu, 0x89cc11c8u,
+    0x36532a60u, 0xad8ae11cu, 0xc76b4068u, 0x52b4e733u, 0x82d14916u, 0xca6a4e5bu,
+    0x9473f5d3u, 0xae3e0b5bu, 0x963b1af7u, 0x9d521a4bu, 0xa82aef65u, 0xccabacfeu,
+    0x2756f85du, 0xa81fd8ccu, 0x75492e6eu, 0x7d7e04b5u, 0x519b3aa2u, 0xd91f8e4au,
+    0x8c9b2d82u, 0xd1f46bc8u, 0x0e88bec9u, 0x960d7242u, 0x211e0a68u, 0xb4038b66u,
+    0x8455de0fu, 0x244a6c65u, 0xa0f64ffbu, 0x6cad5636u, 0xb7043b25u, 0x38f99092u,
+    0xdd92c2b5u, 0xbb3eaae3u, 0xced865bcu, 0x77346a86u, 0x18228c0cu, 0x0d42fc7fu,
+    0x8fb2e4ffu, 0xc78ebb26u, 0xed1ec704u, 0x05c0aa0fu, 0x277a3b1du, 0xb1099405u,
+    0x41c020d4u, 0x72062516u, 0x36e0e036u, 0x1c558b66u, 0xfe29c2fau, 0x1c9e9d88u,
+    0xd88b6524u, 0x6595d0f9u, 0x37188650u, 0x9dcce782u, 0xd7a01530u, 0x28809bd7u,
+    0xc609fa2au, 0xf60b26b3u, 0x1478d996u, 0x310d803du, 0x583c4695u,
+};
+
+// Zone indexes sorted by zone ID
+static const uint16_t zones_by_id[ZONES_COUNT] PROGMEM = {
+    384, 282, 227, 22, 302, 14, 11, 127, 49, 309,
+    137, 171, 441, 111, 153, 370, 175, 206, 183, 119,
+    306, 190, 437, 182, 115, 166, 305, 422, 77, 34,
+    185, 239, 191, 85, 168, 391, 162, 458, 86, 30,
+    188, 218, 17, 61, 436, 281, 229, 236, 371, 36,
+    234, 74, 258, 447, 449, 4, 304, 225, 424, 292,
+    123, 374, 139, 427, 95, 394, 346, 102, 147, 7,
+    222, 46, 414, 442, 128, 455, 42, 19, 170, 351,
+    142, 289, 368, 363, 260, 23, 315, 66, 8, 54,
+    108, 459, 392, 357, 353, 24, 48, 273, 18, 266,
+    104, 151, 107, 402, 87, 148, 446, 298, 452, 431,
+    63, 224, 296, 89, 269, 140, 383, 219, 138, 65,
+    181, 283, 263, 444, 215, 134, 149, 21, 146, 367,
+    380, 216, 275, 208, 231, 25, 98, 300, 221, 255,
+    418, 405, 81, 92, 297, 155, 303, 393, 324, 323,
+    319, 341, 318, 340, 460, 328, 343, 354, 264, 327,
+    342, 381, 326, 332, 26, 101, 325, 331, 213, 313,
+    339, 254, 338, 112, 116, 330, 347, 329, 60, 270,
+    311, 345, 73, 301, 344, 274, 365, 451, 398, 39,
+    44, 250, 293, 174, 109, 96, 184, 389, 93, 82,
+    235, 197, 429, 386, 257, 62, 251, 445, 253, 237,
+    307, 364, 416, 177, 202, 372, 435, 217, 157, 58,
+    385, 126, 379, 350, 196, 136, 159, 55, 417, 97,
+    288, 387, 316, 29, 207, 75, 406, 53, 366, 426,
+    180, 33, 152, 94, 40, 189, 56, 118, 401, 125,
+    349, 1, 193, 72, 285, 271, 420, 141, 399, 310,
+    220, 124, 284, 438, 286, 179, 382, 361, 163, 408,
+    267, 423, 410, 59, 3, 133, 203, 144, 262, 20,
+    241, 279, 10, 13, 411, 453, 160, 187, 37, 356,
+    428, 397, 41, 35, 5, 176, 312, 50, 132, 64,
+    199, 395, 373, 186, 145, 348, 256, 200, 415, 412,
+    280, 294, 91, 212, 376, 178, 122, 287, 76, 248,
+    359, 403, 90, 409, 245, 443, 165, 47, 201, 83,
+    425, 290, 27, 276, 172, 430, 173, 246, 433, 51,
+    228, 106, 9, 28, 233, 211, 322, 377, 317, 291,
+    272, 0, 194, 167, 154, 320, 321, 67, 71, 358,
+    32, 456, 214, 143, 192, 404, 439, 117, 232, 68,
+    45, 244, 210, 57, 407, 390, 84, 240, 413, 80,
+    131, 434, 105, 52, 121, 308, 2, 242, 230, 421,
+    265, 352, 15, 78, 314, 249, 337, 88, 164, 113,
+    454, 400, 70, 450, 31, 419, 360, 205, 238, 333,
+    378, 277, 6, 388, 334, 223, 335, 259, 204, 336,
+    432, 268, 226, 43, 156, 198, 243, 362, 158, 278,
+    135, 150, 110, 355, 161, 103, 295, 375, 120, 195,
+    209, 12, 261, 130, 99, 440, 16, 252, 100, 79,
+    38, 369, 457, 114, 299, 247, 169, 129, 396, 448,
+    69,
+};
+
+static const uint8_t zones_json_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x5b, 0x6d, 0x53, 0xdb, 0xba,
+    0x12, 0xfe, 0x2f, 0xe7, 0x6b, 0x4f, 0x4a, 0x12, 0x02, 0x85, 0x33, 0x67, 0x32, 0x03, 0x81, 0xf2,
+    0x12, 0x42, 0x73, 0x89, 0x0b, 0xd3, 0x7e, 0xc9, 0x6c, 0x62, 0x61, 0x0b, 0xdb, 0x52, 0x2a, 0x5b,
+    0xa1, 0xe1, 0xce, 0xfd, 0xef, 0x77, 0x25, 0x59, 0x8e, 0x1d, 0xab, 0x44, 0x7c, 0xa1, 0x74, 0x77,
+    0xb5, 0x92, 0xf6, 0x4d, 0xcf, 0x4a, 0xe6, 0xbf, 0x7f, 0x9d, 0x3d, 0x0b, 0xba, 0x84, 0x83, 0xb3,
+    0x05, 0x0d, 0x5f, 0x80, 0xfd, 0xf5, 0xcf, 0x5f, 0x57, 0x93, 0xa0, 0xfb, 0xd7, 0xdf, 0x15, 0x7d,
+    0xb9, 0x14, 0xd0, 0xa6, 0x86, 0x21, 0xcd, 0xe7, 0x67, 0x0b, 0x58, 0x28, 0xde, 0xe5, 0x59, 0xd0,
+    0x39, 0xac, 0x31, 0xd3, 0x88, 0x12, 0x91, 0x23, 0x63, 0x74, 0x19, 0x74, 0x7a, 0x35, 0x46, 0x9e,
+    0x81, 0x70, 0x0c, 0x38, 0x87, 0x0c, 0x12, 0xde, 0x9a, 0xe4, 0x1c, 0x58, 0x24, 0x29, 0x92, 0x9f,
+    0xce, 0x1a, 0x6a, 0x90, 0xfe, 0x22, 0xd3, 0xb6, 0x38, 0xcd, 0x73, 0x90, 0x6d, 0x72, 0x0a, 0xac,
+    0xd8, 0x08, 0xa2, 0x96, 0x83, 0x7a, 0xfa, 0x35, 0x8e, 0x80, 0xb7, 0x37, 0x58, 0xd3, 0x34, 0x25,
+    0x8e, 0x49, 0xe4, 0x8b, 0xcc, 0x16, 0x52, 0x2f, 0x77, 0x67, 0xdc, 0x08, 0xa8, 0x50, 0xab, 0xbd,
+    0xc4, 0xdd, 0xf5, 0x2f, 0x2f, 0x67, 0xc1, 0xdf, 0x93, 0xc1, 0xe7, 0xa3, 0xcf, 0x47, 0x07, 0xdd,
+    0xbf, 0x27, 0xbd, 0x2e, 0xfe, 0x36, 0x38, 0xe8, 0x0f, 0xea, 0xe2, 0x39, 0x2c, 0x70, 0x11, 0x4b,
+    0xa5, 0xea, 0xdf, 0x4f, 0xdd, 0xde, 0xb0, 0x3e, 0xcf, 0x88, 0xc8, 0x02, 0xac, 0xa9, 0x46, 0x5a,
+    0xd9, 0x21, 0xaa, 0xb0, 0xaa, 0xba, 0x07, 0x35, 0x3b, 0x8d, 0x38, 0x83, 0x44, 0x6c, 0x5a, 0x5b,
+    0xbc, 0x80, 0x04, 0x84, 0x83, 0x2a, 0xe6, 0x24, 0x9f, 0xcf, 0x20, 0x05, 0xc8, 0xda, 0x46, 0xbf,
+    0x78, 0xa1, 0x0b, 0x2e, 0x0b, 0xea, 0xe0, 0x70, 0x89, 0x63, 0xda, 0x26, 0xb9, 0x4c, 0xe7, 0x67,
+    0x40, 0x25, 0x73, 0x6d, 0xe3, 0xab, 0x20, 0xa4, 0xe0, 0xaf, 0xed, 0xf8, 0xb9, 0x82, 0x05, 0x17,
+    0x9c, 0x39, 0xcc, 0x7f, 0x8d, 0xb1, 0xe0, 0x72, 0xcb, 0x2d, 0x8f, 0x81, 0x31, 0x92, 0xa3, 0xf1,
+    0x23, 0xe4, 0xce, 0xce, 0x66, 0x4d, 0xb6, 0x5c, 0x38, 0x7c, 0x32, 0x86, 0x6c, 0x65, 0x16, 0xbd,
+    0xb3, 0x99, 0x71, 0x0c, 0xa2, 0xe0, 0x32, 0x73, 0x0c, 0xa1, 0x11, 0xa4, 0xd4, 0x45, 0x67, 0x79,
+    0x8c, 0x3e, 0x6b, 0x1b, 0xe0, 0x0e, 0x22, 0x9e, 0x3b, 0xc8, 0x74, 0x21, 0xc8, 0x1f, 0xc2, 0xe8,
+    0x8e, 0x67, 0xa4, 0x65, 0x93, 0x3b, 0x09, 0x2c, 0x74, 0xe9, 0x97, 0x0b, 0x8c, 0x39, 0xc8, 0x63,
+    0xc7, 0xaa, 0xee, 0x64, 0x8e, 0x5e, 0x6e, 0xd3, 0x27, 0xb8, 0xeb, 0x05, 0x6f, 0xeb, 0x9a, 0xc0,
+    0x4a, 0x16, 0xdc, 0x25, 0x9f, 0x13, 0x21, 0x1d, 0x76, 0x9d, 0xa8, 0x64, 0xd6, 0x7e, 0x6a, 0x71,
+    0x78, 0x04, 0x98, 0xee, 0xb1, 0x6c, 0x5b, 0x77, 0xc2, 0x99, 0xe0, 0x6b, 0xda, 0x2e, 0x10, 0xf7,
+    0x2a, 0x47, 0x16, 0x8e, 0xe0, 0xba, 0xc7, 0x2a, 0x93, 0x11, 0xe6, 0xd8, 0xfd, 0x3d, 0x45, 0xc6,
+    0xc6, 0x41, 0xc7, 0x70, 0x4c, 0x96, 0x31, 0x2f, 0x8a, 0xd6, 0x2c, 0xdf, 0x24, 0xe0, 0xd2, 0xb8,
+    0x8c, 0x78, 0x3b, 0xef, 0xa7, 0x1c, 0xfd, 0xde, 0xb9, 0xe7, 0x6b, 0x87, 0x71, 0x66, 0xc0, 0xe7,
+    0x81, 0xcb, 0x33, 0x81, 0xa0, 0x2b, 0xae, 0x83, 0x42, 0x27, 0x77, 0x8d, 0x21, 0x19, 0x75, 0x54,
+    0xb4, 0x27, 0xca, 0xc2, 0x98, 0x93, 0xa4, 0x6e, 0xe7, 0x8c, 0x94, 0x25, 0x12, 0x14, 0xf9, 0x7a,
+    0x16, 0xf4, 0xba, 0xd7, 0x17, 0x3a, 0xad, 0xfb, 0x3a, 0xad, 0x7b, 0x9f, 0x7b, 0x9f, 0xbb, 0x75,
+    0x41, 0x86, 0x9b, 0x13, 0x10, 0xa9, 0xd5, 0x9c, 0x8d, 0x67, 0xc1, 0xe9, 0xd9, 0xf8, 0x7d, 0x71,
+    0x2c, 0x8a, 0xa9, 0x0e, 0x75, 0xf4, 0xd3, 0xa0, 0xc1, 0x29, 0x68, 0x24, 0x5d, 0x0c, 0xd4, 0x2e,
+    0x81, 0x6a, 0xa3, 0xff, 0xdb, 0xe9, 0x1e, 0x0e, 0x0f, 0x1b, 0xcc, 0x88, 0xe0, 0x40, 0xa6, 0x4a,
+    0x1e, 0x61, 0x1c, 0xab, 0x3a, 0x15, 0x24, 0x7f, 0x5f, 0x72, 0x04, 0x05, 0x96, 0x6c, 0xb1, 0xdc,
+    0xa3, 0x70, 0xc4, 0x45, 0xc8, 0x17, 0x7b, 0x84, 0x6e, 0xb1, 0xd0, 0x6e, 0xde, 0x17, 0xb9, 0x83,
+    0xf9, 0x03, 0xe5, 0x2f, 0x7b, 0x14, 0x4d, 0x08, 0x0b, 0xf9, 0xdb, 0x1e, 0x21, 0xd4, 0x33, 0xbf,
+    0x02, 0x4c, 0x55, 0x93, 0xc9, 0xef, 0x48, 0x62, 0xdd, 0x2c, 0x60, 0x9f, 0x08, 0x9b, 0xdf, 0x4a,
+    0x7d, 0x68, 0xee, 0x91, 0xba, 0x93, 0x74, 0xcf, 0x74, 0x81, 0x5c, 0xca, 0x6c, 0x9f, 0xaa, 0xef,
+    0x98, 0x84, 0x40, 0xff, 0xb0, 0x2a, 0x53, 0x17, 0x77, 0x5d, 0x9f, 0x4b, 0xb6, 0xa4, 0xbc, 0xd4,
+    0x3b, 0x18, 0x0e, 0xf4, 0x40, 0x7d, 0xb8, 0x60, 0x58, 0xa9, 0x13, 0xeb, 0xf0, 0xf3, 0x40, 0xfd,
+    0x52, 0x1f, 0x53, 0xd0, 0x84, 0x27, 0x7a, 0x2d, 0x78, 0x1e, 0x1d, 0xd5, 0x38, 0xe7, 0x10, 0xbb,
+    0x67, 0xd7, 0x8c, 0x39, 0x1e, 0xcc, 0x21, 0x11, 0xa0, 0xf3, 0x64, 0x16, 0x1c, 0x37, 0xf8, 0x62,
+    0x81, 0x89, 0x9a, 0xb7, 0x17, 0x78, 0x4e, 0x52, 0x92, 0x39, 0x55, 0x92, 0x94, 0xbe, 0x11, 0x87,
+    0x2a, 0x75, 0x94, 0x76, 0x66, 0x78, 0xa4, 0xea, 0x5d, 0xed, 0xaa, 0xe3, 0x30, 0x7f, 0xa4, 0xb9,
+    0xf5, 0x1c, 0x6e, 0xb8, 0xc1, 0x8c, 0xb8, 0xe5, 0x1c, 0x0d, 0x1b, 0x1b, 0xe3, 0x34, 0x57, 0x73,
+    0x4d, 0x66, 0xc1, 0x97, 0xc9, 0x7b, 0xd9, 0x37, 0x82, 0x6c, 0x21, 0x68, 0x18, 0x11, 0xdc, 0xec,
+    0xc6, 0x73, 0xc0, 0x0a, 0x43, 0x4e, 0x28, 0xd3, 0xb8, 0xd6, 0x34, 0xc2, 0xdd, 0x48, 0x87, 0xa9,
+    0x47, 0x78, 0x3a, 0x2e, 0x21, 0x77, 0x0f, 0xd9, 0x10, 0xc6, 0x88, 0xcb, 0x68, 0xc8, 0xca, 0x5c,
+    0x8e, 0x1b, 0xc5, 0xf8, 0x33, 0xe2, 0xa5, 0x35, 0x47, 0xef, 0x2e, 0x38, 0xa6, 0x18, 0x64, 0xb1,
+    0xae, 0x23, 0x3b, 0xa6, 0x1f, 0x71, 0x34, 0x2c, 0xa6, 0xe2, 0xd2, 0xc5, 0xc3, 0xa2, 0x51, 0x68,
+    0x8f, 0x28, 0x93, 0xd4, 0x19, 0x92, 0xc2, 0xc2, 0xe9, 0x8e, 0x91, 0x54, 0x5b, 0xe4, 0x6d, 0x27,
+    0x5e, 0x00, 0xc3, 0xea, 0x92, 0xe0, 0x29, 0xbc, 0xae, 0x03, 0x8a, 0x8a, 0xfb, 0x9a, 0xbb, 0x26,
+    0x32, 0xf4, 0x39, 0x2e, 0x44, 0xd7, 0xe3, 0x5d, 0x2e, 0x61, 0x6b, 0x22, 0x7c, 0x3c, 0x76, 0x41,
+    0x0a, 0xc1, 0x69, 0x51, 0x1a, 0xf1, 0xf2, 0x5d, 0x51, 0x9e, 0x51, 0x66, 0xcc, 0xb1, 0xb3, 0x85,
+    0xcb, 0x30, 0xe3, 0x6c, 0x6b, 0x8f, 0x77, 0x27, 0xbc, 0xa4, 0x42, 0x32, 0xb2, 0x22, 0xae, 0xc0,
+    0x44, 0xcc, 0x85, 0x85, 0x68, 0x8d, 0xb9, 0x23, 0xda, 0x36, 0xff, 0x8a, 0x47, 0xdc, 0xfc, 0x9e,
+    0xa4, 0x4e, 0x73, 0x28, 0x26, 0xa4, 0xc4, 0x5d, 0x10, 0xaf, 0x52, 0x58, 0xda, 0x10, 0x56, 0x2b,
+    0x3f, 0x7b, 0x6f, 0x7d, 0x57, 0x3c, 0x2c, 0x62, 0x58, 0x18, 0x3d, 0xfd, 0x61, 0x1f, 0x7f, 0xf6,
+    0x86, 0x25, 0x4c, 0x3d, 0xe8, 0xf4, 0x2a, 0xa4, 0xda, 0x1c, 0xc3, 0x73, 0xff, 0x09, 0x54, 0x76,
+    0xcc, 0x03, 0x29, 0x12, 0x1f, 0xa3, 0x5f, 0x09, 0x84, 0x0f, 0xa1, 0xc3, 0xe6, 0x57, 0x12, 0x42,
+    0x92, 0x72, 0xa9, 0x2d, 0xd9, 0xe6, 0x15, 0x24, 0x33, 0x08, 0x71, 0xc7, 0x8a, 0xc8, 0xda, 0xc0,
+    0x2f, 0x3c, 0x53, 0x5d, 0xf6, 0xbf, 0x92, 0x1b, 0x60, 0xce, 0xe8, 0xbd, 0x46, 0xf0, 0xf8, 0x0c,
+    0xbf, 0x7d, 0xf6, 0x77, 0x0d, 0x6b, 0xa3, 0x04, 0x67, 0x3e, 0xda, 0x26, 0xdf, 0x41, 0x25, 0x7b,
+    0xd0, 0xab, 0x4b, 0x13, 0x91, 0xf1, 0x1c, 0x8f, 0x78, 0xde, 0x76, 0xea, 0x0d, 0x0b, 0x29, 0xaa,
+    0xb2, 0xff, 0x2a, 0xac, 0x92, 0xfb, 0xd8, 0xcc, 0x8e, 0x1b, 0x33, 0xfe, 0xdb, 0xa7, 0x08, 0x58,
+    0xf9, 0x09, 0x22, 0x74, 0xa6, 0xeb, 0x86, 0xf7, 0x14, 0x53, 0x52, 0x60, 0xf3, 0x57, 0x82, 0x77,
+    0xef, 0x51, 0x01, 0x49, 0xd3, 0xf9, 0x88, 0x16, 0x9b, 0x8f, 0xac, 0xee, 0x91, 0xac, 0x75, 0x80,
+    0x79, 0xcf, 0xf2, 0x48, 0xd9, 0x52, 0x95, 0xce, 0x0f, 0xd9, 0x0c, 0x31, 0x1e, 0x82, 0x9d, 0xa5,
+    0xdf, 0x10, 0xb9, 0xa6, 0x89, 0x4f, 0xce, 0xdf, 0xfc, 0x82, 0x54, 0xfa, 0x15, 0x99, 0x5b, 0x9c,
+    0xdd, 0xd4, 0x98, 0x9d, 0xa2, 0x7e, 0x8b, 0x55, 0x43, 0x37, 0xbc, 0x1e, 0xa8, 0x71, 0x8c, 0x08,
+    0x42, 0x2e, 0x93, 0x0d, 0x36, 0x24, 0x08, 0x45, 0x6c, 0xb3, 0xb2, 0x77, 0xee, 0x6a, 0x18, 0x02,
+    0xfd, 0x82, 0x2e, 0x89, 0x09, 0xca, 0xfd, 0xc3, 0x04, 0x56, 0x1e, 0x34, 0xdf, 0x4b, 0xd2, 0xce,
+    0x44, 0x04, 0x73, 0x53, 0x78, 0x73, 0x65, 0xd4, 0x1d, 0xcd, 0x9c, 0x87, 0xf3, 0x9d, 0x02, 0xa5,
+    0x2c, 0x42, 0xa0, 0xa0, 0xfc, 0x36, 0x9d, 0x05, 0x27, 0xd3, 0xf7, 0x26, 0xbf, 0xe3, 0xaf, 0x44,
+    0xcc, 0xa7, 0x42, 0xf9, 0xda, 0x01, 0x38, 0x26, 0x58, 0xf9, 0x28, 0x77, 0x15, 0xc5, 0x09, 0x7a,
+    0x3b, 0x72, 0x9d, 0x7b, 0x8a, 0x21, 0x9d, 0x47, 0x31, 0xe6, 0x07, 0x45, 0x4c, 0xe1, 0x9a, 0x45,
+    0x20, 0x62, 0xa3, 0xbf, 0x24, 0x71, 0xf1, 0x10, 0x3d, 0x63, 0x53, 0x9c, 0xfb, 0xc4, 0xfa, 0x04,
+    0xde, 0xa0, 0x48, 0xc1, 0x51, 0xe0, 0x11, 0xef, 0xaa, 0xe3, 0x87, 0x10, 0x2f, 0x35, 0xf8, 0x4f,
+    0xe8, 0xda, 0x1a, 0x41, 0xe5, 0x89, 0x9a, 0xc1, 0x2f, 0x8e, 0x26, 0xe4, 0x37, 0x5d, 0xf2, 0x7a,
+    0xa6, 0xd6, 0x99, 0x6a, 0xbf, 0x29, 0xdf, 0x82, 0x58, 0x7d, 0x5e, 0xbc, 0xa3, 0x8c, 0xb3, 0x65,
+    0x51, 0xa1, 0xb8, 0x77, 0x4b, 0xa8, 0x8a, 0x3f, 0x22, 0x04, 0x71, 0xcd, 0xaa, 0x58, 0x6b, 0x1a,
+    0x12, 0xb7, 0x53, 0x91, 0x2b, 0x08, 0xa4, 0x3e, 0x61, 0xab, 0x64, 0xb1, 0x3b, 0x16, 0xe0, 0x70,
+    0xe8, 0x3d, 0x94, 0xb7, 0x4b, 0x7b, 0xb5, 0xdc, 0x93, 0xd7, 0xf9, 0x0f, 0xee, 0x77, 0x96, 0xdd,
+    0xd3, 0x15, 0xc6, 0x0f, 0xf3, 0x12, 0x35, 0xfd, 0xaa, 0x87, 0x8f, 0xee, 0xd5, 0x85, 0x4b, 0x0c,
+    0xd5, 0x79, 0xdd, 0x64, 0x15, 0xf1, 0xfc, 0x02, 0x12, 0xc4, 0xc1, 0x88, 0xb0, 0x65, 0x0a, 0xb1,
+    0x4f, 0xf4, 0x34, 0x86, 0x8d, 0x88, 0x72, 0xc5, 0x87, 0x87, 0x29, 0xb3, 0x20, 0x94, 0xd1, 0x60,
+    0x7f, 0xff, 0x48, 0x29, 0x93, 0x0f, 0xe1, 0x8d, 0x6f, 0x2f, 0x58, 0xa5, 0x23, 0xf0, 0xd1, 0x3d,
+    0x05, 0x55, 0xcf, 0xdb, 0xe5, 0x14, 0xe9, 0x11, 0xa3, 0xa2, 0x90, 0xcc, 0xeb, 0xe4, 0x9a, 0x22,
+    0x40, 0x47, 0x94, 0x4a, 0x17, 0xce, 0xb0, 0x9b, 0xc6, 0x9c, 0x30, 0xfa, 0xbb, 0x9d, 0xb5, 0xea,
+    0x5a, 0xa2, 0x03, 0xb2, 0x63, 0xea, 0x93, 0xd7, 0x44, 0x0a, 0xe5, 0xf1, 0xe7, 0xf9, 0x6c, 0x85,
+    0x2d, 0x7c, 0x3b, 0x30, 0xf5, 0x3d, 0xc7, 0xfc, 0x91, 0xa4, 0x31, 0x77, 0x55, 0xa8, 0xa9, 0x24,
+    0x8a, 0x8f, 0xa0, 0xdd, 0x01, 0xb4, 0xa7, 0x92, 0x21, 0xa0, 0x3f, 0x53, 0x80, 0xca, 0xd9, 0x9e,
+    0x3e, 0xe0, 0x8c, 0x1b, 0x1c, 0xbb, 0xf6, 0xf3, 0xf7, 0x03, 0xb0, 0x84, 0xb2, 0xf9, 0x0d, 0x4b,
+    0x49, 0xe1, 0x25, 0x4f, 0x96, 0xf4, 0xd9, 0xd9, 0xc7, 0x3c, 0x90, 0x88, 0x32, 0x47, 0xb9, 0x7a,
+    0x20, 0x39, 0x4f, 0x65, 0xe1, 0x55, 0xf2, 0x54, 0xab, 0x7f, 0x8e, 0xc8, 0x72, 0xc9, 0x5d, 0x87,
+    0x0a, 0x76, 0xe5, 0x05, 0x82, 0x1b, 0x67, 0xeb, 0xa9, 0x78, 0xd4, 0xb4, 0x4b, 0x8d, 0xa6, 0xf9,
+    0x14, 0x67, 0x38, 0x3e, 0xe8, 0x0f, 0xd4, 0x7d, 0xaf, 0xf9, 0x6d, 0x67, 0x10, 0x9f, 0xeb, 0x8e,
+    0x20, 0x72, 0x98, 0x5a, 0x5d, 0x39, 0x4d, 0x41, 0xa6, 0xce, 0x68, 0x99, 0x2d, 0x39, 0xb6, 0x4f,
+    0x8b, 0x0d, 0x36, 0xeb, 0xe1, 0x87, 0xc2, 0x7e, 0x46, 0x8b, 0xc4, 0xb3, 0x72, 0xcf, 0x0a, 0x84,
+    0xe3, 0x98, 0x8f, 0xaa, 0xdf, 0xde, 0x38, 0xd6, 0x57, 0xcc, 0x6f, 0x79, 0xcc, 0x54, 0x18, 0xdc,
+    0xcf, 0x82, 0xc3, 0x7f, 0x0e, 0xbb, 0xf7, 0x7b, 0xb4, 0x8d, 0x69, 0x51, 0xe4, 0x4e, 0x45, 0x77,
+    0x72, 0x49, 0xc1, 0xc9, 0x09, 0x62, 0x9e, 0x81, 0x7b, 0x90, 0xc1, 0x66, 0x8e, 0xca, 0x3b, 0x7b,
+    0xa5, 0xcf, 0xc5, 0x1c, 0x9b, 0x45, 0x61, 0xd8, 0x3b, 0x21, 0x11, 0x90, 0x08, 0xa7, 0x8b, 0x20,
+    0x5d, 0x39, 0xe2, 0x25, 0x88, 0x65, 0x4a, 0x7c, 0xce, 0x17, 0x14, 0x54, 0x77, 0x17, 0x65, 0xc7,
+    0xb2, 0x37, 0x27, 0x03, 0xfa, 0x22, 0x0d, 0xa4, 0xdf, 0x0b, 0x47, 0x02, 0x55, 0x8d, 0x0b, 0x2f,
+    0xd8, 0x14, 0xa8, 0x54, 0x76, 0xdd, 0xec, 0x3d, 0xaa, 0x28, 0x96, 0x26, 0x0b, 0xf7, 0x4e, 0xf8,
+    0x14, 0xd3, 0x82, 0xc4, 0x5c, 0x54, 0x17, 0x1a, 0x75, 0x1e, 0x65, 0x8c, 0xae, 0x48, 0xe4, 0x93,
+    0x3f, 0x3f, 0x20, 0x91, 0x85, 0x39, 0x0a, 0xf7, 0x47, 0xd7, 0x0f, 0x05, 0x0d, 0x5f, 0x13, 0x66,
+    0xf2, 0xf9, 0xcf, 0xf0, 0x57, 0x25, 0xdd, 0xb2, 0x28, 0x9f, 0x45, 0xf4, 0x69, 0xfe, 0xef, 0xa7,
+    0xee, 0xc9, 0xb0, 0x73, 0xd2, 0x64, 0x5e, 0xc0, 0xda, 0x5c, 0x98, 0x7d, 0xea, 0x7e, 0x19, 0x76,
+    0xbe, 0xec, 0x30, 0xa5, 0xea, 0xad, 0x2f, 0xbe, 0x0b, 0x0b, 0x63, 0xff, 0xfd, 0xd4, 0xeb, 0x0e,
+    0x3b, 0xbd, 0x9d, 0x09, 0x10, 0xe8, 0xfd, 0x92, 0x58, 0xa0, 0xb5, 0xff, 0xd1, 0xf6, 0x28, 0x70,
+    0xa6, 0xcd, 0x6f, 0xee, 0xbe, 0x4c, 0x12, 0x97, 0xef, 0x2b, 0xf5, 0x51, 0xe5, 0xed, 0x02, 0x4e,
+    0x7d, 0x34, 0xec, 0x1c, 0xed, 0x70, 0x97, 0x13, 0x29, 0x42, 0xe5, 0xcc, 0xfb, 0x9f, 0x4a, 0x63,
+    0xff, 0xfe, 0xa7, 0xd2, 0x78, 0x6a, 0x5e, 0x6c, 0x9c, 0x0a, 0xa7, 0x90, 0x66, 0xda, 0x71, 0xdb,
+    0xac, 0xdf, 0x32, 0x1f, 0x38, 0x26, 0xa4, 0x80, 0x3f, 0x70, 0x67, 0x1b, 0xfe, 0x5a, 0x3e, 0x1a,
+    0x1d, 0x0e, 0x3b, 0x3b, 0xcc, 0x40, 0xf0, 0x34, 0x35, 0xcc, 0xee, 0xb0, 0x8b, 0x3f, 0xfb, 0xc3,
+    0x4e, 0xdf, 0x96, 0x8b, 0x5e, 0xf3, 0xf9, 0x68, 0x3b, 0xea, 0x91, 0xe7, 0x05, 0x4f, 0x9a, 0xdb,
+    0xd3, 0x2c, 0x84, 0xcd, 0x2c, 0xda, 0x10, 0x10, 0x8b, 0x0d, 0x61, 0x7b, 0xdf, 0xa3, 0x72, 0xaa,
+    0x2e, 0xb8, 0x09, 0x6b, 0x2e, 0x4e, 0x53, 0xd3, 0x0c, 0x8a, 0x4d, 0x73, 0x02, 0x4d, 0xcf, 0xca,
+    0xdb, 0xcd, 0x1d, 0x71, 0x6c, 0xe5, 0x37, 0xc2, 0xf8, 0x10, 0x37, 0xd0, 0xeb, 0x57, 0x8c, 0x5f,
+    0x85, 0x86, 0x5b, 0xbb, 0x6a, 0x7e, 0x15, 0x7c, 0x41, 0x1c, 0xf4, 0x3c, 0x8e, 0x60, 0xa1, 0xa3,
+    0x75, 0x97, 0x53, 0x6c, 0x84, 0x4b, 0xd3, 0x39, 0x44, 0x71, 0x08, 0x61, 0x7b, 0x49, 0xe7, 0x10,
+    0x0b, 0x73, 0xd2, 0xb6, 0x18, 0x49, 0xa9, 0x67, 0x30, 0xec, 0x0c, 0xb6, 0x54, 0x16, 0x25, 0xd6,
+    0xa4, 0x36, 0x58, 0x0d, 0x43, 0x60, 0xdb, 0x90, 0x3a, 0x18, 0x84, 0x0a, 0x59, 0x34, 0x1f, 0x10,
+    0x8d, 0xdb, 0xba, 0xcd, 0x22, 0xaf, 0x85, 0x69, 0x1e, 0x27, 0xa4, 0x54, 0x7f, 0x3c, 0xec, 0x1c,
+    0x57, 0x0c, 0x75, 0x69, 0x44, 0x9b, 0x09, 0xa4, 0xe8, 0x23, 0x4c, 0xff, 0x32, 0x68, 0x4e, 0x87,
+    0x9d, 0xd3, 0x2d, 0x99, 0xd3, 0x05, 0xa4, 0xb9, 0x75, 0x42, 0x63, 0x08, 0x4f, 0x79, 0x66, 0x70,
+    0x0c, 0xda, 0xe8, 0x10, 0x73, 0xe9, 0x08, 0xeb, 0xbf, 0xe5, 0x5e, 0x20, 0xcc, 0xc9, 0x97, 0x32,
+    0x6f, 0x1b, 0xe4, 0x22, 0x36, 0x4f, 0x52, 0x3b, 0x2b, 0xbb, 0xa0, 0x29, 0x6d, 0x2f, 0xe0, 0x42,
+    0x2e, 0x80, 0xb6, 0xcd, 0x77, 0x21, 0xf3, 0x18, 0x98, 0xcb, 0xa5, 0x5f, 0x71, 0xde, 0x48, 0x9a,
+    0xab, 0xdc, 0x96, 0xa5, 0x0e, 0x2b, 0x4b, 0x55, 0x9a, 0xae, 0xe0, 0xad, 0x25, 0x3a, 0xf8, 0x3c,
+    0x38, 0x38, 0x32, 0x56, 0x35, 0xbf, 0x5a, 0xe1, 0x6b, 0xb2, 0x10, 0x06, 0x77, 0xfb, 0x89, 0x63,
+    0xcb, 0x13, 0xd3, 0xf9, 0x84, 0xb2, 0xb8, 0xed, 0xcf, 0x6b, 0xcc, 0x9c, 0xf9, 0x98, 0x6b, 0xd8,
+    0x78, 0x3d, 0x0e, 0xb6, 0x76, 0xbd, 0xe6, 0xeb, 0xb0, 0x2d, 0x7e, 0x23, 0xb0, 0xae, 0xe6, 0x49,
+    0xdb, 0x0d, 0xb7, 0xea, 0x19, 0x57, 0x6f, 0xf7, 0xe9, 0xe6, 0x7c, 0x2b, 0x7f, 0x0b, 0x1b, 0x58,
+    0x99, 0x87, 0xe8, 0xa7, 0x9b, 0x60, 0x6b, 0xd0, 0x5b, 0x22, 0x64, 0x5e, 0x02, 0xea, 0x1b, 0xf5,
+    0x62, 0x77, 0x73, 0x51, 0x6d, 0xa2, 0x7f, 0x6c, 0xed, 0x63, 0xa5, 0xc7, 0xb0, 0xb0, 0xb1, 0x38,
+    0x50, 0x1e, 0x1e, 0xd4, 0x3c, 0x3c, 0x86, 0x6c, 0x19, 0x43, 0x51, 0xfa, 0xb2, 0x99, 0x87, 0x63,
+    0x75, 0x0f, 0xad, 0x1f, 0x24, 0xa7, 0xb8, 0xb5, 0xa3, 0x2d, 0xb9, 0x88, 0x31, 0xa1, 0x43, 0x9b,
+    0x58, 0x03, 0xe5, 0xb9, 0x7f, 0x06, 0x5b, 0x3e, 0x3a, 0x35, 0xdc, 0x44, 0x8e, 0x40, 0x1c, 0xf3,
+    0x14, 0xfb, 0x4d, 0x28, 0x17, 0x5d, 0x0f, 0xb4, 0xb1, 0x80, 0x9c, 0xf1, 0x0d, 0x88, 0xdc, 0x91,
+    0x4d, 0x63, 0xf5, 0x26, 0x8d, 0xc8, 0x22, 0x43, 0x53, 0xb4, 0x4d, 0x37, 0x96, 0xb8, 0x46, 0xed,
+    0x80, 0x16, 0xe3, 0x15, 0x68, 0xd1, 0x0e, 0x5d, 0x3c, 0x1c, 0x74, 0x51, 0xc0, 0x53, 0x70, 0x2b,
+    0x3c, 0x51, 0xaf, 0x89, 0x65, 0x82, 0xf4, 0xd4, 0xfb, 0x76, 0x6f, 0xcb, 0x49, 0x54, 0xff, 0x27,
+    0x8c, 0x0f, 0xce, 0xea, 0x43, 0x18, 0x4d, 0x4b, 0x1c, 0x50, 0xa3, 0xca, 0x7c, 0x69, 0x6b, 0x51,
+    0x3d, 0xd8, 0xef, 0x11, 0x85, 0xe7, 0xd4, 0x37, 0xa0, 0xd5, 0xdb, 0x65, 0x22, 0xdf, 0x18, 0x29,
+    0x5c, 0x06, 0x51, 0xdc, 0x9c, 0x2e, 0xa8, 0xd3, 0x5a, 0xdf, 0xb2, 0xdc, 0x51, 0x32, 0xbe, 0x09,
+    0x48, 0xdb, 0x79, 0x36, 0x8d, 0x19, 0xcf, 0xe6, 0x53, 0xe2, 0x0a, 0xed, 0xa9, 0xba, 0xf6, 0x41,
+    0xa0, 0x93, 0xec, 0x06, 0xe5, 0x74, 0xa3, 0x8e, 0x0b, 0xd0, 0x26, 0x47, 0x74, 0xb0, 0x75, 0xef,
+    0x7f, 0xd0, 0xb7, 0xa2, 0x6d, 0xef, 0xff, 0x6c, 0xde, 0x36, 0x29, 0x17, 0x21, 0xb4, 0xe7, 0x7f,
+    0xa0, 0x1b, 0x08, 0xe3, 0xf6, 0x90, 0x19, 0x24, 0x31, 0xa4, 0xd4, 0xe5, 0x8e, 0x99, 0xea, 0xbc,
+    0x12, 0x60, 0x61, 0x5b, 0xdb, 0x8c, 0x70, 0x1d, 0xe7, 0x8d, 0x45, 0xcd, 0x30, 0x1a, 0xa3, 0x58,
+    0x97, 0x9f, 0x86, 0xc3, 0x67, 0x18, 0x33, 0xb0, 0xe2, 0x82, 0xb4, 0x03, 0x67, 0x26, 0x48, 0xc8,
+    0x48, 0xc2, 0xd3, 0x8d, 0x35, 0x65, 0x73, 0x09, 0x01, 0x20, 0x8e, 0x6a, 0x29, 0x0c, 0x40, 0x55,
+    0x6b, 0xe6, 0x38, 0x86, 0x82, 0x05, 0x56, 0xc5, 0xdc, 0x51, 0x00, 0x03, 0x82, 0xc7, 0x8d, 0x3d,
+    0x6d, 0x54, 0x66, 0x1e, 0xd6, 0x52, 0x22, 0x88, 0x69, 0xb6, 0x8a, 0x65, 0xdb, 0x95, 0x01, 0x4f,
+    0x36, 0xaa, 0x60, 0xdf, 0xd6, 0xb7, 0x19, 0xf0, 0xcc, 0x15, 0x0c, 0xdf, 0x53, 0xc0, 0x0a, 0x0b,
+    0x5b, 0xc7, 0xd4, 0xf7, 0xf9, 0x5d, 0xc8, 0xec, 0x17, 0x6d, 0x4f, 0xf0, 0x3d, 0x2f, 0x3a, 0xf7,
+    0x25, 0x34, 0xa9, 0xc1, 0x2b, 0xc5, 0x7a, 0xa4, 0x44, 0x47, 0x05, 0x69, 0x4f, 0xf5, 0x98, 0x42,
+    0x48, 0xd7, 0x5b, 0x8c, 0xd1, 0x1c, 0xa8, 0x11, 0xa5, 0x5d, 0x61, 0xbd, 0x26, 0xfc, 0x40, 0xf7,
+    0x58, 0xd0, 0x75, 0xac, 0x6c, 0x70, 0x5c, 0xb3, 0xc1, 0x0f, 0x82, 0xf5, 0x02, 0x51, 0x26, 0x2b,
+    0xef, 0x94, 0x77, 0x0c, 0xfb, 0x83, 0x08, 0xb2, 0xb6, 0x06, 0xb4, 0x86, 0x55, 0x37, 0x66, 0x0a,
+    0xd4, 0x9c, 0xbd, 0xf1, 0xea, 0x31, 0xbb, 0x37, 0xec, 0x69, 0xac, 0xd4, 0x3e, 0x6c, 0x7b, 0xf5,
+    0x21, 0xe7, 0x44, 0x64, 0xb2, 0x7a, 0x5e, 0x70, 0x37, 0x0d, 0x56, 0x76, 0x84, 0xa9, 0xa1, 0xbf,
+    0xc7, 0x79, 0xba, 0x0c, 0xba, 0x4f, 0xb5, 0x6c, 0xee, 0xd5, 0xcb, 0xef, 0x56, 0x7a, 0x45, 0xb0,
+    0x51, 0x17, 0xf6, 0x21, 0x10, 0x17, 0x54, 0x67, 0x7f, 0x05, 0xc1, 0x89, 0xaf, 0xae, 0x09, 0x84,
+    0x88, 0x22, 0xc0, 0x57, 0xfc, 0x81, 0x6c, 0x92, 0x17, 0x30, 0x77, 0xd3, 0xf6, 0x39, 0xcd, 0xf2,
+    0x66, 0x5c, 0x16, 0xf1, 0xfc, 0x8a, 0x70, 0x11, 0xd1, 0xe6, 0xa5, 0x51, 0x25, 0x51, 0xcc, 0xaf,
+    0xb1, 0x6d, 0x64, 0xe0, 0x1a, 0x5d, 0x00, 0xb6, 0xfb, 0xcd, 0x07, 0x7c, 0x3c, 0xb4, 0xb1, 0xd2,
+    0x18, 0x88, 0x98, 0x02, 0xd5, 0xfb, 0x3d, 0x53, 0x79, 0x72, 0x8a, 0x6e, 0x3d, 0x1b, 0xfd, 0x01,
+    0x83, 0x57, 0xa3, 0xce, 0x05, 0xcd, 0xcb, 0x4f, 0x51, 0x4a, 0xdc, 0xbe, 0xc3, 0xe6, 0x98, 0x62,
+    0xf3, 0x6b, 0xaa, 0xe1, 0xef, 0x07, 0xf4, 0xaa, 0x16, 0xd2, 0xab, 0x1b, 0xa8, 0x46, 0x5c, 0x80,
+    0x78, 0x35, 0x77, 0x2e, 0x76, 0x96, 0x06, 0xfb, 0x52, 0x2e, 0xd3, 0xb2, 0xa0, 0x9d, 0xa8, 0x03,
+    0xf0, 0xa4, 0x3c, 0x00, 0x2b, 0x81, 0x6b, 0xbe, 0xc0, 0x13, 0xfd, 0x23, 0x33, 0xde, 0x51, 0x6c,
+    0x43, 0x0d, 0x52, 0x76, 0xed, 0xfd, 0x0e, 0x4b, 0xe8, 0xfc, 0x9a, 0xbf, 0xda, 0xae, 0xe7, 0x50,
+    0xe7, 0x17, 0xae, 0xcb, 0x96, 0xa7, 0x1d, 0xed, 0x8d, 0xc1, 0x13, 0x92, 0x2e, 0xb8, 0x14, 0xec,
+    0x43, 0x26, 0x98, 0x12, 0x51, 0xa8, 0xe2, 0x7c, 0xf6, 0x64, 0xeb, 0x5c, 0xc5, 0x9a, 0x6d, 0xb0,
+    0x42, 0x6e, 0xf6, 0x2b, 0xbb, 0x2c, 0x96, 0x07, 0x18, 0x36, 0xdb, 0xe0, 0x29, 0x09, 0x9f, 0xba,
+    0x6d, 0x52, 0xaf, 0x9e, 0x1a, 0x15, 0xb1, 0xab, 0xa9, 0x58, 0x4c, 0x7a, 0x0d, 0x59, 0x23, 0x8c,
+    0x1b, 0xef, 0x35, 0xa4, 0xfb, 0x86, 0xdc, 0x1f, 0x6a, 0x14, 0x63, 0xc9, 0xfd, 0x7a, 0x68, 0x5b,
+    0xe2, 0x61, 0x3d, 0x6e, 0x2d, 0x71, 0x50, 0xbf, 0x47, 0xb3, 0xc4, 0xa3, 0xfa, 0x25, 0x92, 0x25,
+    0x1e, 0x1b, 0xe2, 0xf1, 0xf0, 0xb8, 0x46, 0xfc, 0x62, 0x88, 0x5f, 0x86, 0x5f, 0x6a, 0xc4, 0x13,
+    0x43, 0x3c, 0x19, 0x9e, 0xd4, 0x88, 0xa7, 0x86, 0x78, 0x3a, 0x3c, 0xdd, 0x12, 0x3b, 0x6d, 0xa3,
+    0x74, 0x7a, 0x8d, 0x2f, 0xee, 0x2a, 0x6a, 0xb7, 0x59, 0x62, 0x2b, 0x7a, 0xaf, 0x79, 0x5c, 0x55,
+    0xf4, 0x7e, 0x13, 0xde, 0x55, 0xf4, 0x43, 0x43, 0xc7, 0xb3, 0xb7, 0x77, 0x58, 0xa7, 0x0f, 0x0c,
+    0x1d, 0x6b, 0x6a, 0xaf, 0x66, 0x89, 0x8e, 0x51, 0xa3, 0xdb, 0xcd, 0x1a, 0xf5, 0xb0, 0x71, 0x80,
+    0x5b, 0xea, 0xa0, 0x51, 0x96, 0x2d, 0xf5, 0xa8, 0x51, 0xc5, 0x2d, 0xf5, 0xb8, 0x71, 0x08, 0x59,
+    0xea, 0x97, 0xc6, 0x21, 0x63, 0xa9, 0x27, 0x8d, 0x83, 0xcc, 0x52, 0x4f, 0x1b, 0x27, 0x4b, 0x49,
+    0xdd, 0xb5, 0xa7, 0x20, 0x84, 0xbd, 0xd2, 0x65, 0xdc, 0x24, 0x7f, 0x1f, 0xa9, 0xf8, 0xfc, 0x1e,
+    0x8c, 0x2a, 0x42, 0x30, 0xda, 0x21, 0x30, 0x75, 0x0d, 0x9a, 0x6b, 0x04, 0x55, 0x23, 0xff, 0x94,
+    0xa9, 0xac, 0x51, 0xa4, 0xe0, 0x2b, 0x82, 0xcd, 0x6e, 0x8e, 0x27, 0x56, 0xa8, 0x3f, 0xbb, 0x7c,
+    0xb7, 0x91, 0xb6, 0xf2, 0x2c, 0xe4, 0x42, 0x80, 0xaf, 0xb4, 0x4a, 0x40, 0xc4, 0x46, 0xcd, 0x33,
+    0xcf, 0x32, 0x8b, 0x98, 0xe8, 0x5b, 0xbc, 0x3d, 0x08, 0xb3, 0x14, 0x3f, 0x27, 0x69, 0x24, 0x40,
+    0x57, 0x68, 0x9f, 0xa9, 0xf1, 0x70, 0x34, 0x88, 0xcc, 0x4b, 0x58, 0x40, 0x41, 0xf3, 0x14, 0xd6,
+    0xe0, 0x3d, 0x40, 0xe6, 0x39, 0x49, 0x73, 0x5f, 0x71, 0x04, 0xfd, 0xa0, 0x3e, 0x3b, 0xf1, 0xdf,
+    0x2d, 0x1e, 0xec, 0x2b, 0x33, 0xc0, 0x6f, 0x82, 0x1c, 0x01, 0x22, 0xf1, 0xdd, 0x2f, 0x76, 0x88,
+    0x28, 0x6f, 0x1e, 0x89, 0x76, 0x96, 0xe3, 0x14, 0xc7, 0x1f, 0x2c, 0x06, 0x7f, 0xfd, 0xd8, 0x41,
+    0x1b, 0xe3, 0xab, 0xc6, 0xa9, 0xa7, 0x82, 0xd7, 0x4a, 0x55, 0x67, 0xff, 0x56, 0xf8, 0x8a, 0x2e,
+    0x84, 0xfa, 0x82, 0x4d, 0x78, 0x2a, 0xbf, 0x92, 0x44, 0x30, 0x73, 0x23, 0xa7, 0x34, 0x9f, 0xbb,
+    0x01, 0x45, 0x29, 0x8c, 0x68, 0x00, 0x77, 0x9a, 0x50, 0x6f, 0xc3, 0xdf, 0xe4, 0x29, 0x51, 0x6f,
+    0x18, 0x93, 0xea, 0x0b, 0xf3, 0xf7, 0x27, 0xb8, 0xc1, 0xb6, 0x9f, 0x55, 0x0d, 0xab, 0x2d, 0x2a,
+    0x86, 0x87, 0x7d, 0xaf, 0xef, 0x3a, 0xc7, 0xaa, 0x7f, 0x40, 0x17, 0x0a, 0x7d, 0xcf, 0x63, 0x3f,
+    0xe9, 0xb4, 0x4c, 0x4a, 0xd6, 0xde, 0x1b, 0x18, 0x53, 0xc1, 0xd7, 0xfa, 0x66, 0x73, 0x5c, 0x5f,
+    0xcb, 0x1d, 0x22, 0x15, 0x0d, 0x5c, 0xdf, 0x43, 0x61, 0x56, 0xf6, 0x05, 0xfd, 0xf7, 0x52, 0x7e,
+    0x08, 0xe2, 0xe1, 0x91, 0x3b, 0x8e, 0x55, 0xc1, 0xcf, 0x5c, 0x77, 0xf2, 0x37, 0xc9, 0xd4, 0xd9,
+    0x1e, 0x79, 0xea, 0x46, 0xf8, 0x28, 0x68, 0xe8, 0x2d, 0x9c, 0x16, 0xe0, 0x2d, 0x8b, 0x10, 0x2b,
+    0x86, 0x8c, 0x79, 0x5b, 0x76, 0x42, 0x99, 0x6d, 0x09, 0x9a, 0x7e, 0x9e, 0x70, 0x06, 0xfa, 0xed,
+    0xc6, 0x6b, 0x5e, 0x9e, 0x2f, 0xf9, 0x6b, 0xdb, 0x41, 0xdf, 0xf2, 0xd4, 0x57, 0xc5, 0x14, 0x97,
+    0xee, 0x5b, 0x7a, 0xa6, 0x3c, 0x8c, 0xb8, 0x28, 0x3f, 0x84, 0xf3, 0x91, 0x57, 0x5f, 0xe0, 0xfa,
+    0x16, 0xd9, 0x07, 0x1a, 0x81, 0xb7, 0xf9, 0x1e, 0xcc, 0xb3, 0xb0, 0x8f, 0x5e, 0xdd, 0x35, 0x83,
+    0xeb, 0xd0, 0x50, 0x9f, 0xa8, 0x2a, 0xcf, 0x31, 0xee, 0xad, 0x4a, 0xc0, 0x0b, 0x59, 0x7f, 0x44,
+    0xbc, 0xd0, 0xf9, 0xd3, 0x9e, 0x9a, 0x66, 0xcf, 0x04, 0x7f, 0xe3, 0x69, 0xdb, 0x79, 0xb3, 0x84,
+    0xaf, 0x5e, 0xbc, 0x77, 0xc7, 0x9f, 0xa9, 0xbf, 0xd9, 0x66, 0x05, 0x5f, 0x26, 0x31, 0x4f, 0x7d,
+    0x4f, 0xe8, 0x00, 0x52, 0x2c, 0x25, 0xfe, 0x51, 0x1d, 0x60, 0x73, 0xc6, 0x7c, 0x97, 0xfe, 0x3d,
+    0xdd, 0x00, 0xe3, 0x6b, 0x9b, 0x06, 0x4d, 0x03, 0x7d, 0x7f, 0x8b, 0x31, 0xd4, 0x78, 0xe8, 0x3d,
+    0xf5, 0x23, 0x84, 0xf2, 0xcd, 0x73, 0xe6, 0x47, 0x50, 0xaf, 0x02, 0xbe, 0x07, 0x90, 0x6a, 0xfc,
+    0xbd, 0xcb, 0xd7, 0x23, 0x4d, 0x19, 0x95, 0xfe, 0x48, 0xe4, 0x91, 0xa7, 0x11, 0x2f, 0x2b, 0xf5,
+    0x4e, 0x1c, 0x3c, 0x01, 0xe2, 0xae, 0x57, 0xcf, 0x79, 0x7f, 0x42, 0x24, 0xc8, 0xc2, 0x5b, 0x78,
+    0x85, 0xb6, 0x7d, 0x8b, 0x37, 0xc4, 0x7b, 0x9d, 0x3f, 0xa5, 0x30, 0xe8, 0xf1, 0x5d, 0xfd, 0xe6,
+    0xe3, 0x31, 0xf5, 0x49, 0x3e, 0x16, 0x7c, 0x86, 0xa9, 0xa5, 0x73, 0xc5, 0xfe, 0x2d, 0x44, 0xc9,
+    0x1d, 0xc5, 0xe5, 0x1f, 0x94, 0x6c, 0x61, 0x6f, 0xc5, 0xc1, 0x5a, 0x54, 0x98, 0xa7, 0xd2, 0x2d,
+    0xfa, 0xb5, 0x4c, 0xbe, 0xac, 0x46, 0xd5, 0x2e, 0x4b, 0x2a, 0xae, 0xfa, 0xb6, 0xa8, 0x3d, 0xd9,
+    0x98, 0x08, 0x2c, 0x41, 0x29, 0x69, 0xbe, 0x6d, 0x95, 0xcc, 0x09, 0xc4, 0xa4, 0x11, 0x7c, 0x15,
+    0x3d, 0x0d, 0x11, 0xf6, 0xe6, 0xee, 0x31, 0x68, 0x89, 0x82, 0xda, 0x87, 0x81, 0xdd, 0x81, 0x1b,
+    0x5e, 0xe8, 0x77, 0xfa, 0x9d, 0x65, 0x3c, 0x10, 0xc9, 0x28, 0x6f, 0x42, 0xd7, 0x29, 0x2c, 0xe9,
+    0xb3, 0xba, 0xad, 0x59, 0x51, 0x68, 0xf6, 0x22, 0x15, 0x47, 0x2e, 0x93, 0xd4, 0xdc, 0xf7, 0xbd,
+    0xff, 0xf0, 0x66, 0x07, 0x9c, 0x73, 0x19, 0x01, 0x65, 0xb5, 0x17, 0x42, 0xdb, 0x0e, 0x59, 0x09,
+    0x34, 0x7e, 0x11, 0x6b, 0x84, 0xae, 0x7a, 0x22, 0xd5, 0xbe, 0xf7, 0xfa, 0xd8, 0xbf, 0xab, 0xc9,
+    0xf1, 0x3f, 0xa5, 0xea, 0x03, 0x45, 0xaa, 0xf4, 0x9b, 0xf6, 0x7e, 0xab, 0xa0, 0xfc, 0x48, 0x65,
+    0xdb, 0x82, 0x59, 0xd6, 0x25, 0xe4, 0x85, 0x7d, 0xf3, 0xc3, 0xe6, 0x50, 0xf7, 0x8d, 0xd5, 0xe7,
+    0x03, 0xfd, 0xea, 0xf3, 0x81, 0x7e, 0x7d, 0xc8, 0x33, 0x14, 0x7f, 0x58, 0xe9, 0xa5, 0x7a, 0x99,
+    0x5e, 0x48, 0xb1, 0x71, 0xdb, 0xe6, 0x2b, 0x24, 0xc0, 0x9f, 0xf9, 0x1f, 0x98, 0xf4, 0x85, 0x36,
+    0xdb, 0xbe, 0x8a, 0x23, 0x19, 0x3c, 0x9b, 0xbf, 0xff, 0x72, 0x70, 0xaf, 0x20, 0x85, 0x15, 0x54,
+    0x7f, 0x24, 0x61, 0x3a, 0xdc, 0x2d, 0x33, 0x5b, 0x50, 0xbb, 0x3f, 0xd3, 0xbd, 0x56, 0x2c, 0x09,
+    0x21, 0xa4, 0x58, 0x52, 0xca, 0x9b, 0xe6, 0xd6, 0x66, 0x50, 0x40, 0xd7, 0xdc, 0xd8, 0x5e, 0x6e,
+    0x58, 0xc6, 0x35, 0x67, 0x3c, 0x35, 0xcd, 0x94, 0xfe, 0x9b, 0x99, 0x1a, 0x0b, 0xc1, 0x17, 0x06,
+    0x5a, 0x06, 0x76, 0xb1, 0xb6, 0x23, 0xad, 0xf8, 0x3c, 0x17, 0xf0, 0x07, 0xe3, 0x8d, 0x5f, 0xe1,
+    0x05, 0x52, 0x62, 0xaf, 0x91, 0x77, 0xf7, 0x39, 0x81, 0x17, 0x29, 0xf8, 0x9f, 0x78, 0xe2, 0x97,
+    0x24, 0xb9, 0xfd, 0x34, 0xe6, 0x14, 0x73, 0xad, 0xbc, 0x02, 0xaa, 0x24, 0x68, 0xf8, 0xaa, 0x3f,
+    0x18, 0x98, 0xe1, 0x8a, 0xeb, 0xb3, 0xde, 0x63, 0x6e, 0x48, 0xb7, 0xd6, 0x7b, 0x2a, 0x49, 0xe3,
+    0xde, 0xa2, 0x62, 0x70, 0xf1, 0xcc, 0xd3, 0xfa, 0x5d, 0xb3, 0x1e, 0xed, 0xba, 0x51, 0xd9, 0x0e,
+    0x91, 0x19, 0x01, 0xf7, 0xc6, 0xa7, 0xe8, 0xbd, 0xf9, 0xd4, 0x7c, 0xc5, 0xb2, 0xbb, 0xbc, 0x29,
+    0x7a, 0x57, 0x36, 0x9a, 0xe5, 0x8a, 0x43, 0x8b, 0x25, 0x50, 0xc1, 0xea, 0xd7, 0x15, 0x15, 0x8f,
+    0xc7, 0x6c, 0x55, 0x3e, 0x39, 0xb6, 0xa7, 0x53, 0x5f, 0x29, 0x4d, 0xcc, 0x67, 0x2c, 0xee, 0xa4,
+    0x78, 0x00, 0xc1, 0x0b, 0xce, 0xcc, 0x9b, 0x50, 0x75, 0x99, 0x63, 0xb9, 0x33, 0xa0, 0x2b, 0x73,
+    0x10, 0xb5, 0x22, 0x23, 0x80, 0x98, 0x1a, 0xd7, 0xb7, 0x46, 0x05, 0x08, 0x2c, 0x5e, 0xc1, 0x6d,
+    0xe8, 0x40, 0xcd, 0x55, 0xc0, 0x4a, 0xba, 0x33, 0xe3, 0x09, 0x12, 0xe2, 0x1e, 0xf8, 0xa4, 0xce,
+    0xfa, 0xbc, 0xce, 0xfb, 0xdf, 0xff, 0x01, 0xce, 0x26, 0xd9, 0x27, 0x27, 0x3b, 0x00, 0x00,
+};
+
+#endif // ZONES_DATA_H
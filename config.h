@@ -25,12 +25,38 @@
 #define SERIAL_BAUD_RATE 115200
 #define WEBSERVER_PORT 80
 #define DNS_PORT 53
+#define DNS_TASK_STACK_SIZE 3072
+#define DNS_TASK_PRIORITY 2
+#define DNS_POLL_INTERVAL 5 // ms
+#define NET_TASK_STACK_SIZE 4096
+#define NET_TASK_PRIORITY 2
+#define SNTP_TASK_STACK_SIZE 4096
+#define SNTP_TASK_PRIORITY 2
+#define LOG_TASK_STACK_SIZE 3072
+#define LOG_TASK_PRIORITY 1
+// Static stacks, SystemMonitor reports how much of them is used
+#define CLOCK_TASK_STACK_SIZE 4096
+#define CLOCK_TASK_PRIORITY 5 // the pthread default it had before
+#define PREFS_TASK_STACK_SIZE 3072
+#define PREFS_TASK_PRIORITY 1
+#define LOOP_TASK_STACK_SIZE 8192 // web server, Arduino's default
+#define LOG_TO_SERIAL DEBUG // at boot, can be switched at /api/log
+// Reuse the last DHCP lease at boot, reserve the address in the router
+#define WIFI_CACHE_STATIC_IP 0
+#define WIFI_CACHE_LEASE_TIME (12 * 60 * 60) // s, then DHCP is asked again
+#define WIFI_CACHE_DHCP_BOOTS 8 // boots on a reused lease before DHCP again
 #define DEFAULT_NTP_SERVER "pool.ntp.org"
 #define DEFAULT_TIMEZONE_LOCATION "Etc/GMT"
 #define DEFAULT_TIMEZONE "GMT0"
 #define DEFAULT_AP_NAME_PREFIX "HOLLOW5P-"
 #define DEFAULT_LOCALHOST_NAME "Hollow5Plus"
+#define DEFAULT_SERVER_IP "192.168.100.1"
+#define DEFAULT_SERVER_GW "192.168.100.1"
+#define DEFAULT_SERVER_MASK "255.255.255.0"
 #define DEFAULT_NTP_UPDATE (60 * 60 * 12)
+#define MAX_NTP_UPDATE (60 * 60 * 36) // s, the clock drifts too far beyond
+#define MIN_TIMEZONE_OFFSET (-14 * 60) // minutes west, UTC+14 to UTC-12
+#define MAX_TIMEZONE_OFFSET (12 * 60)
 
 #ifndef STRING_VERSION
 #define STRING_VERSION "1.0.5-dirty"
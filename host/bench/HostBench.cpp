@@ -0,0 +1,386 @@
+// Measures the clock modules on the host, see the README. Exits with 1 if
+// a result is off, so broken code is not measured.
+#include "HollowClock.h"
+#include "HostShim.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "Logger.h"
+#include "MotorControl.h"
+#include "PreferencesManager.h"
+#include "TimeZone.h"
+#include "Zones.h"
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+
+#define BENCH_CLOCK_TIMEOUT 20000 // ms, real time for the hands to arrive
+#define BENCH_CLOCK_OFFSET 60     // minutes the hands start behind
+
+typedef std::chrono::steady_clock bench_clock_t;
+
+static int failures = 0;
+static std::atomic<size_t> allocations(0);
+
+// Counts every allocation of the process, the benchmarks take differences
+void *operator new(size_t size) {
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+static double elapsedNs(bench_clock_t::time_point start) {
+  return std::chrono::duration<double, std::nano>(bench_clock_t::now() - start)
+      .count();
+}
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("  FAILED: %s\n", what);
+    failures++;
+  }
+}
+
+static void countFlush(void *context, const char *, size_t len) {
+  *(size_t *)context += len;
+}
+
+static void benchZones(void) {
+  std::vector<const char *> names;
+  zones_ForEach("", [&names](const zone_entry_t &entry) {
+    names.push_back(entry.name);
+    return true;
+  });
+  printf("zones: %zu\n", names.size());
+
+  const int rounds = 200;
+  size_t found = 0;
+  auto start = bench_clock_t::now();
+  for (int i = 0; i < rounds; i++) {
+    for (const char *name : names) {
+      zone_entry_t entry;
+      found += zones_FindByName(name, entry);
+    }
+  }
+  double ns = elapsedNs(start);
+  check(found == names.size() * rounds, "every zone found by its name");
+  printf("  find by name: %.1f ns\n", ns / (names.size() * rounds));
+
+  start = bench_clock_t::now();
+  for (int i = 0; i < rounds; i++) {
+    zones_ForEach("Europe/", [](const zone_entry_t &) { return true; });
+  }
+  printf("  prefix Europe/: %.1f ns\n", elapsedNs(start) / rounds);
+}
+
+static void benchTimeZone(void) {
+  static const char *rule = "CET-1CEST,M3.5.0,M10.5.0/3";
+  const int count = 2000000;
+  const time_t base = 1767225600; // 2026-01-01, a DST change in the range
+  TimeZone &tz = TimeZone::getInstance();
+  tz.setRule(rule);
+  setenv("TZ", rule, 1);
+  tzset();
+
+  printf("timezone: %s\n", rule);
+  int mismatches = 0;
+  auto start = bench_clock_t::now();
+  for (int i = 0; i < count; i++) {
+    struct tm local;
+    tz.localTime(base + i * 60, local);
+    mismatches += local.tm_min != (i % 60);
+  }
+  printf("  TimeZone::localTime: %.1f ns\n", elapsedNs(start) / count);
+  check(mismatches == 0, "local minutes follow UTC");
+
+  start = bench_clock_t::now();
+  for (int i = 0; i < count; i++) {
+    struct tm libc, local;
+    time_t t = base + i * 60;
+    localtime_r(&t, &libc);
+    if (i % 997 == 0) {
+      tz.localTime(t, local);
+      mismatches += local.tm_hour != libc.tm_hour;
+    }
+  }
+  printf("  localtime_r: %.1f ns\n", elapsedNs(start) / count);
+  check(mismatches == 0, "TimeZone agrees with libc");
+}
+
+// The advanced page as the handlers built it before JsonWriter
+static String advancedString(const pref_settings_t &settings) {
+  String data = R"(
+    {
+    "host_name": ")" +
+                settings.hostname + R"(",
+    "host_ip": ")" +
+                settings.server_ip + R"(",
+    "flip_rotation": )" +
+                (settings.flip_rotation ? "true" : "false") + R"(,
+    "allow_backward": )" +
+                (settings.allow_backward ? "true" : "false") + R"(,
+    "chime": )" +
+                (settings.chime ? "true" : "false") + R"(,
+    "jump_policy": )" +
+                String(settings.jump_policy) + R"(,
+    "steps_per_minute": )" +
+                String(settings.steps_per_minute) + R"(,
+    "delay_time": )" +
+                String(settings.delay_time) + R"(
+    }
+    )";
+  return data;
+}
+
+static void advancedJson(JsonWriter &json, const pref_settings_t &settings) {
+  json.beginObject();
+  json.add("host_name", settings.hostname);
+  json.add("host_ip", settings.server_ip);
+  json.add("flip_rotation", settings.flip_rotation);
+  json.add("allow_backward", settings.allow_backward);
+  json.add("chime", settings.chime);
+  json.add("jump_policy", (unsigned int)settings.jump_policy);
+  json.add("steps_per_minute", settings.steps_per_minute);
+  json.add("delay_time", (unsigned int)settings.delay_time);
+  json.endObject();
+}
+
+static void benchJson(void) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  pref_settings_t settings;
+  pm.getSettings(settings);
+
+  // The web server streams in chunks of this size
+  char buffer[256];
+  size_t flushed = 0;
+  const int count = 100000;
+  auto start = bench_clock_t::now();
+  for (int i = 0; i < count; i++) {
+    JsonWriter json(buffer, sizeof(buffer), countFlush, &flushed);
+    json.beginObject();
+    PreferencesManager::writeJson(json, settings);
+    json.endObject();
+    json.flush();
+  }
+  double ns = elapsedNs(start);
+  size_t size = flushed / count;
+  printf("json: config of %zu bytes\n", size);
+  printf("  JsonWriter: %.1f ns, %.1f MB/s\n", ns / count,
+         flushed * 1000.0 / ns);
+
+  std::vector<char> document(size + 1);
+  JsonWriter json(document.data(), document.size());
+  json.beginObject();
+  PreferencesManager::writeJson(json, settings);
+  json.endObject();
+  check(!json.overflow() && json.length() == size, "config fits");
+
+  int fields = 0;
+  start = bench_clock_t::now();
+  for (int i = 0; i < count; i++) {
+    JsonReader reader(json.data(), json.length());
+    pref_settings_t parsed = settings;
+    String key, value;
+    json_type_t type;
+    while (reader.next(key, type, value)) {
+      int field = PreferencesManager::findField(key);
+      fields += field >= 0 &&
+                PreferencesManager::parseField(field, type, value, parsed);
+    }
+  }
+  ns = elapsedNs(start);
+  printf("  JsonReader + parseField: %.1f ns\n", ns / count);
+  check(fields == PREF_FIELDS_COUNT * count, "every field parsed back");
+
+  printf("json: advanced page\n");
+  size_t length = 0;
+  size_t allocated = allocations;
+  start = bench_clock_t::now();
+  for (int i = 0; i < count; i++) {
+    String data = advancedString(settings);
+    length += data.length();
+  }
+  ns = elapsedNs(start);
+  printf("  String concatenation: %.1f ns, %.1f allocations\n", ns / count,
+         (double)(allocations - allocated) / count);
+
+  flushed = 0;
+  allocated = allocations;
+  start = bench_clock_t::now();
+  for (int i = 0; i < count; i++) {
+    JsonWriter page(buffer, sizeof(buffer), countFlush, &flushed);
+    advancedJson(page, settings);
+    page.flush();
+  }
+  ns = elapsedNs(start);
+  printf("  JsonWriter: %.1f ns, %.1f allocations, %zu bytes instead of %zu\n",
+         ns / count, (double)(allocations - allocated) / count,
+         flushed / count, length / count);
+  check(allocations == allocated, "JsonWriter does not allocate");
+}
+
+// A user saving the settings pages a few times, then a restart
+static void benchPreferences(void) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  pref_settings_t settings;
+  host_nvs_stats_t stats;
+  const char *error;
+
+  pm.commit();
+  host_ResetNvsStats();
+  uint32_t writes = pm.getNvsWrites();
+  uint32_t commits = pm.getNvsCommits();
+
+  pm.getSettings(settings);
+  settings.chime = !settings.chime;
+  check(pm.applySettings(settings, error) == PREF_OK, "time page saved");
+  settings.delay_time = (settings.delay_time == 2) ? 3 : 2;
+  check(pm.applySettings(settings, error) == PREF_OK, "advanced page saved");
+  // Different from the last run with the same file
+  settings.hostname =
+      (settings.hostname == "HostBench") ? "HostBench2" : "HostBench";
+  check(pm.applySettings(settings, error) == PREF_OK, "advanced page saved");
+  check(pm.applySettings(settings, error) == PREF_OK, "same page saved");
+  pm.commit();
+
+  host_GetNvsStats(stats);
+  printf("preferences: session of 4 saves changing 3 values\n");
+  printf("  manager: %u writes, %u commits\n", pm.getNvsWrites() - writes,
+         pm.getNvsCommits() - commits);
+  printf("  nvs: %u sets, %u changed, %u commits\n", stats.sets, stats.writes,
+         stats.commits);
+  check(stats.writes == 3, "only the changed values reach the flash");
+}
+
+// A record costs the caller less than formatting it
+static void benchLogger(void) {
+  Logger &logger = Logger::getInstance();
+  const int count = 1000000;
+  char line[LOG_LINE_MAX];
+  logger.setLevel(LOG_MAIN, LOG_LEVEL_DEBUG);
+
+  printf("logger: %d records\n", count);
+  auto start = bench_clock_t::now();
+  for (int i = 0; i < count; i++) {
+    LOG_DEBUG(LOG_MAIN, "Moved %d steps in %lu ms to %s\n", i,
+              (unsigned long)i / 7, "10:35");
+  }
+  printf("  LOG_DEBUG: %.1f ns\n", elapsedNs(start) / count);
+
+  start = bench_clock_t::now();
+  for (int i = 0; i < count; i++) {
+    snprintf(line, sizeof(line), "Moved %d steps in %lu ms to %s\n", i,
+             (unsigned long)i / 7, "10:35");
+  }
+  printf("  snprintf: %.1f ns\n", elapsedNs(start) / count);
+
+  logger.setLevel(LOG_MAIN, LOG_LEVEL_ERROR);
+  start = bench_clock_t::now();
+  for (int i = 0; i < count; i++) {
+    LOG_DEBUG(LOG_MAIN, "Moved %d steps\n", i);
+  }
+  printf("  LOG_DEBUG disabled: %.1f ns\n", elapsedNs(start) / count);
+
+  uint32_t cursor = logger.getOldest();
+  uint32_t lost = 0;
+  log_record_t record;
+  size_t records = 0;
+  bool matches = true;
+  while (logger.read(cursor, record, lost)) {
+    Logger::format(record, line, sizeof(line));
+    matches &= strstr(line, " main D Moved ") != nullptr &&
+               strstr(line, " ms to 10:35") != nullptr;
+    records++;
+  }
+  check(records == LOG_RECORDS && matches, "the ring keeps the last records");
+}
+
+static void benchMotor(void) {
+  MotorControl &motor = MotorControl::getInstance();
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  int steps = pm.getStepsPerMinute();
+  int delay_time = pm.getDelayTime();
+
+  printf("motor: one minute of %d steps\n", steps);
+  uint32_t gpio = host_GetGpioWrites();
+  int64_t skipped = host_GetSkippedTime();
+  auto start = bench_clock_t::now();
+  motor.rotate(steps, delay_time, false);
+  double ns = elapsedNs(start);
+  skipped = host_GetSkippedTime() - skipped;
+  gpio = host_GetGpioWrites() - gpio;
+  uint32_t predicted = motor.getRotateTime(steps, delay_time);
+  printf("  device time %lld ms, predicted %u ms\n", (long long)skipped / 1000,
+         predicted);
+  printf("  %u GPIO writes, host %.1f ns per step\n", gpio, ns / steps);
+  check(skipped == predicted * 1000LL, "getRotateTime() matches rotate()");
+  check(gpio == 4 * (uint32_t)steps + 4, "four coils per step and power cut");
+}
+
+// Hands a bit behind the time, the clock thread has to move them there
+static void benchClock(void) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  uint32_t steps_per_minute = pm.getStepsPerMinute();
+  uint32_t dial = 12 * 60 * steps_per_minute;
+  struct tm local;
+  TimeZone::getInstance().setRule("UTC0");
+  TimeZone::getInstance().localTime(time(nullptr), local);
+  uint32_t now = ((local.tm_hour % 12) * 60 + local.tm_min) * steps_per_minute;
+  pm.setClock((now + dial - BENCH_CLOCK_OFFSET * steps_per_minute) % dial);
+
+  HollowClock &hclock = HollowClock::getInstance();
+  MotorControl &motor = MotorControl::getInstance();
+  uint32_t moved = motor.getStepsMoved();
+  int64_t skipped = host_GetSkippedTime();
+  printf("clock: hands %d minutes behind\n", BENCH_CLOCK_OFFSET);
+  auto start = bench_clock_t::now();
+  hclock.start();
+
+  // Arrived once the hands stay within a minute of the time
+  bool arrived = false;
+  while (!arrived && elapsedNs(start) < BENCH_CLOCK_TIMEOUT * 1e6) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    uint8_t hours, minutes;
+    TimeZone::getInstance().localTime(time(nullptr), local);
+    int diff = (hclock.getClockPosition(hours, minutes) == HCLOCK_OK)
+                   ? ((local.tm_hour % 12) * 60 + local.tm_min -
+                      (hours * 60 + minutes) + 720) %
+                         720
+                   : -1;
+    arrived = !hclock.isPositioning() && (diff <= 1 || diff == 719);
+  }
+  double ns = elapsedNs(start);
+  hclock_stats_t stats;
+  hclock.getStats(stats);
+  printf("  %u steps, %u positioning runs, device time %lld s, host %.1f ms\n",
+         motor.getStepsMoved() - moved, stats.positioning_events,
+         (long long)(host_GetSkippedTime() - skipped) / 1000000, ns / 1e6);
+  check(arrived, "hands reached the time");
+}
+
+int main(int argc, char **argv) {
+  // A file keeps the settings between runs like the flash does
+  if (argc > 1) {
+    host_SetNvsFile(argv[1]);
+  }
+  benchZones();
+  benchTimeZone();
+  benchJson();
+  benchPreferences();
+  benchLogger();
+  benchMotor();
+  benchClock();
+  PreferencesManager::getInstance().commit();
+  printf(failures ? "%d checks failed\n" : "all checks passed\n", failures);
+  fflush(stdout);
+  // The clock thread never ends
+  _exit(failures ? 1 : 0);
+}
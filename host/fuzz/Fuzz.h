@@ -0,0 +1,18 @@
+#ifndef _HOST_FUZZ_H_
+#define _HOST_FUZZ_H_
+
+#include <Arduino.h>
+
+// Entry point of a fuzz target, libFuzzer's or FuzzMain.cpp's
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+// A wrong result ends the run like a crash, so the fuzzer keeps the input
+#define FUZZ_CHECK(ok)                                                         \
+  do {                                                                         \
+    if (!(ok)) {                                                               \
+      fprintf(stderr, "FAILED: %s (%s:%d)\n", #ok, __FILE__, __LINE__);        \
+      abort();                                                                 \
+    }                                                                          \
+  } while (0)
+
+#endif
@@ -0,0 +1,89 @@
+// The input is a number argument of a form and the limits it is checked
+// against, then the command the clock thread would get for it:
+//   int32 min, int32 max, uint8 cmd, uint8 val1, uint8 val2, argument text
+#include "ClockWebServer.h"
+#include "Fuzz.h"
+#include "HollowClock.h"
+#include <errno.h>
+
+// The argument goes through the URL decoding of a form like on the device
+static bool numberArg(const String &text, int32_t min, int32_t max,
+                      int32_t &value) {
+  static WebServer *server = nullptr;
+  static const String *expected;
+  static int32_t low, high, result;
+  static bool ok;
+  host_request_t request;
+  host_response_t response;
+
+  if (server == nullptr) {
+    ClockWebServer::getInstance().start();
+    server = host_GetWebServer();
+    server->on("/fuzz", HTTP_POST, []() {
+      FUZZ_CHECK(server->arg("value") == *expected);
+      ok = ClockWebServer::parseNumber(server->arg("value"), low, high,
+                                       result);
+    });
+  }
+  request.method = HTTP_POST;
+  request.uri = "/fuzz";
+  request.query = "value=";
+  for (unsigned char c : text) {
+    char escaped[4];
+    snprintf(escaped, sizeof(escaped), "%%%02X", c);
+    request.query += escaped;
+  }
+  expected = &text;
+  low = min;
+  high = max;
+  ok = false;
+  host_Request(*server, request, response);
+  value = result;
+  return ok;
+}
+
+static void checkCommand(uint8_t cmd, int32_t value) {
+  uint32_t command = HollowClock::makeCommand(cmd, value);
+  int par;
+  HollowClock::getParams(command, par);
+  FUZZ_CHECK(HollowClock::getCommand(command) == cmd);
+  if (value >= -CMD_VALUE_MAX && value <= CMD_VALUE_MAX) {
+    FUZZ_CHECK(par == value);
+  } else {
+    // Saturated, the sign is kept
+    FUZZ_CHECK(par == (value < 0 ? -CMD_VALUE_MAX : CMD_VALUE_MAX));
+  }
+}
+
+static void checkCommand(uint8_t cmd, uint8_t val1, uint8_t val2) {
+  uint32_t command = HollowClock::makeCommand(cmd, val1, val2);
+  uint8_t par1, par2;
+  HollowClock::getParams(command, par1, par2);
+  FUZZ_CHECK(HollowClock::getCommand(command) == cmd);
+  FUZZ_CHECK(par1 == val1 && par2 == val2);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  int32_t min, max, value;
+  if (size < 11) {
+    return 0;
+  }
+  memcpy(&min, data, sizeof(min));
+  memcpy(&max, data + 4, sizeof(max));
+  String text(std::string((const char *)data + 11, size - 11));
+
+  bool ok = numberArg(text, min, max, value);
+  if (ok) {
+    // The whole text is the number, no spaces, signs only in front
+    char *end;
+    errno = 0;
+    long long parsed = strtoll(text.c_str(), &end, 10);
+    FUZZ_CHECK(!text.isEmpty() && !isspace((unsigned char)text[0]));
+    FUZZ_CHECK(errno == 0 && *end == '\0' && parsed == value);
+    FUZZ_CHECK(end == text.c_str() + text.length());
+    FUZZ_CHECK(value >= min && value <= max);
+  }
+  checkCommand(data[8], ok ? value : min);
+  checkCommand(data[8], data[9], data[10]);
+  return 0;
+}
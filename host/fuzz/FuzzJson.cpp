@@ -0,0 +1,70 @@
+// The input is a body of PUT /api/config. The members read are set as
+// settings, and the string members written back with JsonWriter have to
+// read the same.
+#include "Fuzz.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "PreferencesManager.h"
+#include <vector>
+
+static void append(void *context, const char *data, size_t len) {
+  ((String *)context)->append(data, len);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  JsonReader reader((const char *)data, size);
+  std::vector<std::pair<String, String>> strings;
+  pref_settings_t settings;
+  String key, value;
+  json_type_t type;
+
+  PreferencesManager::getInstance().getSettings(settings);
+  while (reader.next(key, type, value)) {
+    FUZZ_CHECK(reader.getPosition() <= size);
+    int field = PreferencesManager::findField(key);
+    if (field >= 0) {
+      PreferencesManager::parseField(field, type, value, settings);
+    }
+    int32_t number;
+    uint32_t unsigned_number;
+    bool flag;
+    if (JsonReader::toInt(type, value, number)) {
+      FUZZ_CHECK(type == JSON_NUMBER && strtoll(value.c_str(), nullptr, 10) ==
+                                            number);
+    }
+    if (JsonReader::toUInt(type, value, unsigned_number)) {
+      FUZZ_CHECK(type == JSON_NUMBER && value[0] != '-');
+    }
+    if (JsonReader::toBool(type, value, flag)) {
+      FUZZ_CHECK(type == JSON_BOOL);
+    }
+    // Keys go out as C strings
+    if (type == JSON_STRING && strlen(key.c_str()) == key.length()) {
+      strings.push_back(std::make_pair(key, value));
+    }
+  }
+  FUZZ_CHECK(reader.failed() == (reader.getError() != nullptr));
+  if (reader.failed()) {
+    return 0;
+  }
+
+  char buffer[64];
+  String written;
+  JsonWriter json(buffer, sizeof(buffer), append, &written);
+  json.beginObject();
+  for (const std::pair<String, String> &member : strings) {
+    json.add(member.first.c_str(), member.second);
+  }
+  json.endObject();
+  json.flush();
+  FUZZ_CHECK(!json.overflow());
+
+  JsonReader again(written.c_str(), written.length());
+  for (const std::pair<String, String> &member : strings) {
+    FUZZ_CHECK(again.next(key, type, value));
+    FUZZ_CHECK(type == JSON_STRING && key == member.first &&
+               value == member.second);
+  }
+  FUZZ_CHECK(!again.next(key, type, value) && !again.failed());
+  return 0;
+}
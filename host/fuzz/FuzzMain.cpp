@@ -0,0 +1,74 @@
+// Runs a fuzz target over inputs when the compiler has no libFuzzer: each
+// argument is a file or a directory of them, libFuzzer's options (-runs=0)
+// are ignored. A failed check or a sanitizer error ends the run.
+#include "Fuzz.h"
+#include <algorithm>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static int runs = 0;
+
+static bool runFile(const std::string &path) {
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    fprintf(stderr, "Cannot read %s\n", path.c_str());
+    return false;
+  }
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t len;
+  while ((len = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + len);
+  }
+  fclose(file);
+  // A copy of exactly the input size, ASan sees reads past the end
+  uint8_t *input = new uint8_t[data.size()];
+  std::copy(data.begin(), data.end(), input);
+  LLVMFuzzerTestOneInput(input, data.size());
+  delete[] input;
+  runs++;
+  return true;
+}
+
+static bool runPath(const std::string &path) {
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0) {
+    fprintf(stderr, "Cannot find %s\n", path.c_str());
+    return false;
+  }
+  if (!S_ISDIR(info.st_mode)) {
+    return runFile(path);
+  }
+  DIR *dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    return false;
+  }
+  std::vector<std::string> names;
+  while (struct dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      names.push_back(entry->d_name);
+    }
+  }
+  closedir(dir);
+  std::sort(names.begin(), names.end());
+  bool ok = true;
+  for (const std::string &name : names) {
+    ok = runPath(path + "/" + name) && ok;
+  }
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  bool ok = true;
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-') {
+      ok = runPath(argv[i]) && ok;
+    }
+  }
+  printf("%d inputs run\n", runs);
+  fflush(stdout);
+  // Tasks started by the modules never end
+  _exit(ok && runs > 0 ? 0 : 1);
+}
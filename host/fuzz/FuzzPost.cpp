@@ -0,0 +1,73 @@
+// The input is a request to one of the routes that change something: the
+// first byte picks the route, the rest is its form query, the JSON body of
+// /api/config, or the query, a newline and the file of /update. Every
+// request has to be answered, and the settings stay valid whatever it
+// changed.
+#include "ClockWebServer.h"
+#include "Fuzz.h"
+#include <WiFi.h>
+
+typedef enum { BODY_FORM, BODY_JSON, BODY_UPLOAD } body_t;
+
+static const struct {
+  HTTPMethod method;
+  const char *uri;
+  body_t body;
+} routes[] = {
+    {HTTP_POST, "/wifi", BODY_FORM},
+    {HTTP_POST, "/time", BODY_FORM},
+    {HTTP_POST, "/advanced", BODY_FORM},
+    {HTTP_POST, "/calibration", BODY_FORM},
+    {HTTP_POST, "/apply", BODY_FORM},
+    {HTTP_POST, "/reset", BODY_FORM},
+    {HTTP_PUT, "/api/config", BODY_JSON},
+    {HTTP_PATCH, "/api/config", BODY_JSON},
+    {HTTP_POST, "/update", BODY_UPLOAD},
+    {HTTP_POST, "/api/log", BODY_FORM},
+};
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  static pref_settings_t initial;
+  static bool started = false;
+  pref_settings_t settings;
+  const char *error;
+  host_request_t request;
+  host_response_t response;
+
+  // Each input starts from the same settings
+  if (!started) {
+    pm.getSettings(initial);
+    started = true;
+  }
+  FUZZ_CHECK(pm.applySettings(initial, error) == PREF_OK);
+  if (size < 1) {
+    return 0;
+  }
+  const size_t count = sizeof(routes) / sizeof(routes[0]);
+  String payload(std::string((const char *)data + 1, size - 1));
+  request.method = routes[data[0] % count].method;
+  request.uri = routes[data[0] % count].uri;
+  request.local_ip = WiFi.localIP();
+  switch (routes[data[0] % count].body) {
+  case BODY_FORM:
+    request.query = payload;
+    break;
+  case BODY_JSON:
+    request.body = payload;
+    break;
+  case BODY_UPLOAD: {
+    int split = payload.indexOf('\n');
+    request.query = payload.substring(0, split < 0 ? payload.length() : split);
+    request.upload = split < 0 ? String() : payload.substring(split + 1);
+    break;
+  }
+  }
+
+  ClockWebServer::getInstance().start();
+  host_Request(*host_GetWebServer(), request, response);
+  FUZZ_CHECK(response.code >= 200 && response.code < 600);
+  pm.getSettings(settings);
+  FUZZ_CHECK(pm.validateSettings(settings, error) == PREF_OK);
+  return 0;
+}
@@ -0,0 +1,35 @@
+// The input is a hands position, the time and the dial size:
+//   uint8 allow_backward, uint16 steps_per_minute, uint32 hands, uint32 time
+// The steps and the direction have to bring the hands to the time, the
+// short way round when they may go backward.
+#include "Fuzz.h"
+#include "HollowClock.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  uint16_t steps_per_minute;
+  uint32_t hands, time;
+  bool forward;
+  if (size < 11) {
+    return 0;
+  }
+  bool allow_backward = data[0] & 1;
+  memcpy(&steps_per_minute, data + 1, sizeof(steps_per_minute));
+  memcpy(&hands, data + 3, sizeof(hands));
+  memcpy(&time, data + 7, sizeof(time));
+  // The settings allow 1 to STEPS_PER_MINUTE_MAX
+  steps_per_minute = steps_per_minute % STEPS_PER_MINUTE_MAX + 1;
+  int dial = 12 * 60 * steps_per_minute;
+  hands %= dial;
+  time %= dial;
+
+  int diff = HollowClock::calculateTimeDiff(hands, time, dial, allow_backward,
+                                            forward);
+  FUZZ_CHECK(diff >= 0 && diff < dial);
+  FUZZ_CHECK(forward || allow_backward);
+  int moved = forward ? (int)hands + diff : (int)hands - diff + dial;
+  FUZZ_CHECK(moved % dial == (int)time);
+  if (allow_backward) {
+    FUZZ_CHECK(diff <= dial / 2);
+  }
+  return 0;
+}
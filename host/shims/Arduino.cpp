@@ -0,0 +1,302 @@
+#include "ESPmDNS.h"
+#include "HostShim.h"
+#include "WiFi.h"
+#include "esp_sntp.h"
+#include "esp_system.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+MDNSResponder MDNS;
+
+static const std::chrono::steady_clock::time_point host_start =
+    std::chrono::steady_clock::now();
+static std::atomic<int64_t> skipped_us{0};
+static std::atomic<uint32_t> restarts{0};
+static std::atomic<uint32_t> heap_free{200000};
+static std::atomic<uint32_t> heap_min_free{150000};
+static std::atomic<uint32_t> heap_largest{100000};
+
+static std::mutex gpio_mutex;
+static uint8_t gpio_levels[HOST_GPIO_PINS];
+static std::atomic<uint32_t> gpio_writes{0};
+static std::vector<host_gpio_event_t> gpio_events;
+static size_t gpio_events_max = 0;
+
+typedef struct {
+  std::mutex mutex;
+  std::condition_variable condition;
+  uint32_t value;
+  uint32_t count; // xTaskNotifyGive() calls not taken yet
+  bool notified;
+} host_task_t;
+
+static thread_local host_task_t *current_task = nullptr;
+
+String::String(unsigned long value, unsigned char base) {
+  char buffer[8 * sizeof(value) + 1];
+  char *p = buffer + sizeof(buffer) - 1;
+  *p = '\0';
+  do {
+    *--p = "0123456789abcdef"[value % base];
+    value /= base;
+  } while (value != 0);
+  assign(p);
+}
+
+bool IPAddress::fromString(const char *s) {
+  unsigned int a, b, c, d;
+  char rest;
+  if (sscanf(s, "%u.%u.%u.%u%c", &a, &b, &c, &d, &rest) != 4 || a > 255 ||
+      b > 255 || c > 255 || d > 255) {
+    return false;
+  }
+  address = a | b << 8 | c << 16 | d << 24;
+  return true;
+}
+
+String IPAddress::toString(void) const {
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", address & 0xFF,
+           (address >> 8) & 0xFF, (address >> 16) & 0xFF, address >> 24);
+  return buffer;
+}
+
+void EspClass::restart(void) { restarts++; }
+
+uint32_t host_GetRestarts(void) { return restarts; }
+
+uint32_t EspClass::getFreeHeap(void) { return heap_free; }
+
+uint32_t EspClass::getMinFreeHeap(void) { return heap_min_free; }
+
+uint32_t EspClass::getMaxAllocHeap(void) { return heap_largest; }
+
+void host_SetHeap(uint32_t free, uint32_t largest) {
+  heap_free = free;
+  heap_largest = largest;
+  if (free < heap_min_free) {
+    heap_min_free = free;
+  }
+}
+
+int64_t esp_timer_get_time(void) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - host_start)
+             .count() +
+         skipped_us;
+}
+
+unsigned long millis(void) { return esp_timer_get_time() / 1000; }
+
+unsigned long micros(void) { return esp_timer_get_time(); }
+
+void delay(uint32_t ms) {
+  skipped_us += ms * 1000LL;
+  std::this_thread::yield();
+}
+
+void delayMicroseconds(uint32_t us) { skipped_us += us; }
+
+void yield(void) { std::this_thread::yield(); }
+
+int64_t host_GetSkippedTime(void) { return skipped_us; }
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin >= HOST_GPIO_PINS) {
+    return;
+  }
+  gpio_writes++;
+  std::lock_guard<std::mutex> lock(gpio_mutex);
+  gpio_levels[pin] = value;
+  if (gpio_events.size() < gpio_events_max) {
+    gpio_events.push_back({esp_timer_get_time(), pin, value});
+  }
+}
+
+int digitalRead(uint8_t pin) { return host_GetGpioLevel(pin); }
+
+uint32_t host_GetGpioWrites(void) { return gpio_writes; }
+
+int host_GetGpioLevel(uint8_t pin) {
+  std::lock_guard<std::mutex> lock(gpio_mutex);
+  return pin < HOST_GPIO_PINS ? gpio_levels[pin] : LOW;
+}
+
+void host_StartGpioRecording(size_t max_events) {
+  std::lock_guard<std::mutex> lock(gpio_mutex);
+  gpio_events.clear();
+  gpio_events.reserve(max_events);
+  gpio_events_max = max_events;
+}
+
+size_t host_StopGpioRecording(host_gpio_event_t *events, size_t max) {
+  std::lock_guard<std::mutex> lock(gpio_mutex);
+  size_t count = std::min(max, gpio_events.size());
+  std::copy(gpio_events.begin(), gpio_events.begin() + count, events);
+  gpio_events.clear();
+  gpio_events_max = 0;
+  return count;
+}
+
+static std::mt19937 &generator(void) {
+  static thread_local std::mt19937 instance(std::random_device{}());
+  return instance;
+}
+
+long random(long max) { return max > 0 ? random(0, max) : 0; }
+
+long random(long min, long max) {
+  if (max <= min) {
+    return min;
+  }
+  return std::uniform_int_distribution<long>(min, max - 1)(generator());
+}
+
+uint32_t esp_random(void) { return generator()(); }
+
+bool getLocalTime(struct tm *info, uint32_t) {
+  time_t now = time(nullptr);
+  localtime_r(&now, info);
+  return true;
+}
+
+esp_reset_reason_t esp_reset_reason(void) { return ESP_RST_POWERON; }
+
+esp_err_t esp_register_shutdown_handler(shutdown_handler_t) {
+  return ESP_OK;
+}
+
+const ip_addr_t *esp_sntp_getserver(uint8_t) { return nullptr; }
+
+void esp_sntp_servermode_dhcp(bool) {}
+
+static host_task_t *currentTask(void) {
+  if (current_task == nullptr) {
+    // Also threads not started by xTaskCreate(), they are never freed
+    current_task = new host_task_t();
+  }
+  return current_task;
+}
+
+// Name, stack size and priority are the host's
+BaseType_t xTaskCreate(TaskFunction_t function, const char *, uint32_t,
+                       void *arg, UBaseType_t, TaskHandle_t *handle) {
+  host_task_t *task = new host_task_t();
+  if (handle != nullptr) {
+    *handle = task;
+  }
+  std::thread([task, function, arg] {
+    current_task = task;
+    function(arg);
+  }).detach();
+  return pdPASS;
+}
+
+// Tasks only delete themselves, their thread ends with the function
+void vTaskDelete(TaskHandle_t) {}
+
+void vTaskDelay(TickType_t ticks) { delay(ticks * portTICK_PERIOD_MS); }
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return currentTask(); }
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t function, const char *name,
+                               uint32_t stack_size, void *arg,
+                               UBaseType_t priority, StackType_t *,
+                               StaticTask_t *) {
+  TaskHandle_t handle;
+  xTaskCreate(function, name, stack_size, arg, priority, &handle);
+  return handle;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 0; }
+
+static bool waitNotified(host_task_t *task,
+                         std::unique_lock<std::mutex> &lock, TickType_t wait,
+                         const std::function<bool(void)> &ready) {
+  if (wait == portMAX_DELAY) {
+    task->condition.wait(lock, ready);
+    return true;
+  }
+  return task->condition.wait_for(
+      lock, std::chrono::milliseconds(wait * portTICK_PERIOD_MS), ready);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle) {
+  if (handle == nullptr) {
+    return pdFAIL;
+  }
+  host_task_t *task = (host_task_t *)handle;
+  std::lock_guard<std::mutex> lock(task->mutex);
+  task->count++;
+  task->condition.notify_all();
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) {
+  host_task_t *task = currentTask();
+  std::unique_lock<std::mutex> lock(task->mutex);
+  waitNotified(task, lock, wait, [task] { return task->count > 0; });
+  uint32_t count = task->count;
+  task->count = (clear || count == 0) ? 0 : count - 1;
+  return count;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t handle, uint32_t value,
+                       eNotifyAction action) {
+  if (handle == nullptr) {
+    return pdFAIL;
+  }
+  host_task_t *task = (host_task_t *)handle;
+  std::lock_guard<std::mutex> lock(task->mutex);
+  switch (action) {
+  case eSetBits:
+    task->value |= value;
+    break;
+  case eIncrement:
+    task->value++;
+    break;
+  case eSetValueWithoutOverwrite:
+    if (task->notified) {
+      return pdFAIL;
+    }
+    task->value = value;
+    break;
+  case eSetValueWithOverwrite:
+    task->value = value;
+    break;
+  case eNoAction:
+    break;
+  }
+  task->notified = true;
+  task->condition.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                           uint32_t *value, TickType_t wait) {
+  host_task_t *task = currentTask();
+  std::unique_lock<std::mutex> lock(task->mutex);
+  if (!task->notified) {
+    task->value &= ~clear_on_entry;
+  }
+  if (!waitNotified(task, lock, wait, [task] { return task->notified; })) {
+    return pdFAIL;
+  }
+  if (value != nullptr) {
+    *value = task->value;
+  }
+  task->value &= ~clear_on_exit;
+  task->notified = false;
+  return pdPASS;
+}
@@ -0,0 +1,244 @@
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+// The subset of the Arduino-ESP32 core the clock modules use, for builds
+// on the host. Delays return at once and move the virtual uptime ahead.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/time.h>
+#include <time.h>
+#include <type_traits>
+
+#define PROGMEM
+#define F(x) x
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define IRAM_ATTR
+#define DEC 10
+#define HEX 16
+
+#define constrain(amt, low, high)                                              \
+  ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+
+class String : public std::string {
+public:
+  String() {}
+  String(const char *s) : std::string(s ? s : "") {}
+  String(const std::string &s) : std::string(s) {}
+  String(char c) : std::string(1, c) {}
+  String(int value) : std::string(std::to_string(value)) {}
+  String(unsigned int value) : std::string(std::to_string(value)) {}
+  String(long value) : std::string(std::to_string(value)) {}
+  String(unsigned long value, unsigned char base = DEC);
+
+  bool isEmpty(void) const { return empty(); }
+  unsigned int length(void) const { return size(); }
+  long toInt(void) const { return strtol(c_str(), nullptr, 10); }
+  bool startsWith(const String &s) const {
+    return compare(0, s.size(), s) == 0;
+  }
+  int indexOf(char c, unsigned int from = 0) const {
+    size_t pos = find(c, from);
+    return pos == npos ? -1 : (int)pos;
+  }
+  int indexOf(const String &s, unsigned int from = 0) const {
+    size_t pos = find(s, from);
+    return pos == npos ? -1 : (int)pos;
+  }
+  int lastIndexOf(char c) const {
+    size_t pos = rfind(c);
+    return pos == npos ? -1 : (int)pos;
+  }
+  String substring(unsigned int from) const {
+    return from >= size() ? String() : String(substr(from));
+  }
+  String substring(unsigned int from, unsigned int to) const {
+    return (from >= size() || to <= from) ? String()
+                                          : String(substr(from, to - from));
+  }
+  void toUpperCase(void) {
+    for (char &c : *this) {
+      c = toupper((unsigned char)c);
+    }
+  }
+  void remove(unsigned int index, unsigned int count = (unsigned int)-1) {
+    if (index < size()) {
+      erase(index, count);
+    }
+  }
+  bool concat(const char *s, unsigned int n) {
+    append(s, n);
+    return true;
+  }
+  bool concat(const String &s) {
+    append(s);
+    return true;
+  }
+  String &operator+=(const String &s) {
+    append(s);
+    return *this;
+  }
+  String &operator+=(const char *s) {
+    append(s);
+    return *this;
+  }
+  String &operator+=(char c) {
+    push_back(c);
+    return *this;
+  }
+};
+
+inline String operator+(const String &a, const String &b) {
+  String result(a);
+  result.append(b);
+  return result;
+}
+inline String operator+(const String &a, const char *b) {
+  String result(a);
+  result.append(b);
+  return result;
+}
+inline String operator+(const char *a, const String &b) {
+  String result(a);
+  result.append(b);
+  return result;
+}
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+  size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t println(const char *s) { return print(s) + print("\r\n"); }
+  size_t printf(const char *format, ...)
+      __attribute__((format(printf, 2, 3))) {
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (len < 0) {
+      return 0;
+    }
+    return write((const uint8_t *)buffer,
+                 std::min((size_t)len, sizeof(buffer) - 1));
+  }
+};
+
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  void setDebugOutput(bool) {}
+  size_t write(const uint8_t *buffer, size_t size) override {
+    return fwrite(buffer, 1, size, stdout);
+  }
+};
+extern HardwareSerial Serial;
+
+class IPAddress {
+public:
+  IPAddress() : address(0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+      : address(a | b << 8 | c << 16 | (uint32_t)d << 24) {}
+  IPAddress(uint32_t value) : address(value) {}
+  IPAddress(const char *s) : address(0) { fromString(s); }
+  bool fromString(const char *s);
+  bool fromString(const String &s) { return fromString(s.c_str()); }
+  String toString(void) const;
+  operator uint32_t() const { return address; }
+  uint8_t operator[](int index) const { return address >> (8 * index); }
+
+private:
+  uint32_t address; // network order, like lwIP
+};
+
+class EspClass {
+public:
+  // Only counted, the caller goes on
+  void restart(void);
+  uint64_t getEfuseMac(void) { return 0x0000A4CF12345678ULL; }
+  // Set with host_SetHeap()
+  uint32_t getFreeHeap(void);
+  uint32_t getMinFreeHeap(void);
+  uint32_t getMaxAllocHeap(void);
+};
+extern EspClass ESP;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+long random(long max);
+long random(long min, long max);
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+
+// FreeRTOS subset, tasks run as threads
+typedef void *TaskHandle_t;
+typedef unsigned int UBaseType_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void *);
+typedef uint8_t StackType_t;
+typedef struct {
+} StaticTask_t;
+typedef enum {
+  eNoAction = 0,
+  eSetBits,
+  eIncrement,
+  eSetValueWithOverwrite,
+  eSetValueWithoutOverwrite
+} eNotifyAction;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFF
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name,
+                       uint32_t stack_size, void *arg, UBaseType_t priority,
+                       TaskHandle_t *handle);
+// The thread keeps its own stack
+TaskHandle_t xTaskCreateStatic(TaskFunction_t function, const char *name,
+                               uint32_t stack_size, void *arg,
+                               UBaseType_t priority, StackType_t *stack,
+                               StaticTask_t *buffer);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait);
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value,
+                       eNotifyAction action);
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                           uint32_t *value, TickType_t wait);
+
+extern "C" {
+int64_t esp_timer_get_time(void);
+uint32_t esp_random(void);
+}
+
+#endif
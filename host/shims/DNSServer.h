@@ -0,0 +1,21 @@
+#ifndef _HOST_DNSSERVER_H_
+#define _HOST_DNSSERVER_H_
+
+#include <Arduino.h>
+
+enum class DNSReplyCode {
+  NoError = 0,
+  ServerFailure = 2,
+  NonExistentDomain = 3
+};
+
+// The captive portal DNS, nothing asks it on the host
+class DNSServer {
+public:
+  bool start(uint16_t, const String &, const IPAddress &) { return true; }
+  void stop(void) {}
+  void processNextRequest(void) {}
+  void setErrorReplyCode(const DNSReplyCode &) {}
+};
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef _HOST_ESPMDNS_H_
+#define _HOST_ESPMDNS_H_
+
+#include <Arduino.h>
+
+class MDNSResponder {
+public:
+  bool begin(const String &) { return true; }
+};
+
+extern MDNSResponder MDNS;
+
+#endif
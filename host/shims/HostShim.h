@@ -0,0 +1,42 @@
+#ifndef _HOST_SHIM_H_
+#define _HOST_SHIM_H_
+
+#include <Arduino.h>
+
+#define HOST_GPIO_PINS 64
+
+typedef struct {
+  uint32_t sets;    // nvs_set_*() and put*() calls
+  uint32_t writes;  // of those the ones that changed the stored value
+  uint32_t erases;
+  uint32_t commits;
+} host_nvs_stats_t;
+
+typedef struct {
+  int64_t time;  // us of virtual uptime
+  uint8_t pin;
+  uint8_t value;
+} host_gpio_event_t;
+
+// NVS kept in a file, read now and rewritten on every commit. Without a
+// file it only lives in memory.
+void host_SetNvsFile(const char *path);
+void host_GetNvsStats(host_nvs_stats_t &stats);
+void host_ResetNvsStats(void);
+
+// GPIO writes, the events are only kept while recording
+uint32_t host_GetGpioWrites(void);
+int host_GetGpioLevel(uint8_t pin);
+void host_StartGpioRecording(size_t max_events);
+size_t host_StopGpioRecording(host_gpio_event_t *events, size_t max);
+
+// ESP.restart() calls, the program keeps running
+uint32_t host_GetRestarts(void);
+
+// What ESP reports of the heap, the lowest free value is kept as well
+void host_SetHeap(uint32_t free, uint32_t largest);
+
+// Time delay() and delayMicroseconds() skipped, added to the uptime
+int64_t host_GetSkippedTime(void);
+
+#endif
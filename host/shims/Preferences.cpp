@@ -0,0 +1,297 @@
+#include "HostShim.h"
+#include "Preferences.h"
+#include "nvs_flash.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+typedef std::vector<uint8_t> nvs_value_t;
+typedef std::map<std::string, nvs_value_t> nvs_namespace_t;
+
+// Handles are indices into the names + 1
+static std::mutex nvs_mutex;
+static std::map<std::string, nvs_namespace_t> nvs_store;
+static std::vector<std::string> nvs_handles;
+static std::string nvs_file;
+static host_nvs_stats_t nvs_stats;
+
+// One "namespace key hex" line per value
+static void loadFile(void) {
+  FILE *file = fopen(nvs_file.c_str(), "r");
+  if (file == nullptr) {
+    return;
+  }
+  char name[64], key[64];
+  char hex[8192];
+  while (fscanf(file, "%63s %63s %8191s", name, key, hex) == 3) {
+    nvs_value_t value;
+    for (const char *p = hex; p[0] != '\0' && p[1] != '\0'; p += 2) {
+      unsigned int byte;
+      sscanf(p, "%2x", &byte);
+      value.push_back(byte);
+    }
+    nvs_store[name][key] = value;
+  }
+  fclose(file);
+}
+
+static void storeFile(void) {
+  if (nvs_file.empty()) {
+    return;
+  }
+  FILE *file = fopen(nvs_file.c_str(), "w");
+  if (file == nullptr) {
+    return;
+  }
+  for (const auto &space : nvs_store) {
+    for (const auto &entry : space.second) {
+      fprintf(file, "%s %s ", space.first.c_str(), entry.first.c_str());
+      for (uint8_t byte : entry.second) {
+        fprintf(file, "%02x", byte);
+      }
+      // An empty value still needs a third field
+      fprintf(file, entry.second.empty() ? "-\n" : "\n");
+    }
+  }
+  fclose(file);
+}
+
+void host_SetNvsFile(const char *path) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_file = path;
+  nvs_store.clear();
+  loadFile();
+}
+
+void host_GetNvsStats(host_nvs_stats_t &stats) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  stats = nvs_stats;
+}
+
+void host_ResetNvsStats(void) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  memset(&nvs_stats, 0, sizeof(nvs_stats));
+}
+
+static nvs_namespace_t *findNamespace(nvs_handle_t handle) {
+  if (handle == 0 || handle > nvs_handles.size()) {
+    return nullptr;
+  }
+  return &nvs_store[nvs_handles[handle - 1]];
+}
+
+static esp_err_t setValue(nvs_handle_t handle, const char *key,
+                          const void *data, size_t length) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_namespace_t *space = findNamespace(handle);
+  if (space == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  nvs_value_t value((const uint8_t *)data, (const uint8_t *)data + length);
+  nvs_stats.sets++;
+  // Like NVS an equal value is not written again
+  auto entry = space->find(key);
+  if (entry == space->end() || entry->second != value) {
+    (*space)[key] = value;
+    nvs_stats.writes++;
+  }
+  return ESP_OK;
+}
+
+esp_err_t nvs_flash_init(void) { return ESP_OK; }
+
+esp_err_t nvs_flash_erase(void) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_store.clear();
+  nvs_stats.erases++;
+  storeFile();
+  return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t, nvs_handle_t *handle) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_handles.push_back(name);
+  *handle = nvs_handles.size();
+  return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t) {}
+
+esp_err_t nvs_commit(nvs_handle_t) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_stats.commits++;
+  storeFile();
+  return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_namespace_t *space = findNamespace(handle);
+  if (space == nullptr || space->erase(key) == 0) {
+    return ESP_ERR_NVS_NOT_FOUND;
+  }
+  nvs_stats.erases++;
+  return ESP_OK;
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t handle) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_namespace_t *space = findNamespace(handle);
+  if (space == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  space->clear();
+  nvs_stats.erases++;
+  return ESP_OK;
+}
+
+esp_err_t nvs_set_u8(nvs_handle_t handle, const char *key, uint8_t value) {
+  return setValue(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_i32(nvs_handle_t handle, const char *key, int32_t value) {
+  return setValue(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char *key, uint32_t value) {
+  return setValue(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_str(nvs_handle_t handle, const char *key,
+                      const char *value) {
+  return setValue(handle, key, value, strlen(value));
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value,
+                       size_t length) {
+  return setValue(handle, key, value, length);
+}
+
+bool Preferences::begin(const char *name, bool read_only, const char *) {
+  end();
+  opened = nvs_open(name, read_only ? NVS_READONLY : NVS_READWRITE,
+                    &handle) == ESP_OK;
+  return opened;
+}
+
+void Preferences::end(void) {
+  if (opened) {
+    nvs_close(handle);
+    opened = false;
+  }
+}
+
+bool Preferences::clear(void) {
+  return opened && nvs_erase_all(handle) == ESP_OK &&
+         nvs_commit(handle) == ESP_OK;
+}
+
+bool Preferences::remove(const char *key) {
+  return opened && nvs_erase_key(handle, key) == ESP_OK &&
+         nvs_commit(handle) == ESP_OK;
+}
+
+bool Preferences::isKey(const char *key) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_namespace_t *space = opened ? findNamespace(handle) : nullptr;
+  return space != nullptr && space->count(key) > 0;
+}
+
+size_t Preferences::put(const char *key, const void *value, size_t length) {
+  if (!opened || setValue(handle, key, value, length) != ESP_OK ||
+      nvs_commit(handle) != ESP_OK) {
+    return 0;
+  }
+  return length;
+}
+
+bool Preferences::get(const char *key, void *value, size_t length) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_namespace_t *space = opened ? findNamespace(handle) : nullptr;
+  if (space == nullptr) {
+    return false;
+  }
+  auto entry = space->find(key);
+  if (entry == space->end() || entry->second.size() != length) {
+    return false;
+  }
+  memcpy(value, entry->second.data(), length);
+  return true;
+}
+
+size_t Preferences::putUChar(const char *key, uint8_t value) {
+  return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putBool(const char *key, bool value) {
+  return putUChar(key, value ? 1 : 0);
+}
+
+size_t Preferences::putInt(const char *key, int32_t value) {
+  return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value) {
+  return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putString(const char *key, const char *value) {
+  return put(key, value, strlen(value));
+}
+
+size_t Preferences::putString(const char *key, const String &value) {
+  return putString(key, value.c_str());
+}
+
+size_t Preferences::putBytes(const char *key, const void *value,
+                             size_t length) {
+  return put(key, value, length);
+}
+
+uint8_t Preferences::getUChar(const char *key, uint8_t default_value) {
+  uint8_t value;
+  return get(key, &value, sizeof(value)) ? value : default_value;
+}
+
+bool Preferences::getBool(const char *key, bool default_value) {
+  return getUChar(key, default_value ? 1 : 0) != 0;
+}
+
+int32_t Preferences::getInt(const char *key, int32_t default_value) {
+  int32_t value;
+  return get(key, &value, sizeof(value)) ? value : default_value;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t default_value) {
+  uint32_t value;
+  return get(key, &value, sizeof(value)) ? value : default_value;
+}
+
+String Preferences::getString(const char *key, String default_value) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_namespace_t *space = opened ? findNamespace(handle) : nullptr;
+  if (space == nullptr) {
+    return default_value;
+  }
+  auto entry = space->find(key);
+  if (entry == space->end()) {
+    return default_value;
+  }
+  return String(std::string(entry->second.begin(), entry->second.end()));
+}
+
+// Like on the device a too small buffer reads nothing
+size_t Preferences::getBytes(const char *key, void *buffer, size_t length) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_namespace_t *space = opened ? findNamespace(handle) : nullptr;
+  if (space == nullptr) {
+    return 0;
+  }
+  auto entry = space->find(key);
+  if (entry == space->end() || entry->second.size() > length) {
+    return 0;
+  }
+  memcpy(buffer, entry->second.data(), entry->second.size());
+  return entry->second.size();
+}
@@ -0,0 +1,44 @@
+#ifndef _HOST_PREFERENCES_H_
+#define _HOST_PREFERENCES_H_
+
+#include "nvs.h"
+#include <Arduino.h>
+
+// Preferences on top of the host NVS, each put is committed like on the
+// device
+class Preferences {
+public:
+  Preferences() : handle(0), opened(false) {}
+  ~Preferences() { end(); }
+
+  bool begin(const char *name, bool read_only = false,
+             const char *partition = nullptr);
+  void end(void);
+  bool clear(void);
+  bool remove(const char *key);
+  bool isKey(const char *key);
+
+  size_t putUChar(const char *key, uint8_t value);
+  size_t putBool(const char *key, bool value);
+  size_t putInt(const char *key, int32_t value);
+  size_t putUInt(const char *key, uint32_t value);
+  size_t putString(const char *key, const char *value);
+  size_t putString(const char *key, const String &value);
+  size_t putBytes(const char *key, const void *value, size_t length);
+
+  uint8_t getUChar(const char *key, uint8_t default_value = 0);
+  bool getBool(const char *key, bool default_value = false);
+  int32_t getInt(const char *key, int32_t default_value = 0);
+  uint32_t getUInt(const char *key, uint32_t default_value = 0);
+  String getString(const char *key, String default_value = String());
+  size_t getBytes(const char *key, void *buffer, size_t length);
+
+private:
+  size_t put(const char *key, const void *value, size_t length);
+  bool get(const char *key, void *value, size_t length);
+
+  nvs_handle_t handle;
+  bool opened;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#include "Update.h"
+#include "esp_ota_ops.h"
+
+#define ESP_IMAGE_MAGIC 0xE9
+
+UpdateClass Update;
+
+static const esp_partition_t running_partition = {0x10000, 0x1E0000, "app0"};
+static esp_ota_img_states_t running_state = ESP_OTA_IMG_VALID;
+
+bool UpdateClass::begin(size_t, int) {
+  if (running) {
+    error = "Already Running";
+    return false;
+  }
+  running = true;
+  written = 0;
+  error = "No Error";
+  return true;
+}
+
+size_t UpdateClass::write(uint8_t *data, size_t len) {
+  if (!running) {
+    return 0;
+  }
+  if (written == 0 && len > 0) {
+    first = data[0];
+  }
+  if (written + len > running_partition.size) {
+    error = "Not Enough Space";
+    return 0;
+  }
+  written += len;
+  return len;
+}
+
+bool UpdateClass::end(bool) {
+  if (!running) {
+    error = "Not Running";
+    return false;
+  }
+  running = false;
+  if (written == 0 || first != ESP_IMAGE_MAGIC) {
+    error = "Magic Byte Invalid";
+    return false;
+  }
+  return true;
+}
+
+void UpdateClass::abort(void) {
+  running = false;
+  error = "Aborted";
+}
+
+const esp_partition_t *esp_ota_get_running_partition(void) {
+  return &running_partition;
+}
+
+esp_err_t esp_ota_get_state_partition(const esp_partition_t *partition,
+                                      esp_ota_img_states_t *state) {
+  if (partition == nullptr || state == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  *state = running_state;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_valid_cancel_rollback(void) {
+  running_state = ESP_OTA_IMG_VALID;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot(void) {
+  running_state = ESP_OTA_IMG_INVALID;
+  ESP.restart();
+  return ESP_OK;
+}
+
+void host_SetOtaState(esp_ota_img_states_t state) { running_state = state; }
@@ -0,0 +1,27 @@
+#ifndef _HOST_UPDATE_H_
+#define _HOST_UPDATE_H_
+
+#include <Arduino.h>
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+#define U_FLASH 0
+
+// The image is only counted. Like on the device end() rejects an image
+// that does not start with the ESP32 magic byte.
+class UpdateClass {
+public:
+  bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = U_FLASH);
+  size_t write(uint8_t *data, size_t len);
+  bool end(bool even_if_remaining = false);
+  void abort(void);
+  const char *errorString(void) { return error; }
+
+private:
+  bool running = false;
+  size_t written = 0;
+  uint8_t first = 0;
+  const char *error = "No Error";
+};
+extern UpdateClass Update;
+
+#endif
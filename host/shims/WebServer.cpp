@@ -0,0 +1,183 @@
+#include "WebServer.h"
+#include <strings.h>
+
+static WebServer *lastServer = nullptr;
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  c = tolower((unsigned char)c);
+  return (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+}
+
+// '+' is a space, a broken escape is kept as it is
+static String urlDecode(const String &text) {
+  String result;
+  for (size_t i = 0; i < text.length(); i++) {
+    int high, low;
+    if (text[i] == '+') {
+      result += ' ';
+    } else if (text[i] == '%' && i + 2 < text.length() &&
+               (high = hexDigit(text[i + 1])) >= 0 &&
+               (low = hexDigit(text[i + 2])) >= 0) {
+      result += (char)(high << 4 | low);
+      i += 2;
+    } else {
+      result += text[i];
+    }
+  }
+  return result;
+}
+
+void WebServer::on(const String &uri, HTTPMethod method,
+                   THandlerFunction handler) {
+  routes.push_back({uri, method, handler, nullptr});
+}
+
+void WebServer::on(const String &uri, HTTPMethod method,
+                   THandlerFunction handler, THandlerFunction upload) {
+  routes.push_back({uri, method, handler, upload});
+}
+
+void WebServer::collectHeaders(const char *keys[], size_t count) {
+  headerKeys.assign(keys, keys + count);
+}
+
+String WebServer::arg(const String &name) {
+  for (const std::pair<String, String> &item : args) {
+    if (item.first == name) {
+      return item.second;
+    }
+  }
+  return String();
+}
+
+bool WebServer::hasArg(const String &name) {
+  for (const std::pair<String, String> &item : args) {
+    if (item.first == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Only the collected headers and Host are kept, like on the device
+String WebServer::header(const String &name) {
+  bool collected = strcasecmp(name.c_str(), "Host") == 0;
+  for (const String &key : headerKeys) {
+    collected = collected || strcasecmp(key.c_str(), name.c_str()) == 0;
+  }
+  size_t start = 0;
+  while (collected && start < request.headers.length()) {
+    size_t end = request.headers.find("\r\n", start);
+    if (end == String::npos) {
+      end = request.headers.length();
+    }
+    String line = request.headers.substring(start, end);
+    int colon = line.indexOf(':');
+    if (colon > 0 && strcasecmp(line.substring(0, colon).c_str(),
+                                name.c_str()) == 0) {
+      size_t value = colon + 1;
+      while (value < line.length() && line[value] == ' ') {
+        value++;
+      }
+      return line.substring(value);
+    }
+    start = end + 2;
+  }
+  return String();
+}
+
+WebServer::WebServer(int) : response(&discarded) { lastServer = this; }
+
+void WebServer::send(int code, const char *content_type,
+                     const String &content) {
+  response->code = code;
+  response->content_type = content_type ? content_type : "";
+  response->body += content;
+}
+
+void WebServer::send_P(int code, const char *content_type,
+                       const char *content, size_t len) {
+  send(code, content_type, String());
+  response->body.append(content, len);
+}
+
+void WebServer::sendHeader(const String &name, const String &value,
+                           bool first) {
+  String line = name + ": " + value + "\r\n";
+  if (first) {
+    response->headers.insert(0, line);
+  } else {
+    response->headers += line;
+  }
+}
+
+// The file arrives in chunks of the device's buffer size
+void WebServer::runUpload(const route_t &route) {
+  const String &file = request.upload;
+  requestUpload.filename = "firmware.bin";
+  requestUpload.totalSize = 0;
+  requestUpload.currentSize = 0;
+  requestUpload.status = UPLOAD_FILE_START;
+  route.upload();
+  for (size_t pos = 0; pos < file.length(); pos += HTTP_UPLOAD_BUFLEN) {
+    size_t len = std::min(file.length() - pos, (size_t)HTTP_UPLOAD_BUFLEN);
+    memcpy(requestUpload.buf, file.data() + pos, len);
+    requestUpload.currentSize = len;
+    requestUpload.totalSize += len;
+    requestUpload.status = UPLOAD_FILE_WRITE;
+    route.upload();
+  }
+  requestUpload.currentSize = 0;
+  requestUpload.status = UPLOAD_FILE_END;
+  route.upload();
+}
+
+void host_Request(WebServer &server, const host_request_t &request,
+                  host_response_t &response) {
+  server.request = request;
+  server.requestClient = WiFiClient(request.local_ip);
+  server.args.clear();
+  size_t start = 0;
+  while (start < request.query.length()) {
+    size_t end = request.query.find('&', start);
+    if (end == String::npos) {
+      end = request.query.length();
+    }
+    String item = request.query.substring(start, end);
+    int equals = item.indexOf('=');
+    if (!item.isEmpty()) {
+      server.args.push_back(
+          equals < 0 ? std::make_pair(urlDecode(item), String())
+                     : std::make_pair(urlDecode(item.substring(0, equals)),
+                                      urlDecode(item.substring(equals + 1))));
+    }
+    start = end + 1;
+  }
+  if (!request.body.isEmpty()) {
+    server.args.push_back(std::make_pair(String("plain"), request.body));
+  }
+
+  response = host_response_t();
+  server.response = &response;
+  bool found = false;
+  for (const WebServer::route_t &route : server.routes) {
+    if (route.uri == request.uri &&
+        (route.method == HTTP_ANY || route.method == request.method)) {
+      if (route.upload && !request.upload.isEmpty()) {
+        server.runUpload(route);
+      }
+      route.handler();
+      found = true;
+      break;
+    }
+  }
+  if (!found && server.notFound) {
+    server.notFound();
+  }
+  server.response = &server.discarded;
+}
+
+WebServer *host_GetWebServer(void) { return lastServer; }
@@ -0,0 +1,123 @@
+#ifndef _HOST_WEBSERVER_H_
+#define _HOST_WEBSERVER_H_
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <functional>
+#include <vector>
+
+typedef enum {
+  HTTP_ANY,
+  HTTP_GET,
+  HTTP_HEAD,
+  HTTP_POST,
+  HTTP_PUT,
+  HTTP_PATCH,
+  HTTP_DELETE,
+  HTTP_OPTIONS
+} HTTPMethod;
+
+typedef enum {
+  UPLOAD_FILE_START,
+  UPLOAD_FILE_WRITE,
+  UPLOAD_FILE_END,
+  UPLOAD_FILE_ABORTED
+} HTTPUploadStatus;
+
+#define HTTP_UPLOAD_BUFLEN 1436
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+typedef struct {
+  HTTPUploadStatus status;
+  String filename;
+  size_t totalSize;
+  size_t currentSize;
+  uint8_t buf[HTTP_UPLOAD_BUFLEN];
+} HTTPUpload;
+
+// A request handed to host_Request(), there is no socket on the host
+typedef struct {
+  HTTPMethod method;
+  String uri;
+  String query;       // "name=value&..." url encoded, a form body as well
+  String body;        // other bodies, the handlers read it as "plain"
+  String headers;     // "Name: value\r\n" lines
+  IPAddress local_ip; // address the client connected to
+  String upload;      // file sent to a route with an upload handler
+} host_request_t;
+
+typedef struct {
+  int code;           // 0 if the handler sent nothing
+  String content_type;
+  String headers;     // "Name: value\r\n" lines in the order sent
+  String body;
+} host_response_t;
+
+class WebServer {
+
+public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  WebServer(int = 80);
+
+  void begin(void) {}
+  void handleClient(void) {}
+  void on(const String &uri, HTTPMethod method, THandlerFunction handler);
+  void on(const String &uri, HTTPMethod method, THandlerFunction handler,
+          THandlerFunction upload);
+  void onNotFound(THandlerFunction handler) { notFound = handler; }
+  void collectHeaders(const char *keys[], size_t count);
+
+  // The current request
+  HTTPMethod method(void) { return request.method; }
+  String uri(void) { return request.uri; }
+  String arg(const String &name);
+  bool hasArg(const String &name);
+  String header(const String &name);
+  String hostHeader(void) { return header("Host"); }
+  WiFiClient &client(void) { return requestClient; }
+  HTTPUpload &upload(void) { return requestUpload; }
+
+  void send(int code, const char *content_type, const String &content);
+  void send_P(int code, const char *content_type, const char *content,
+              size_t len);
+  void sendHeader(const String &name, const String &value,
+                  bool first = false);
+  void setContentLength(size_t) {}
+  void sendContent(const String &content) { response->body += content; }
+  void sendContent(const char *content, size_t size) {
+    response->body.append(content, size);
+  }
+
+private:
+  typedef struct {
+    String uri;
+    HTTPMethod method;
+    THandlerFunction handler;
+    THandlerFunction upload;
+  } route_t;
+
+  friend void host_Request(WebServer &server, const host_request_t &request,
+                           host_response_t &response);
+  void runUpload(const route_t &route);
+
+  std::vector<route_t> routes;
+  THandlerFunction notFound;
+  std::vector<String> headerKeys;
+
+  host_request_t request;
+  std::vector<std::pair<String, String>> args;
+  WiFiClient requestClient;
+  HTTPUpload requestUpload;
+  host_response_t *response; // sent outside of a request it is dropped
+  host_response_t discarded;
+};
+
+// Runs the handler of the request like handleClient() would and records
+// what it sends
+void host_Request(WebServer &server, const host_request_t &request,
+                  host_response_t &response);
+// The server constructed last, the sketch has only one
+WebServer *host_GetWebServer(void);
+
+#endif
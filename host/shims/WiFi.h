@@ -0,0 +1,130 @@
+#ifndef _HOST_WIFI_H_
+#define _HOST_WIFI_H_
+
+#include <Arduino.h>
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL,
+  WL_SCAN_COMPLETED,
+  WL_CONNECTED,
+  WL_CONNECT_FAILED,
+  WL_CONNECTION_LOST,
+  WL_DISCONNECTED
+} wl_status_t;
+
+typedef enum {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+} wifi_mode_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+#define INADDR_NONE IPAddress()
+
+typedef enum {
+  ARDUINO_EVENT_WIFI_STA_START,
+  ARDUINO_EVENT_WIFI_STA_CONNECTED,
+  ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+  ARDUINO_EVENT_WIFI_STA_GOT_IP,
+  ARDUINO_EVENT_WIFI_STA_LOST_IP,
+  ARDUINO_EVENT_WIFI_SCAN_DONE
+} arduino_event_id_t;
+typedef arduino_event_id_t WiFiEvent_t;
+
+enum {
+  WIFI_REASON_AUTH_EXPIRE = 2,
+  WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT = 15,
+  WIFI_REASON_AUTH_FAIL = 202,
+  WIFI_REASON_HANDSHAKE_TIMEOUT = 204
+};
+
+typedef struct {
+  uint8_t reason;
+} wifi_event_sta_disconnected_t;
+
+typedef union {
+  wifi_event_sta_disconnected_t wifi_sta_disconnected;
+} WiFiEventInfo_t;
+
+typedef void (*WiFiEventFuncCb)(WiFiEvent_t event, WiFiEventInfo_t info);
+
+// A client of the host WebServer, what is written to it is dropped
+class WiFiClient : public Print {
+public:
+  WiFiClient() : open(false) {}
+  WiFiClient(IPAddress local_ip) : open(true), local(local_ip) {}
+  size_t write(const uint8_t *, size_t size) override {
+    return open ? size : 0;
+  }
+  using Print::write;
+  bool connected(void) { return open; }
+  void stop(void) { open = false; }
+  int setNoDelay(bool) { return 0; }
+  IPAddress localIP(void) const { return local; }
+
+private:
+  bool open;
+  IPAddress local;
+};
+
+// The host counts as connected, its own network is used. The soft AP only
+// keeps its address and a scan finds nothing.
+class WiFiClass {
+public:
+  WiFiClass() : wifiMode(WIFI_STA) {}
+
+  wl_status_t status(void) { return WL_CONNECTED; }
+  wl_status_t begin(const char *, const char * = nullptr, int32_t = 0,
+                    const uint8_t * = nullptr, bool = true) {
+    return WL_DISCONNECTED;
+  }
+  bool config(IPAddress, IPAddress, IPAddress, IPAddress = IPAddress()) {
+    return true;
+  }
+  bool disconnect(bool = false) { return true; }
+  bool mode(wifi_mode_t new_mode) {
+    wifiMode = new_mode;
+    return true;
+  }
+  wifi_mode_t getMode(void) { return wifiMode; }
+  bool hostname(const String &) { return true; }
+  bool setHostname(const char *) { return true; }
+  bool setAutoReconnect(bool) { return true; }
+  bool persistent(bool) { return true; }
+  bool setSleep(bool) { return true; }
+  void onEvent(WiFiEventFuncCb, WiFiEvent_t) {}
+
+  IPAddress localIP(void) { return IPAddress(127, 0, 0, 1); }
+  IPAddress gatewayIP(void) { return IPAddress(); }
+  IPAddress subnetMask(void) { return IPAddress(255, 0, 0, 0); }
+  IPAddress dnsIP(uint8_t = 0) { return IPAddress(); }
+  uint8_t *BSSID(void) { return nullptr; }
+  int32_t channel(void) { return 0; }
+  int8_t RSSI(void) { return -50; }
+
+  bool softAPConfig(IPAddress ip, IPAddress, IPAddress) {
+    apAddress = ip;
+    return true;
+  }
+  bool softAP(const char *, const char * = nullptr) { return true; }
+  IPAddress softAPIP(void) {
+    return (wifiMode & WIFI_AP) ? apAddress : IPAddress();
+  }
+
+  int16_t scanNetworks(bool = false) { return 0; }
+  int16_t scanComplete(void) { return 0; }
+  void scanDelete(void) {}
+  String SSID(uint8_t) { return String(); }
+  int32_t RSSI(uint8_t) { return 0; }
+
+private:
+  wifi_mode_t wifiMode;
+  IPAddress apAddress;
+};
+extern WiFiClass WiFi;
+
+#endif
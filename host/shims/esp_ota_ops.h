@@ -0,0 +1,34 @@
+#ifndef _HOST_ESP_OTA_OPS_H_
+#define _HOST_ESP_OTA_OPS_H_
+
+#include "esp_err.h"
+#include <stdint.h>
+
+typedef enum {
+  ESP_OTA_IMG_NEW = 0,
+  ESP_OTA_IMG_PENDING_VERIFY = 1,
+  ESP_OTA_IMG_VALID = 2,
+  ESP_OTA_IMG_INVALID = 3,
+  ESP_OTA_IMG_ABORTED = 4,
+  ESP_OTA_IMG_UNDEFINED = -1
+} esp_ota_img_states_t;
+
+typedef struct {
+  uint32_t address;
+  uint32_t size;
+  char label[17];
+} esp_partition_t;
+
+extern "C" {
+const esp_partition_t *esp_ota_get_running_partition(void);
+esp_err_t esp_ota_get_state_partition(const esp_partition_t *partition,
+                                      esp_ota_img_states_t *state);
+esp_err_t esp_ota_mark_app_valid_cancel_rollback(void);
+// Counted as a restart like ESP.restart(), the program keeps running
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot(void);
+}
+
+// State of the running image, ESP_OTA_IMG_VALID unless set
+void host_SetOtaState(esp_ota_img_states_t state);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef _HOST_ESP_SNTP_H_
+#define _HOST_ESP_SNTP_H_
+
+#include <stdint.h>
+
+typedef struct {
+  uint32_t addr;
+} ip4_addr_t;
+
+typedef struct {
+  ip4_addr_t u_addr_ip4;
+  uint8_t type;
+} ip_addr_t;
+
+#define IP_IS_V4(ip) ((ip)->type == 0)
+#define ip_addr_isany(ip) ((ip)->u_addr_ip4.addr == 0)
+#define ip_2_ip4(ip) (&(ip)->u_addr_ip4)
+
+extern "C" {
+// There is no DHCP on the host, no server is announced
+const ip_addr_t *esp_sntp_getserver(uint8_t index);
+void esp_sntp_servermode_dhcp(bool enable);
+}
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef _HOST_ESP_TIMER_H_
+#define _HOST_ESP_TIMER_H_
+
+#include <Arduino.h>
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef _HOST_LWIP_NETDB_H_
+#define _HOST_LWIP_NETDB_H_
+
+#include <netdb.h>
+
+#endif
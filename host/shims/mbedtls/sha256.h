@@ -0,0 +1,21 @@
+#ifndef _HOST_MBEDTLS_SHA256_H_
+#define _HOST_MBEDTLS_SHA256_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// SHA-256 of FIPS 180-4, the update hashes checked on the host are real
+typedef struct {
+  uint32_t state[8];
+  uint64_t length; // bytes hashed
+  uint8_t block[64];
+} mbedtls_sha256_context;
+
+void mbedtls_sha256_init(mbedtls_sha256_context *ctx);
+void mbedtls_sha256_free(mbedtls_sha256_context *ctx);
+int mbedtls_sha256_starts(mbedtls_sha256_context *ctx, int is224);
+int mbedtls_sha256_update(mbedtls_sha256_context *ctx,
+                          const unsigned char *input, size_t len);
+int mbedtls_sha256_finish(mbedtls_sha256_context *ctx, unsigned char *output);
+
+#endif
@@ -0,0 +1,59 @@
+// Runs the tests of the clock modules on the host, see the README. Exits
+// with 1 if a check failed. An argument only runs the tests whose name
+// contains it.
+#include "HostTests.h"
+#include <algorithm>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+typedef struct {
+  const char *name;
+  const char *file;
+  int line;
+  host_test_t test;
+} host_test_entry_t;
+
+static int failures = 0;
+
+// Filled by the static constructors, so not a global
+static std::vector<host_test_entry_t> &entries(void) {
+  static std::vector<host_test_entry_t> tests;
+  return tests;
+}
+
+HostTestEntry::HostTestEntry(const char *name, const char *file, int line,
+                             host_test_t test) {
+  entries().push_back({name, file, line, test});
+}
+
+void host_Check(bool ok, const char *what, const char *file, int line) {
+  if (!ok) {
+    const char *base = strrchr(file, '/');
+    printf("  FAILED: %s (%s:%d)\n", what, base ? base + 1 : file, line);
+    failures++;
+  }
+}
+
+int main(int argc, char **argv) {
+  std::vector<host_test_entry_t> &tests = entries();
+  std::sort(tests.begin(), tests.end(),
+            [](const host_test_entry_t &a, const host_test_entry_t &b) {
+              int order = strcmp(a.file, b.file);
+              return order != 0 ? order < 0 : a.line < b.line;
+            });
+  int count = 0;
+  for (const host_test_entry_t &entry : tests) {
+    if (argc > 1 && strstr(entry.name, argv[1]) == nullptr) {
+      continue;
+    }
+    printf("%s\n", entry.name);
+    entry.test();
+    count++;
+  }
+  printf(failures ? "%d checks failed\n" : "%d tests passed\n",
+         failures ? failures : count);
+  fflush(stdout);
+  // Tasks started by the modules never end
+  _exit(failures ? 1 : 0);
+}
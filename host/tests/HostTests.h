@@ -0,0 +1,25 @@
+#ifndef _HOST_TESTS_H_
+#define _HOST_TESTS_H_
+
+#include <Arduino.h>
+
+typedef void (*host_test_t)(void);
+
+// Adds a test when the program starts, main() runs them by file and line
+class HostTestEntry {
+
+public:
+  HostTestEntry(const char *name, const char *file, int line, host_test_t test);
+};
+
+void host_Check(bool ok, const char *what, const char *file, int line);
+
+#define HOST_TEST(name)                                                       \
+  static void name(void);                                                     \
+  static HostTestEntry name##_entry(#name, __FILE__, __LINE__, name);         \
+  static void name(void)
+
+// Counts a failure and goes on, the test sees the next checks fail as well
+#define CHECK(ok) host_Check((ok), #ok, __FILE__, __LINE__)
+
+#endif
@@ -0,0 +1,93 @@
+#include "HostTests.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+
+// Every member of the document, false if the reader failed
+static bool readAll(const char *json, String &members) {
+  JsonReader reader(json, strlen(json));
+  String key, value;
+  json_type_t type;
+  members = "";
+  while (reader.next(key, type, value)) {
+    members += key + "=" + String((int)type) + ":" + value + ";";
+  }
+  return !reader.failed();
+}
+
+HOST_TEST(jsonReaderMembers) {
+  String members;
+  CHECK(readAll("{}", members) && members == "");
+  CHECK(readAll(" { \"a\" : 1 , \"b\":\"x\",\"c\":true,\"d\":null } ",
+                members));
+  CHECK(members == "a=1:1;b=0:x;c=2:true;d=3:null;");
+  CHECK(readAll("{\"s\":\"q\\\"\\\\\\/\\n\\u00e9\\u20ac\"}", members));
+  CHECK(members == "s=0:q\"\\/\n\xc3\xa9\xe2\x82\xac;");
+}
+
+HOST_TEST(jsonReaderErrors) {
+  static const char *const invalid[] = {
+      "",          "[]",          "{",           "{\"a\"}",
+      "{\"a\":}",  "{\"a\":1,}",  "{\"a\":[1]}", "{\"a\":{}}",
+      "{\"a\":1",  "{\"a\":\"x}", "{\"a\":\"\x01\"}",
+      "{\"a\":\"\\x\"}",          "{\"a\":\"\\ud800\"}",
+      "{\"a\":\"\\u12\"}",        "{\"a\":1} x",
+  };
+  String members;
+  for (const char *json : invalid) {
+    bool ok = readAll(json, members);
+    CHECK(!ok);
+    if (ok) {
+      printf("  accepted: %s\n", json);
+    }
+  }
+}
+
+HOST_TEST(jsonNumbers) {
+  int32_t i = 0;
+  uint32_t u = 0;
+  bool b = false;
+  CHECK(JsonReader::toInt(JSON_NUMBER, "-2147483648", i) && i == INT32_MIN);
+  CHECK(JsonReader::toInt(JSON_NUMBER, "2147483647", i) && i == INT32_MAX);
+  CHECK(!JsonReader::toInt(JSON_NUMBER, "2147483648", i));
+  CHECK(!JsonReader::toInt(JSON_NUMBER, "1.5", i));
+  CHECK(!JsonReader::toInt(JSON_STRING, "1", i));
+  CHECK(JsonReader::toUInt(JSON_NUMBER, "4294967295", u) && u == UINT32_MAX);
+  CHECK(!JsonReader::toUInt(JSON_NUMBER, "4294967296", u));
+  CHECK(!JsonReader::toUInt(JSON_NUMBER, "-0", u));
+  CHECK(JsonReader::toBool(JSON_BOOL, "true", b) && b);
+  CHECK(!JsonReader::toBool(JSON_NUMBER, "1", b));
+}
+
+static void appendFlush(void *context, const char *data, size_t len) {
+  ((String *)context)->append(data, len);
+}
+
+// Small buffer, the document is flushed in pieces and read back
+HOST_TEST(jsonWriterRoundTrip) {
+  char buffer[8];
+  String out;
+  JsonWriter json(buffer, sizeof(buffer), appendFlush, &out);
+  json.beginObject();
+  json.add("text", "a\"b\\c\n\t\x01");
+  json.add("neg", -42);
+  json.add("big", 18446744073709551615ULL);
+  json.add("on", true);
+  json.addNull("none");
+  json.endObject();
+  json.flush();
+  CHECK(!json.overflow() && json.total() == out.length());
+  String members;
+  CHECK(readAll(out.c_str(), members));
+  CHECK(members == "text=0:a\"b\\c\n\t\x01;neg=1:-42;"
+                   "big=1:18446744073709551615;on=2:true;none=3:null;");
+}
+
+HOST_TEST(jsonWriterOverflow) {
+  char buffer[8];
+  JsonWriter json(buffer, sizeof(buffer));
+  json.beginObject();
+  json.add("key", "a longer value");
+  json.endObject();
+  CHECK(json.overflow());
+  CHECK(json.length() <= sizeof(buffer));
+}
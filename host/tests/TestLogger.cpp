@@ -0,0 +1,107 @@
+#include "HostTests.h"
+#include "Logger.h"
+
+// Writes a record and formats it back, the time is left out
+template <typename... Args>
+static String logLine(const char *format, Args... args) {
+  Logger &logger = Logger::getInstance();
+  uint32_t cursor = logger.getOldest();
+  uint32_t lost = 0;
+  log_record_t record;
+  log_record_t last;
+  char line[LOG_LINE_MAX];
+
+  logger.write(LOG_MAIN, LOG_LEVEL_ERROR, format, args...);
+  while (logger.read(cursor, record, lost)) {
+    last = record;
+  }
+  last.time = 0;
+  Logger::format(last, line, sizeof(line));
+  return String(line).substring(strlen("0.000 main E "));
+}
+
+HOST_TEST(logFormat) {
+  CHECK(logLine("%lu %lld %p %s %%\n", 4000000000UL, -1234567890123LL,
+                (void *)0x1234, "text") ==
+        "4000000000 -1234567890123 0x1234 text %");
+  CHECK(logLine("%d %u %x %c", -5, 7U, 255, 'a') == "-5 7 ff a");
+  CHECK(logLine("[%5d|%-4s|%.2f]", 42, "ab", 1.5) == "[   42|ab  |1.50]");
+  // A missing argument and a stray % at the end
+  CHECK(logLine("%d %d %", 1) == "1 ? ");
+}
+
+HOST_TEST(logTypeMismatch) {
+  CHECK(logLine("%d %s %f", "abc", 5, 3LL) == "? ? ?");
+  CHECK(logLine("%s %d", (void *)nullptr, 2.5) == "? ?");
+  // The next argument is still found after a mismatch
+  CHECK(logLine("%s %s %d", 1LL, "ok", 3) == "? ok 3");
+}
+
+HOST_TEST(logArgWords) {
+  // Eight words hold four 64-bit arguments, the fifth is dropped
+  CHECK(logLine("%lld %lld %lld %lld %lld", 1LL, 2LL, 3LL, 4LL, 5LL) ==
+        "1 2 3 4 ?");
+  CHECK(logLine("%d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9) ==
+        "1 2 3 4 5 6 7 8 ?");
+  // A 64-bit argument does not fit the last word, nor does anything after it
+  CHECK(logLine("%d %d %d %d %d %d %d %lld %d", 1, 2, 3, 4, 5, 6, 7, 8LL, 9) ==
+        "1 2 3 4 5 6 7 ? ?");
+}
+
+HOST_TEST(logTextSize) {
+  String text(std::string(LOG_TEXT_SIZE + 8, 'x'));
+  String fits(std::string(LOG_TEXT_SIZE - 1, 'x'));
+
+  CHECK(logLine("%s|%s", text.c_str(), "more") == fits + "|");
+  CHECK(logLine("%s|%s|%s", "abc", text.c_str(), "more") ==
+        "abc|" + String(std::string(LOG_TEXT_SIZE - 5, 'x')) + "|");
+  CHECK(logLine("%s|%s", (const char *)nullptr, "b") == "|b");
+}
+
+// The line is cut at the buffer and always terminated
+HOST_TEST(logLineSize) {
+  Logger &logger = Logger::getInstance();
+  uint32_t cursor = logger.getOldest();
+  uint32_t lost = 0;
+  log_record_t record;
+  char line[20];
+
+  logger.write(LOG_NET, LOG_LEVEL_DEBUG, "%s %s", "abcdefghij", "klmnop");
+  while (logger.read(cursor, record, lost)) {
+  }
+  record.time = 1234567;
+  CHECK(Logger::format(record, line, sizeof(line)) == sizeof(line) - 1);
+  CHECK(strcmp(line, "1.234 net D abcdefg") == 0);
+}
+
+HOST_TEST(logReadWrapped) {
+  Logger &logger = Logger::getInstance();
+  uint32_t cursor = logger.getOldest();
+  uint32_t lost = 0;
+  log_record_t record;
+  log_stats_t stats;
+
+  while (logger.read(cursor, record, lost)) {
+  }
+  logger.getStats(stats);
+  CHECK(cursor == stats.records);
+  for (uint32_t i = 0; i < LOG_RECORDS + 10; i++) {
+    logger.write(LOG_MAIN, LOG_LEVEL_INFO, "record %lu", (unsigned long)i);
+  }
+  CHECK(logger.getOldest() == cursor + 10);
+
+  // The ten overwritten records are counted, the rest come in order
+  lost = 0;
+  uint32_t expected = 10;
+  while (logger.read(cursor, record, lost)) {
+    CHECK(record.count == 1 && record.args[0] == expected);
+    expected++;
+  }
+  CHECK(lost == 10);
+  CHECK(expected == LOG_RECORDS + 10);
+  logger.getStats(stats);
+  CHECK(cursor == stats.records);
+
+  // Nothing new, nothing lost
+  CHECK(!logger.read(cursor, record, lost) && lost == 10);
+}
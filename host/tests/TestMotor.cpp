@@ -0,0 +1,28 @@
+#include "HostShim.h"
+#include "HostTests.h"
+#include "MotorControl.h"
+
+// The clock plans its ticks with getRotateTime(), it has to match
+HOST_TEST(motorRotateTime) {
+  MotorControl &motor = MotorControl::getInstance();
+  static const int steps[] = {0, 1, 5, 64, 256, -256, 3000};
+  for (int count : steps) {
+    for (int delay_time : {2, 6}) {
+      int64_t skipped = host_GetSkippedTime();
+      uint32_t gpio = host_GetGpioWrites();
+      motor.rotate(count, delay_time, false);
+      skipped = host_GetSkippedTime() - skipped;
+      gpio = host_GetGpioWrites() - gpio;
+      CHECK(skipped == motor.getRotateTime(count, delay_time) * 1000LL);
+      CHECK(gpio == 4 * (uint32_t)abs(count) + 4);
+    }
+  }
+}
+
+HOST_TEST(motorPowerCut) {
+  MotorControl &motor = MotorControl::getInstance();
+  motor.rotate(-17, 2, true);
+  for (uint8_t pin = 0; pin < HOST_GPIO_PINS; pin++) {
+    CHECK(host_GetGpioLevel(pin) == LOW);
+  }
+}
@@ -0,0 +1,103 @@
+#include "HostShim.h"
+#include "HostTests.h"
+#include "PreferencesManager.h"
+
+// Flash operations of a commit() following the changes
+static void commitStats(host_nvs_stats_t &stats) {
+  PreferencesManager::getInstance().commit();
+  host_GetNvsStats(stats);
+  host_ResetNvsStats();
+}
+
+HOST_TEST(prefsSettersOnlyMarkDirty) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  host_nvs_stats_t stats;
+  commitStats(stats);
+
+  uint8_t delay_time = pm.getDelayTime();
+  bool chime = pm.getChime();
+  CHECK(pm.setDelayTime(delay_time == 2 ? 3 : 2) == PREF_OK);
+  CHECK(pm.setDelayTime(delay_time) == PREF_OK);
+  CHECK(pm.setChime(!chime) == PREF_OK);
+  host_GetNvsStats(stats);
+  CHECK(stats.sets == 0 && stats.commits == 0);
+
+  // The last value of each key, one commit
+  commitStats(stats);
+  CHECK(stats.sets == 2 && stats.writes == 1 && stats.commits == 1);
+  Preferences stored;
+  CHECK(stored.begin(PreferencesManager::PREFS_NAMESPACE, true));
+  CHECK(stored.getBool("Chime", chime) == !chime);
+  stored.end();
+
+  commitStats(stats);
+  CHECK(stats.sets == 0 && stats.commits == 0);
+  CHECK(pm.setChime(chime) == PREF_OK);
+  commitStats(stats);
+  CHECK(stats.writes == 1);
+}
+
+HOST_TEST(prefsSameValueIsClean) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  host_nvs_stats_t stats;
+  pref_settings_t settings;
+  const char *error;
+  commitStats(stats);
+
+  pm.getSettings(settings);
+  CHECK(pm.applySettings(settings, error) == PREF_OK);
+  CHECK(pm.setStepsPerMinute(pm.getStepsPerMinute()) == PREF_OK);
+  CHECK(pm.setHostName(pm.getHostName()) == PREF_OK);
+  commitStats(stats);
+  CHECK(stats.sets == 0 && stats.commits == 0);
+}
+
+HOST_TEST(prefsApplyAllOrNothing) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  host_nvs_stats_t stats;
+  pref_settings_t settings, changed;
+  const char *error = nullptr;
+  commitStats(stats);
+
+  pm.getSettings(settings);
+  changed = settings;
+  changed.chime = !settings.chime;
+  changed.delay_time = 0;
+  CHECK(pm.applySettings(changed, error) == PREF_ERROR);
+  CHECK(error != nullptr && strcmp(error, "Invalid Delay Time") == 0);
+  CHECK(pm.getChime() == settings.chime);
+  CHECK(pm.setDelayTime(0) == PREF_ERROR);
+  commitStats(stats);
+  CHECK(stats.sets == 0);
+
+  changed.delay_time = settings.delay_time;
+  CHECK(pm.applySettings(changed, error) == PREF_OK);
+  CHECK(pm.getChime() == changed.chime);
+  CHECK(pm.applySettings(settings, error) == PREF_OK);
+  // Dirty, but the flash already holds the value
+  commitStats(stats);
+  CHECK(stats.sets == 1 && stats.writes == 0);
+}
+
+HOST_TEST(prefsEraseDropsPending) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  host_nvs_stats_t stats;
+  commitStats(stats);
+
+  uint32_t position = pm.getClockPosition();
+  CHECK(pm.setClock(position + 1) == PREF_OK);
+  pm.eraseAll();
+  commitStats(stats);
+  CHECK(stats.sets == 0 && stats.commits == 0);
+  CHECK(stats.erases == 1);
+  CHECK(pm.setClock(position) == PREF_OK);
+}
+
+HOST_TEST(prefsRanges) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  uint32_t update = pm.getNTPUpdate();
+  CHECK(pm.setNTPUpdate(14) == PREF_ERROR);
+  CHECK(pm.setNTPUpdate(MAX_NTP_UPDATE + 1) == PREF_ERROR);
+  CHECK(pm.setNTPUpdate(MAX_NTP_UPDATE) == PREF_OK);
+  CHECK(pm.setNTPUpdate(update) == PREF_OK);
+}
@@ -0,0 +1,265 @@
+#include "HostTests.h"
+#include "SntpClient.h"
+#include <sys/time.h>
+#include <lwip/sockets.h>
+#include <thread>
+
+#define NTP_PACKET_SIZE 48
+#define NTP_UNIX_OFFSET 2208988800ULL
+
+typedef enum {
+  RESPONDER_GOOD = 0,
+  RESPONDER_KISS,     // kiss-o'-death, stratum 0 and a code
+  RESPONDER_UNSYNCED, // leap indicator 3, the server has no time
+  RESPONDER_FORGED,   // a reply with the wrong cookie before the right one
+} responder_mode_t;
+
+// A server on the loopback, answers one request per call
+typedef struct {
+  int sock;
+  uint16_t port;
+  responder_mode_t mode;
+  int64_t offset; // us, added to the local time
+  uint8_t stratum;
+} responder_t;
+
+// The servers of the tests, each one a responder or set up directly
+static sntp_server_t servers[SNTP_SERVERS_MAX];
+static sntp_stats_t stats;
+
+static void setServers(const responder_t *responders, int count) {
+  memset(servers, 0, sizeof(servers));
+  for (int i = 0; i < count; i++) {
+    snprintf(servers[i].name, sizeof(servers[i].name), "responder%d", i);
+    servers[i].port = responders[i].port;
+    servers[i].address = htonl(INADDR_LOOPBACK);
+  }
+}
+
+static int64_t nowUs(void) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return (int64_t)now.tv_sec * 1000000 + now.tv_usec;
+}
+
+static void writeTimestamp(uint8_t *p, int64_t us) {
+  uint64_t seconds = us / 1000000 + NTP_UNIX_OFFSET;
+  uint64_t fraction = ((uint64_t)(us % 1000000) << 32) / 1000000;
+  for (int i = 0; i < 4; i++) {
+    p[i] = seconds >> (24 - 8 * i);
+    p[4 + i] = fraction >> (24 - 8 * i);
+  }
+}
+
+static void openResponder(responder_t &responder, responder_mode_t mode,
+                          int64_t offset) {
+  struct sockaddr_in address;
+  socklen_t len = sizeof(address);
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  responder.sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  CHECK(bind(responder.sock, (struct sockaddr *)&address, len) == 0);
+  getsockname(responder.sock, (struct sockaddr *)&address, &len);
+  responder.port = ntohs(address.sin_port);
+  responder.mode = mode;
+  responder.offset = offset;
+  responder.stratum = 2;
+}
+
+// The reply claims no time between receive and transmit, so a wait before
+// it shows as network delay
+static void answer(const responder_t &responder, int wait_ms = 0) {
+  uint8_t request[NTP_PACKET_SIZE];
+  uint8_t reply[NTP_PACKET_SIZE];
+  struct sockaddr_in from;
+  socklen_t from_len = sizeof(from);
+  int len = recvfrom(responder.sock, request, sizeof(request), 0,
+                     (struct sockaddr *)&from, &from_len);
+  CHECK(len == NTP_PACKET_SIZE && (request[0] & 0x07) == 3);
+  std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
+
+  memset(reply, 0, sizeof(reply));
+  reply[0] = (4 << 3) | 4;
+  reply[1] = responder.stratum;
+  reply[6] = 0x01; // root delay and dispersion 1/256 s
+  reply[10] = 0x01;
+  int64_t now = nowUs() + responder.offset;
+  writeTimestamp(reply + 32, now);
+  writeTimestamp(reply + 40, now);
+  memcpy(reply + 24, request + 40, 8);
+  switch (responder.mode) {
+  case RESPONDER_KISS:
+    reply[1] = 0;
+    memcpy(reply + 12, "RATE", 4);
+    break;
+  case RESPONDER_UNSYNCED:
+    reply[0] |= 3 << 6;
+    break;
+  case RESPONDER_FORGED: {
+    uint8_t forged[NTP_PACKET_SIZE];
+    memcpy(forged, reply, sizeof(forged));
+    forged[24] ^= 0xFF;
+    writeTimestamp(forged + 40, now + 3600000000LL);
+    sendto(responder.sock, forged, sizeof(forged), 0,
+           (struct sockaddr *)&from, from_len);
+    break;
+  }
+  default:
+    break;
+  }
+  sendto(responder.sock, reply, sizeof(reply), 0, (struct sockaddr *)&from,
+         from_len);
+}
+
+static int openClient(void) {
+  return socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+}
+
+HOST_TEST(sntpRejectsReplies) {
+  responder_t responders[4];
+  openResponder(responders[0], RESPONDER_GOOD, 250000);
+  openResponder(responders[1], RESPONDER_KISS, 250000);
+  openResponder(responders[2], RESPONDER_UNSYNCED, 250000);
+  openResponder(responders[3], RESPONDER_FORGED, -400000);
+  setServers(responders, 4);
+
+  sntp_sample_t samples[SNTP_SERVERS_MAX][SNTP_BURST];
+  sntp_request_t requests[SNTP_SERVERS_MAX];
+  uint8_t count[SNTP_SERVERS_MAX] = {};
+  int sock = openClient();
+  SntpClient::sendRequests(sock, servers, 4, requests);
+  for (const responder_t &responder : responders) {
+    answer(responder);
+  }
+  SntpClient::receiveReplies(sock, servers, 4, requests, samples, count);
+  close(sock);
+
+  CHECK(count[0] == 1 && llabs(samples[0][0].offset - 250000) < 5000);
+  CHECK(count[1] == 0);
+  CHECK(count[2] == 0);
+  // Only the reply with the cookie of the request is taken
+  CHECK(count[3] == 1 && llabs(samples[3][0].offset + 400000) < 5000);
+  for (const responder_t &responder : responders) {
+    close(responder.sock);
+  }
+}
+
+// A burst with different waits, the fastest reply has the least error
+HOST_TEST(sntpLowestDelay) {
+  static const int waits[SNTP_BURST] = {20, 2, 30, 10};
+  responder_t responder;
+  openResponder(responder, RESPONDER_GOOD, -1500000);
+  setServers(&responder, 1);
+
+  sntp_sample_t samples[SNTP_SERVERS_MAX][SNTP_BURST];
+  sntp_request_t requests[SNTP_SERVERS_MAX];
+  uint8_t count[SNTP_SERVERS_MAX] = {};
+  int sock = openClient();
+  for (int wait : waits) {
+    SntpClient::sendRequests(sock, servers, 1, requests);
+    answer(responder, wait);
+    SntpClient::receiveReplies(sock, servers, 1, requests, samples, count);
+  }
+  close(sock);
+  close(responder.sock);
+
+  CHECK(count[0] == SNTP_BURST);
+  sntp_server_t &server = servers[0];
+  SntpClient::filterSamples(server, samples[0], count[0]);
+  CHECK(server.valid);
+  CHECK(server.delay >= 2000 && server.delay < 8000);
+  CHECK(llabs(server.offset + 1500000) < 4000);
+  CHECK(server.jitter > 2000);
+  CHECK(server.distance > server.delay / 2 + server.jitter);
+}
+
+static void setServer(int i, int64_t offset, int64_t distance) {
+  sntp_server_t &server = servers[i];
+  server.valid = distance <= SNTP_MAX_DISTANCE;
+  server.offset = offset;
+  server.distance = distance;
+  server.delay = distance;
+}
+
+HOST_TEST(sntpMarzullo) {
+  responder_t none[SNTP_SERVERS_MAX] = {};
+  int64_t offset = 0;
+
+  // Three agree, the fourth is far off
+  setServers(none, 4);
+  setServer(0, 100000, 20000);
+  setServer(1, 110000, 20000);
+  setServer(2, 5000000, 10000);
+  setServer(3, 105000, 40000);
+  CHECK(SntpClient::selectServers(servers, 4, offset, stats));
+  CHECK(stats.selected == 3 && !servers[2].selected);
+  CHECK(offset >= 100000 && offset <= 110000);
+
+  // Two that disagree, neither is trusted
+  uint32_t disagreements = stats.disagreements;
+  setServers(none, 2);
+  setServer(0, -3000000, 50000);
+  setServer(1, 2000, 10000);
+  CHECK(!SntpClient::selectServers(servers, 2, offset, stats));
+  CHECK(stats.selected == 0 && !servers[0].selected && !servers[1].selected);
+  CHECK(stats.disagreements == disagreements + 1);
+
+  // Not the one with the lowest distance either
+  setServers(none, 3);
+  setServer(0, 0, SNTP_MAX_DISTANCE + 1);
+  setServer(1, 700000, 30000);
+  setServer(2, -700000, 20000);
+  CHECK(!SntpClient::selectServers(servers, 3, offset, stats));
+  CHECK(stats.selected == 0 && stats.disagreements == disagreements + 2);
+
+  setServers(none, 2);
+  CHECK(!SntpClient::selectServers(servers, 2, offset, stats));
+  CHECK(stats.disagreements == disagreements + 2);
+}
+
+// A whole poll against a configured server an hour off and a good one:
+// the clock is not stepped to either. Once another good server answers
+// the configured one is left out.
+HOST_TEST(sntpBadConfiguredServer) {
+  responder_t responders[3];
+  openResponder(responders[0], RESPONDER_GOOD, -3600000000LL);
+  openResponder(responders[1], RESPONDER_GOOD, 2000);
+  openResponder(responders[2], RESPONDER_GOOD, 3000);
+
+  for (int count = 2; count <= 3; count++) {
+    sntp_sample_t samples[SNTP_SERVERS_MAX][SNTP_BURST];
+    sntp_request_t requests[SNTP_SERVERS_MAX];
+    uint8_t samples_count[SNTP_SERVERS_MAX] = {};
+    int64_t offset = 0;
+    uint32_t disagreements = stats.disagreements;
+
+    setServers(responders, count);
+    int sock = openClient();
+    SntpClient::sendRequests(sock, servers, count, requests);
+    for (int i = 0; i < count; i++) {
+      answer(responders[i]);
+    }
+    SntpClient::receiveReplies(sock, servers, count, requests, samples,
+                               samples_count);
+    close(sock);
+    for (int i = 0; i < count; i++) {
+      CHECK(samples_count[i] == 1 && samples[i][0].stratum == 2);
+      SntpClient::filterSamples(servers[i], samples[i], samples_count[i]);
+      CHECK(servers[i].valid);
+    }
+
+    bool selected = SntpClient::selectServers(servers, count, offset, stats);
+    if (count == 2) {
+      CHECK(!selected && stats.selected == 0);
+      CHECK(stats.disagreements == disagreements + 1);
+    } else {
+      CHECK(selected && stats.selected == 2 && !servers[0].selected);
+      CHECK(offset > -5000 && offset < 10000);
+      CHECK(stats.disagreements == disagreements);
+    }
+  }
+  for (const responder_t &responder : responders) {
+    close(responder.sock);
+  }
+}
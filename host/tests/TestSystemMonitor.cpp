@@ -0,0 +1,42 @@
+#include "HostShim.h"
+#include "HostTests.h"
+#include "SystemMonitor.h"
+
+// One sample an hour, each one becomes an hourly average
+static void runHours(int hours, uint32_t &heap, int32_t change) {
+  for (int i = 0; i < hours; i++) {
+    heap += change;
+    host_SetHeap(heap, heap / 2);
+    delay(MONITOR_HISTORY_INTERVAL);
+    SystemMonitor::getInstance().process();
+  }
+}
+
+HOST_TEST(monitorLeak) {
+  SystemMonitor &monitor = SystemMonitor::getInstance();
+  monitor_stats_t stats;
+  uint32_t heap = 150000;
+  const uint32_t leak = 1 << MONITOR_ALERT_LEAK;
+
+  // A steady heap fills the history
+  runHours(MONITOR_HISTORY, heap, 0);
+  monitor.getStats(stats);
+  CHECK(stats.heap_free == heap && stats.heap_trend == 0);
+  CHECK(stats.hours_left == 0 && !(stats.alerts & leak));
+  uint32_t alert_count = stats.alert_count;
+
+  // 1 KB an hour runs the heap out within the week
+  runHours(MONITOR_HISTORY, heap, -1024);
+  monitor.getStats(stats);
+  CHECK(stats.heap_free == heap && abs(stats.heap_trend + 1024) <= 1);
+  CHECK(stats.hours_left > 0 && stats.hours_left < MONITOR_EXHAUSTION_HOURS);
+  CHECK(abs((int32_t)stats.hours_left - (int32_t)(heap / 1024)) <= 1);
+  CHECK((stats.alerts & leak) && stats.alert_count == alert_count + 1);
+
+  // Once the history is steady again the alert goes
+  runHours(MONITOR_HISTORY, heap, 0);
+  monitor.getStats(stats);
+  CHECK(stats.heap_trend == 0 && stats.hours_left == 0);
+  CHECK(!(stats.alerts & leak) && stats.alert_count == alert_count + 1);
+  host_SetHeap(200000, 100000);
+}
@@ -0,0 +1,143 @@
+#include "HostTests.h"
+#include "TimeZone.h"
+#include "Zones.h"
+#include "config.h"
+
+#define TZ_TEST_FROM 1704067200  // 2024-01-01
+#define TZ_TEST_TO 1956528000    // 2032-01-01
+#define TZ_TEST_STEP (253 * 60)  // s, walks through all hours and minutes
+
+// Southern hemisphere, quoted names, Jn and n dates, negative and late
+// transition times and negative DST. Whole year DST (J1/0,J365/25) is left
+// out, glibc only looks at the transitions of the UTC year.
+static const char *const extra_rules[] = {
+    "AEST-10AEDT,M10.1.0,M4.1.0/3",
+    "NZST-12NZDT,M9.5.0,M4.1.0/3",
+    "<-04>4<-03>,M9.1.6/24,M4.1.6/24",
+    "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0",
+    "<-03>3<-02>,M3.5.0/-2,M10.5.0/-1",
+    "<+0545>-5:45",
+    "IST-1GMT0,M10.5.0,M3.5.0/1",
+    "EST5EDT,J60/2,J300/2",
+    "CET-1CEST,59/2,303/3",
+    "<-01>1<+00>,M3.5.0/0,M10.5.0/1",
+};
+
+static bool sameTm(const struct tm &a, const struct tm &b) {
+  return a.tm_year == b.tm_year && a.tm_mon == b.tm_mon &&
+         a.tm_mday == b.tm_mday && a.tm_hour == b.tm_hour &&
+         a.tm_min == b.tm_min && a.tm_sec == b.tm_sec &&
+         a.tm_wday == b.tm_wday && a.tm_yday == b.tm_yday &&
+         (a.tm_isdst > 0) == (b.tm_isdst > 0);
+}
+
+// glibc reads the same POSIX rules and is the reference. Every sampled
+// time has to match and every change of the offset between two samples
+// has to be a transition, at the second glibc sees it.
+static int compareRule(const char *name, const char *rule) {
+  TimeZone &tz = TimeZone::getInstance();
+  CHECK(tz.setRule(rule));
+  setenv("TZ", rule, 1);
+  tzset();
+
+  int mismatches = 0;
+  struct tm ref, local;
+  time_t previous = TZ_TEST_FROM;
+  localtime_r(&previous, &ref);
+  long previous_offset = ref.tm_gmtoff;
+  for (time_t t = TZ_TEST_FROM; t < TZ_TEST_TO && mismatches == 0;
+       t += TZ_TEST_STEP) {
+    localtime_r(&t, &ref);
+    tz.localTime(t, local);
+    if (tz.getOffset(t) != ref.tm_gmtoff ||
+        tz.isDst(t) != (ref.tm_isdst > 0) || !sameTm(local, ref)) {
+      printf("  %s %s: %lld is %ld, not %ld\n", name, rule, (long long)t,
+             ref.tm_gmtoff, (long)tz.getOffset(t));
+      mismatches++;
+    }
+    if (ref.tm_gmtoff != previous_offset &&
+        tz.getNextTransition(previous) > t) {
+      printf("  %s %s: no transition in %lld..%lld\n", name, rule,
+             (long long)previous, (long long)t);
+      mismatches++;
+    }
+    previous = t;
+    previous_offset = ref.tm_gmtoff;
+  }
+
+  struct tm before;
+  int64_t at = tz.getNextTransition(TZ_TEST_FROM);
+  for (; at < TZ_TEST_TO && mismatches == 0; at = tz.getNextTransition(at)) {
+    time_t t = at;
+    time_t last = t - 1;
+    localtime_r(&t, &ref);
+    localtime_r(&last, &before);
+    if (before.tm_gmtoff == ref.tm_gmtoff && before.tm_isdst == ref.tm_isdst) {
+      printf("  %s %s: nothing changes at %lld\n", name, rule,
+             (long long)at);
+      mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+HOST_TEST(timeZoneMatchesLibc) {
+  int zones = 0;
+  int mismatches = 0;
+  zones_ForEach("", [&](const zone_entry_t &entry) {
+    mismatches += compareRule(entry.name, entry.rule) > 0;
+    zones++;
+    return true;
+  });
+  for (const char *rule : extra_rules) {
+    mismatches += compareRule("extra", rule) > 0;
+  }
+  printf("  %d zones and %zu rules\n", zones,
+         sizeof(extra_rules) / sizeof(extra_rules[0]));
+  CHECK(mismatches == 0);
+  unsetenv("TZ");
+  tzset();
+}
+
+HOST_TEST(timeZoneInvalidRules) {
+  static const char *const invalid[] = {
+      "",         "CET",          "<+03-3",        "CET-1CEST,M3.5.0",
+      "AB-1",     "CET-26",       "CET-1CEST,J0",  "CET-1CEST,M13.1.0,M1.1.0",
+      "CET-1CEST,M3.6.0,M10.5.0", "CET-1CEST,366,1",
+  };
+  tz_rule_t parsed;
+  for (const char *rule : invalid) {
+    bool ok = TimeZone::parseRule(rule, parsed);
+    CHECK(!ok);
+    if (ok) {
+      printf("  accepted: %s\n", rule);
+    }
+  }
+  TimeZone &tz = TimeZone::getInstance();
+  CHECK(!tz.setRule("nonsense"));
+  CHECK(tz.getOffset(TZ_TEST_FROM) == 0);
+  CHECK(tz.getNextTransition(TZ_TEST_FROM) == TZ_NO_TRANSITION);
+}
+
+// The manual offset counts minutes west of UTC like POSIX does
+HOST_TEST(timeZoneManualRule) {
+  static const struct {
+    int32_t minutes_west;
+    const char *rule;
+    int32_t offset; // s east of UTC
+  } rules[] = {
+      {MIN_TIMEZONE_OFFSET, "UTC-14:00:00", 14 * 3600},
+      {-60, "UTC-1:00:00", 3600},
+      {0, "UTC+0:00:00", 0},
+      {210, "UTC+3:30:00", -3 * 3600 - 1800},
+      {MAX_TIMEZONE_OFFSET, "UTC+12:00:00", -12 * 3600},
+  };
+  char rule[32];
+  tz_rule_t parsed;
+  for (const auto &expected : rules) {
+    TimeZone::manualRule(expected.minutes_west, rule, sizeof(rule));
+    CHECK(strcmp(rule, expected.rule) == 0);
+    CHECK(TimeZone::parseRule(rule, parsed) && !parsed.has_dst);
+    CHECK(parsed.std_offset == expected.offset);
+  }
+}
@@ -0,0 +1,206 @@
+#include "ClockWebServer.h"
+#include "FirmwareUpdate.h"
+#include "HollowClock.h"
+#include "HostShim.h"
+#include "HostTests.h"
+#include "config.h"
+#include <WiFi.h>
+#include <esp_ota_ops.h>
+#include <mbedtls/sha256.h>
+
+// Runs the request through the handlers of the clock's web server
+static void serve(const host_request_t &request, host_response_t &response) {
+  ClockWebServer::getInstance().start();
+  host_Request(*host_GetWebServer(), request, response);
+}
+
+static void serve(HTTPMethod method, const char *uri, const char *query,
+                  host_response_t &response, const char *body = "") {
+  host_request_t request;
+  request.method = method;
+  request.uri = uri;
+  request.query = query;
+  request.body = body;
+  request.local_ip = WiFi.localIP();
+  serve(request, response);
+}
+
+static bool redirects(const host_response_t &response, const char *to) {
+  return response.code == 302 &&
+         response.headers.startsWith(String("Location: ") + to + "\r\n");
+}
+
+static String hex(const uint8_t *data, size_t len) {
+  String text;
+  for (size_t i = 0; i < len; i++) {
+    char digits[3];
+    snprintf(digits, sizeof(digits), "%02x", data[i]);
+    text += digits;
+  }
+  return text;
+}
+
+static String sha256(const String &data) {
+  mbedtls_sha256_context sha;
+  uint8_t hash[32];
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts(&sha, 0);
+  mbedtls_sha256_update(&sha, (const uint8_t *)data.data(), data.length());
+  mbedtls_sha256_finish(&sha, hash);
+  mbedtls_sha256_free(&sha);
+  return hex(hash, sizeof(hash));
+}
+
+HOST_TEST(webSha256) {
+  CHECK(sha256("abc") == "ba7816bf8f01cfea414140de5dae2223"
+                         "b00361a396177a9cb410ff61f20015ad");
+  CHECK(sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  // The padding takes a second block
+  CHECK(sha256(std::string(56, 'a')) == "b35439a4ac6f0948b6d6f9e3c6af0f5f"
+                                        "590ce20f1bde7090ef7970686ec6738a");
+  CHECK(sha256(std::string(1000, 'a')) == "41edece42d63e8d9bf515a9ba6932e1c"
+                                          "20cbc9f5a5d134645adb5db1b9737ea3");
+}
+
+HOST_TEST(webManualTimezone) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  pref_settings_t settings;
+  const char *error;
+  host_response_t response;
+  pm.getSettings(settings);
+
+  // Minutes west of UTC, from UTC+14 to UTC-12
+  serve(HTTP_POST, "/time",
+        "ntp_server=pool.ntp.org&tz_manual_en=on&tz_manual=780", response);
+  CHECK(redirects(response, "/error.html"));
+  serve(HTTP_POST, "/time",
+        "ntp_server=pool.ntp.org&tz_manual_en=on&tz_manual=-841", response);
+  CHECK(redirects(response, "/error.html"));
+  CHECK(pm.getManualTimezone() == settings.timezone_manual);
+
+  serve(HTTP_POST, "/time",
+        "ntp_server=pool.ntp.org&tz_manual_en=on&"
+        "tz_manual=-840&ntp_timeout=3600",
+        response);
+  CHECK(redirects(response, "/"));
+  CHECK(pm.getManualTimezone() && pm.getManualTimezoneValue() == -840);
+  CHECK(pm.setManualTimezoneValue(MIN_TIMEZONE_OFFSET - 1) == PREF_ERROR);
+  CHECK(pm.setManualTimezoneValue(MAX_TIMEZONE_OFFSET + 1) == PREF_ERROR);
+
+  serve(HTTP_PATCH, "/api/config", "", response, "{\"tz_manual\": 720}");
+  CHECK(response.code == 200 && pm.getManualTimezoneValue() == 720);
+  serve(HTTP_PATCH, "/api/config", "", response, "{\"tz_manual\": 780}");
+  CHECK(response.code == 400 && pm.getManualTimezoneValue() == 720);
+  CHECK(response.body.indexOf("Invalid Manual Timezone Value") >= 0);
+  CHECK(pm.applySettings(settings, error) == PREF_OK);
+}
+
+HOST_TEST(webNumberArgs) {
+  PreferencesManager &pm = PreferencesManager::getInstance();
+  uint8_t delay_time = pm.getDelayTime();
+  host_response_t response;
+  static const char *const invalid[] = {"", " 3", "3x", "0x3", "258",
+                                        "99999999999"};
+
+  for (const char *value : invalid) {
+    String query = String("host_name=clock&host_ip=192.168.100.1&"
+                          "steps_per_minute=256&delay_time=") +
+                   value;
+    serve(HTTP_POST, "/advanced", query.c_str(), response);
+    CHECK(redirects(response, "/error.html"));
+  }
+  CHECK(pm.getDelayTime() == delay_time);
+
+  serve(HTTP_POST, "/calibration", "move=move&steps=-99999999", response);
+  CHECK(redirects(response, "/error.html"));
+  serve(HTTP_POST, "/calibration", "set=set&hour_hand=13&minute_hand=0",
+        response);
+  CHECK(redirects(response, "/error.html"));
+  serve(HTTP_POST, "/calibration", "steps=5", response);
+  CHECK(redirects(response, "/error.html"));
+}
+
+HOST_TEST(webFirmwareUpdate) {
+  uint32_t restarts = host_GetRestarts();
+  host_request_t request;
+  host_response_t response;
+  String image(std::string(3000, 'x'));
+  image[0] = (char)0xE9;
+
+  request.method = HTTP_POST;
+  request.uri = "/update";
+  request.upload = image;
+  request.query = "sha256=" + sha256(image + "!");
+  serve(request, response);
+  CHECK(redirects(response, "/error.html"));
+
+  request.query = "sha256=" + sha256(image);
+  serve(request, response);
+  CHECK(redirects(response, "/"));
+  CHECK(host_GetRestarts() == restarts + 1);
+
+  // Not without a hash
+  request.query = "";
+  serve(request, response);
+  CHECK(redirects(response, "/error.html"));
+  CHECK(FirmwareUpdate::getInstance().getState() == OTA_FAILED);
+  CHECK(strcmp(FirmwareUpdate::getInstance().getError(), "SHA-256 missing") ==
+        0);
+
+  // Not an ESP32 image
+  request.upload[0] = 'x';
+  request.query = "sha256=" + sha256(request.upload);
+  serve(request, response);
+  CHECK(redirects(response, "/error.html"));
+  CHECK(host_GetRestarts() == restarts + 1);
+}
+
+// Pending verification with a clock thread that never runs
+HOST_TEST(webFirmwareRollback) {
+  FirmwareUpdate &update = FirmwareUpdate::getInstance();
+  uint32_t restarts = host_GetRestarts();
+  esp_ota_img_states_t state;
+
+  host_SetOtaState(ESP_OTA_IMG_PENDING_VERIFY);
+  CHECK(update.isPendingVerify());
+  CHECK(!HollowClock::getInstance().isAlive());
+  if (millis() + 1000 < OTA_ROLLBACK_UPTIME) {
+    delay(OTA_ROLLBACK_UPTIME - millis() - 1000);
+    update.process();
+    CHECK(host_GetRestarts() == restarts && update.isPendingVerify());
+    delay(1000);
+  }
+  update.process();
+  CHECK(host_GetRestarts() == restarts + 1 && !update.isPendingVerify());
+  CHECK(esp_ota_get_state_partition(esp_ota_get_running_partition(),
+                                    &state) == ESP_OK &&
+        state == ESP_OTA_IMG_INVALID);
+  host_SetOtaState(ESP_OTA_IMG_VALID);
+}
+
+HOST_TEST(webCaptivePortal) {
+  host_request_t request;
+  host_response_t response;
+
+  request.method = HTTP_GET;
+  request.uri = "/generate_204";
+  request.local_ip = WiFi.localIP();
+  serve(request, response);
+  CHECK(response.code == 404);
+
+  WiFi.mode(WIFI_AP);
+  WiFi.softAPConfig(IPAddress(192, 168, 100, 1), IPAddress(192, 168, 100, 1),
+                    IPAddress(255, 255, 255, 0));
+  // Only clients of the access point are sent to the setup page
+  serve(request, response);
+  CHECK(response.code == 404);
+  request.local_ip = WiFi.softAPIP();
+  request.headers = "Host: connectivitycheck.gstatic.com\r\n";
+  serve(request, response);
+  CHECK(redirects(response, "http://192.168.100.1/"));
+  request.headers = "Host: 192.168.100.1\r\n";
+  serve(request, response);
+  CHECK(response.code == 404);
+  WiFi.mode(WIFI_STA);
+}
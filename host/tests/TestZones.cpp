@@ -0,0 +1,37 @@
+#include "HostTests.h"
+#include "TimeZone.h"
+#include "Zones.h"
+#include <set>
+
+HOST_TEST(zonesLookup) {
+  std::set<zone_id_t> ids;
+  size_t count = zones_ForEach("", [&ids](const zone_entry_t &entry) {
+    zone_entry_t found;
+    tz_rule_t rule;
+    CHECK(zones_FindByName(entry.name, found) && found.id == entry.id);
+    CHECK(zones_FindById(entry.id, found) && !strcmp(found.name, entry.name));
+    CHECK(entry.id != ZONE_INVALID_ID && ids.insert(entry.id).second);
+    CHECK(TimeZone::parseRule(entry.rule, rule));
+    return true;
+  });
+  CHECK(count > 300 && count == ids.size());
+
+  zone_entry_t entry;
+  CHECK(!zones_FindByName("Europe/Nowhere", entry));
+  CHECK(!zones_FindById(ZONE_INVALID_ID, entry));
+}
+
+HOST_TEST(zonesPrefix) {
+  size_t stopped = 0;
+  size_t europe = zones_ForEach("Europe/", [](const zone_entry_t &entry) {
+    CHECK(!strncmp(entry.name, "Europe/", 7));
+    return true;
+  });
+  zones_ForEach("Europe/", [&stopped](const zone_entry_t &) {
+    return ++stopped < 3;
+  });
+  CHECK(europe > 30);
+  CHECK(stopped == 3);
+  CHECK(zones_ForEach("Nowhere/", [](const zone_entry_t &) { return true; }) ==
+        0);
+}
@@ -6,3 +6,5 @@ if [ -z $VESRION ]; then
     VERSION="local"
 fi
 arduino-cli compile --fqbn esp32:esp32:esp32c6 --build-property "build.extra_flags=\"-DSTRING_VERSION=\"$VERSION\"\" -DSTRING_DATE=\"$DATE\"" --output-dir ./build/ HollowClock5Plus.ino -v
+# The firmware upload asks for the hash
+sha256sum ./build/HollowClock5Plus.ino.bin
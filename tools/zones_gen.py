@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Generates ZonesData.h from data/zones.json.
+
+The generated header holds:
+  * a sorted, deduplicated zone name table searchable by binary search,
+  * interned POSIX rule strings (many zones share the same rule),
+  * a stable 32 bit zone ID per zone (FNV-1a hash of the name) sorted for
+    binary search, so IDs stored in NVS survive regeneration of the list,
+  * the whole list as a gzip compressed JSON blob served by /zones.
+
+Run this script after editing data/zones.json:
+
+    python3 tools/zones_gen.py
+"""
+import gzip
+import hashlib
+import json
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "data", "zones.json")
+OUTPUT = os.path.join(ROOT, "ZonesData.h")
+
+# Loose POSIX TZ check: std offset [dst [offset] [,start[/time],end[/time]]]
+NAME = r"(?:[A-Za-z]{3,}|<[+-]?[A-Za-z0-9]+>)"
+OFFSET = r"[+-]?\d{1,2}(?::\d{2}){0,2}"
+DATE = r"(?:M\d{1,2}\.\d\.\d|J\d{1,3}|\d{1,3})(?:/[+-]?\d{1,3}(?::\d{2}){0,2})?"
+RULE_RE = re.compile(r"^%s%s(?:%s(?:%s)?(?:,%s,%s)?)?$" %
+                     (NAME, OFFSET, NAME, OFFSET, DATE, DATE))
+
+
+def fnv1a32(text):
+    h = 0x811c9dc5
+    for b in text.encode("utf-8"):
+        h ^= b
+        h = (h * 0x01000193) & 0xffffffff
+    return h
+
+
+def c_bytes(data, indent="    ", per_line=16):
+    lines = []
+    for i in range(0, len(data), per_line):
+        chunk = data[i:i + per_line]
+        lines.append(indent + ", ".join("0x%02x" % b for b in chunk) + ",")
+    return "\n".join(lines)
+
+
+def c_numbers(values, indent="    ", per_line=10):
+    lines = []
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append(indent + ", ".join(str(v) for v in chunk) + ",")
+    return "\n".join(lines)
+
+
+def c_strings(values, indent="    "):
+    return "\n".join('%s"%s\\0"' % (indent, v) for v in values)
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        zones = json.load(f)
+
+    names = sorted(zones)
+    for name in names:
+        if not RULE_RE.match(zones[name]):
+            sys.exit("Invalid POSIX rule for %s: %s" % (name, zones[name]))
+        if '"' in name or '\\' in name:
+            sys.exit("Invalid zone name: %s" % name)
+
+    rules = sorted(set(zones.values()))
+    if len(rules) > 255:
+        sys.exit("Too many distinct rules: %d" % len(rules))
+    rule_index = {rule: i for i, rule in enumerate(rules)}
+
+    ids = {name: fnv1a32(name) for name in names}
+    if len(set(ids.values())) != len(ids) or 0 in ids.values():
+        sys.exit("Zone ID collision - change the hash seed")
+
+    name_offsets, offset = [], 0
+    for name in names:
+        name_offsets.append(offset)
+        offset += len(name) + 1
+    names_size = offset
+    rule_offsets, offset = [], 0
+    for rule in rules:
+        rule_offsets.append(offset)
+        offset += len(rule) + 1
+    rules_size = offset
+    if max(names_size, rules_size) > 0xffff:
+        sys.exit("String pool too large for 16 bit offsets")
+
+    by_id = sorted((ids[name], i) for i, name in enumerate(names))
+
+    compact = json.dumps({n: zones[n] for n in names}, separators=(",", ":"))
+    raw = compact.encode("utf-8")
+    packed = gzip.compress(raw, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(raw).hexdigest()[:16]
+
+    out = []
+    out.append("// Generated by tools/zones_gen.py from data/zones.json - do not edit")
+    out.append("#ifndef ZONES_DATA_H")
+    out.append("#define ZONES_DATA_H")
+    out.append("")
+    out.append("#include <Arduino.h>")
+    out.append("")
+    out.append("#define ZONES_COUNT %d" % len(names))
+    out.append("#define ZONES_RULES_COUNT %d" % len(rules))
+    out.append("#define ZONES_ETAG \"%s\"" % etag)
+    out.append("#define ZONES_JSON_SIZE %d" % len(raw))
+    out.append("")
+    out.append("// Zone names sorted in strcmp() order")
+    out.append("static const char zones_names[] PROGMEM =")
+    out.append(c_strings(names) + ";")
+    out.append("")
+    out.append("static const uint16_t zones_name_offsets[ZONES_COUNT] PROGMEM = {")
+    out.append(c_numbers(name_offsets))
+    out.append("};")
+    out.append("")
+    out.append("static const char zones_rules[] PROGMEM =")
+    out.append(c_strings(rules) + ";")
+    out.append("")
+    out.append("static const uint16_t zones_rule_offsets[ZONES_RULES_COUNT] PROGMEM = {")
+    out.append(c_numbers(rule_offsets))
+    out.append("};")
+    out.append("")
+    out.append("// Index into zones_rule_offsets for every zone")
+    out.append("static const uint8_t zones_rule_index[ZONES_COUNT] PROGMEM = {")
+    out.append(c_numbers([rule_index[zones[n]] for n in names], per_line=16))
+    out.append("};")
+    out.append("")
+    out.append("// Stable zone IDs (FNV-1a of the name) for every zone")
+    out.append("static const uint32_t zones_ids[ZONES_COUNT] PROGMEM = {")
+    out.append(c_numbers(["0x%08xu" % ids[n] for n in names], per_line=6))
+    out.append("};")
+    out.append("")
+    out.append("// Zone indexes sorted by zone ID")
+    out.append("static const uint16_t zones_by_id[ZONES_COUNT] PROGMEM = {")
+    out.append(c_numbers([i for _, i in by_id]))
+    out.append("};")
+    out.append("")
+    out.append("static const uint8_t zones_json_gz[] PROGMEM = {")
+    out.append(c_bytes(packed))
+    out.append("};")
+    out.append("")
+    out.append("#endif // ZONES_DATA_H")
+
+    with open(OUTPUT, "w", encoding="utf-8") as f:
+        f.write("\n".join(out) + "\n")
+    print("%s: %d zones, %d rules, %d bytes of tables, %d bytes gzip" %
+          (os.path.relpath(OUTPUT, ROOT), len(names), len(rules),
+           names_size + rules_size + len(names) * 9, len(packed)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())